@@ -0,0 +1,176 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+namespace graphs::bench {
+
+/**
+ * A synthetic topology in terms of a vertex count and an edge list over the vertices 0, ..., nVertices-1. Building the
+ * graph is left to the benchmarks so that vertex and edge insertion can be timed separately.
+ */
+struct Topology {
+    std::string name;
+    std::size_t nVertices;
+    std::vector<std::tuple<std::size_t, std::size_t>> edges;
+};
+
+/**
+ * Linear chain 0 - 1 - ... - (n-1).
+ * @param n number of vertices
+ * @return the topology
+ */
+inline Topology linearChain(std::size_t n) {
+    Topology topology {"chain", n, {}};
+    topology.edges.reserve(n);
+    for (std::size_t i = 1; i < n; ++i) {
+        topology.edges.emplace_back(i - 1, i);
+    }
+    return topology;
+}
+
+/**
+ * Linear chain which is closed into a ring.
+ * @param n number of vertices
+ * @return the topology
+ */
+inline Topology ring(std::size_t n) {
+    auto topology = linearChain(n);
+    topology.name = "ring";
+    if (n > 2) {
+        topology.edges.emplace_back(n - 1, 0);
+    }
+    return topology;
+}
+
+/**
+ * Dendrimer grown shell by shell from a core vertex with `branching` arms, every further vertex branches into
+ * `branching - 1` new vertices. The outermost shell is filled up to n vertices.
+ * @param n number of vertices
+ * @param branching functionality of the vertices
+ * @return the topology
+ */
+inline Topology dendrimer(std::size_t n, std::size_t branching = 3) {
+    Topology topology {"dendrimer", n, {}};
+    topology.edges.reserve(n);
+    std::size_t next = 1;
+    for (std::size_t parent = 0; next < n; ++parent) {
+        auto nChildren = parent == 0 ? branching : branching - 1;
+        for (std::size_t i = 0; i < nChildren && next < n; ++i) {
+            topology.edges.emplace_back(parent, next++);
+        }
+    }
+    return topology;
+}
+
+/**
+ * Square lattice with open boundaries, the side length is chosen such that the number of vertices is close to n.
+ * @param n approximate number of vertices
+ * @return the topology
+ */
+inline Topology lattice2d(std::size_t n) {
+    auto side = std::max<std::size_t>(1, static_cast<std::size_t>(std::lround(std::sqrt(static_cast<double>(n)))));
+    Topology topology {"lattice2d", side * side, {}};
+    topology.edges.reserve(2 * side * side);
+    auto index = [side](std::size_t x, std::size_t y) { return x + side * y; };
+    for (std::size_t y = 0; y < side; ++y) {
+        for (std::size_t x = 0; x < side; ++x) {
+            if (x + 1 < side) topology.edges.emplace_back(index(x, y), index(x + 1, y));
+            if (y + 1 < side) topology.edges.emplace_back(index(x, y), index(x, y + 1));
+        }
+    }
+    return topology;
+}
+
+/**
+ * Cubic lattice with open boundaries, the side length is chosen such that the number of vertices is close to n.
+ * @param n approximate number of vertices
+ * @return the topology
+ */
+inline Topology lattice3d(std::size_t n) {
+    auto side = std::max<std::size_t>(1, static_cast<std::size_t>(std::lround(std::cbrt(static_cast<double>(n)))));
+    Topology topology {"lattice3d", side * side * side, {}};
+    topology.edges.reserve(3 * side * side * side);
+    auto index = [side](std::size_t x, std::size_t y, std::size_t z) { return x + side * (y + side * z); };
+    for (std::size_t z = 0; z < side; ++z) {
+        for (std::size_t y = 0; y < side; ++y) {
+            for (std::size_t x = 0; x < side; ++x) {
+                if (x + 1 < side) topology.edges.emplace_back(index(x, y, z), index(x + 1, y, z));
+                if (y + 1 < side) topology.edges.emplace_back(index(x, y, z), index(x, y + 1, z));
+                if (z + 1 < side) topology.edges.emplace_back(index(x, y, z), index(x, y, z + 1));
+            }
+        }
+    }
+    return topology;
+}
+
+/**
+ * Erdős–Rényi graph G(n, m) with m = n * meanDegree / 2 distinct edges and no self-loops.
+ * @param n number of vertices
+ * @param seed seed of the random number generator
+ * @param meanDegree mean vertex degree
+ * @return the topology
+ */
+inline Topology erdosRenyi(std::size_t n, std::uint64_t seed, double meanDegree = 4.) {
+    Topology topology {"erdos_renyi", n, {}};
+    if (n < 2) {
+        return topology;
+    }
+    auto m = std::min(static_cast<std::size_t>(static_cast<double>(n) * meanDegree / 2.), n * (n - 1) / 2);
+    topology.edges.reserve(m);
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<std::size_t> distribution(0, n - 1);
+    std::unordered_set<std::size_t> seen;
+    seen.reserve(m);
+    while (topology.edges.size() < m) {
+        auto v1 = distribution(generator);
+        auto v2 = distribution(generator);
+        if (v1 == v2) {
+            continue;
+        }
+        if (v1 > v2) {
+            std::swap(v1, v2);
+        }
+        if (seen.insert(v1 * n + v2).second) {
+            topology.edges.emplace_back(v1, v2);
+        }
+    }
+    return topology;
+}
+
+/**
+ * @return the names of all available topologies
+ */
+inline std::vector<std::string> topologyNames() {
+    return {"chain", "ring", "dendrimer", "lattice2d", "lattice3d", "erdos_renyi"};
+}
+
+/**
+ * Generates a topology by name.
+ * @param name the topology name, see topologyNames()
+ * @param n (approximate) number of vertices
+ * @param seed seed for randomized topologies
+ * @return the topology
+ */
+inline Topology generate(const std::string &name, std::size_t n, std::uint64_t seed) {
+    if (name == "chain") return linearChain(n);
+    if (name == "ring") return ring(n);
+    if (name == "dendrimer") return dendrimer(n);
+    if (name == "lattice2d") return lattice2d(n);
+    if (name == "lattice3d") return lattice3d(n);
+    if (name == "erdos_renyi") return erdosRenyi(n, seed);
+    throw std::invalid_argument("Unknown topology " + name);
+}
+
+}
@@ -0,0 +1,779 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <graphs/graphs.h>
+#include <graphs/ConcurrentGraphBuilder.h>
+#include <graphs/Import.h>
+
+#include "generators.h"
+
+namespace {
+
+using Graph = graphs::DefaultGraph;
+using Clock = std::chrono::steady_clock;
+using graphs::bench::Topology;
+
+struct Options {
+    std::size_t minVertices {10};
+    std::size_t maxVertices {100000};
+    std::size_t repetitions {3};
+    // budget for operations whose cost is linear in the graph size (e.g., containsEdge, removeEdge)
+    std::size_t maxOperations {1000};
+    std::uint64_t seed {42};
+    std::string filter {};
+    std::string output {"-"};
+};
+
+struct Result {
+    std::string benchmark;
+    std::string topology;
+    std::size_t nVertices;
+    std::size_t nEdges;
+    std::size_t nOperations;
+    std::vector<double> seconds;
+    std::map<std::string, double> counters {};
+};
+
+// keeps results of timed code alive
+volatile std::size_t sink;
+
+/**
+ * Stream buffer which counts and discards everything written to it.
+ */
+class NullBuffer : public std::streambuf {
+public:
+    std::size_t nBytes {0};
+
+protected:
+    std::streamsize xsputn(const char *, std::streamsize n) override {
+        nBytes += static_cast<std::size_t>(n);
+        return n;
+    }
+
+    int overflow(int c) override {
+        ++nBytes;
+        return c;
+    }
+};
+
+template<typename Setup, typename Run>
+std::vector<double> measure(std::size_t repetitions, const Setup &setup, const Run &run) {
+    std::vector<double> seconds;
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        auto state = setup();
+        auto t0 = Clock::now();
+        run(state);
+        auto t1 = Clock::now();
+        seconds.push_back(std::chrono::duration<double>(t1 - t0).count());
+    }
+    return seconds;
+}
+
+template<typename G = Graph, typename... Args>
+G verticesOnly(const Topology &topology, Args &&... args) {
+    G graph(std::forward<Args>(args)...);
+    for (std::size_t i = 0; i < topology.nVertices; ++i) {
+        graph.addVertex(i);
+    }
+    return graph;
+}
+
+template<typename G = Graph, typename... Args>
+G build(const Topology &topology, Args &&... args) {
+    auto graph = verticesOnly<G>(topology, std::forward<Args>(args)...);
+    using Index = typename G::PersistentVertexIndex;
+    for (const auto &[v1, v2] : topology.edges) {
+        graph.addEdge(Index::of(v1), Index::of(v2));
+    }
+    return graph;
+}
+
+std::vector<graphs::PersistentIndex> activeIndices(const Graph &graph) {
+    std::vector<graphs::PersistentIndex> indices;
+    for (auto it = graph.begin(); it != graph.end(); ++it) {
+        indices.push_back(it.persistent_index());
+    }
+    return indices;
+}
+
+template<typename T>
+std::vector<T> sample(const std::vector<T> &population, std::size_t n, std::mt19937_64 &generator) {
+    std::vector<T> result;
+    std::sample(population.begin(), population.end(), std::back_inserter(result), n, generator);
+    std::shuffle(result.begin(), result.end(), generator);
+    return result;
+}
+
+/**
+ * Number of operations for benchmarks whose operations are linear in the graph size, such that every benchmark
+ * visits in the order of maxOperations * 1000 elements.
+ */
+std::size_t linearOperations(const Options &options, std::size_t n) {
+    return std::clamp<std::size_t>(options.maxOperations * 1000 / std::max<std::size_t>(n, 1), 1,
+                                   options.maxOperations);
+}
+
+void runTopology(const Options &options, const Topology &topology, std::vector<Result> &results) {
+    auto selected = [&options](const std::string &benchmark) {
+        return options.filter.empty() || benchmark.find(options.filter) != std::string::npos;
+    };
+    auto record = [&](std::string benchmark, std::size_t nOperations, std::vector<double> seconds,
+                      std::map<std::string, double> counters = {}) {
+        results.push_back({std::move(benchmark), topology.name, topology.nVertices, topology.edges.size(),
+                           nOperations, std::move(seconds), std::move(counters)});
+        const auto &result = results.back();
+        std::cerr << fmt::format("{:>20} {:>12} n={:<9} {:>12.6f}s\n", result.benchmark, result.topology,
+                                 result.nVertices, *std::min_element(result.seconds.begin(), result.seconds.end()));
+    };
+    auto reps = options.repetitions;
+    auto n = topology.nVertices;
+    auto m = topology.edges.size();
+    auto k = linearOperations(options, n);
+    std::mt19937_64 generator(options.seed);
+
+    const auto graph = build(topology);
+    const auto vertices = activeIndices(graph);
+    const auto edges = std::vector<Graph::Edge>(graph.edges().begin(), graph.edges().end());
+
+    if (selected("addVertex")) {
+        record("addVertex", n, measure(reps, [] { return Graph{}; }, [&](Graph &g) {
+            for (std::size_t i = 0; i < n; ++i) {
+                g.addVertex(i);
+            }
+        }));
+    }
+    if (selected("addEdge")) {
+        record("addEdge", m, measure(reps, [&] { return verticesOnly(topology); }, [&](Graph &g) {
+            for (const auto &[v1, v2] : topology.edges) {
+                g.addEdge(graphs::PersistentIndex{v1}, graphs::PersistentIndex{v2});
+            }
+        }));
+    }
+    if (selected("containsEdge")) {
+        // half of the queries hit an existing edge, the other half a random pair
+        auto queries = sample(edges, k / 2, generator);
+        std::uniform_int_distribution<std::size_t> distribution(0, vertices.size() - 1);
+        while (queries.size() < k) {
+            queries.emplace_back(vertices[distribution(generator)], vertices[distribution(generator)]);
+        }
+        record("containsEdge", queries.size(), measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nFound = 0;
+            for (const auto &edge : queries) {
+                nFound += graph.containsEdge(edge);
+            }
+            sink = nFound;
+        }));
+    }
+    if (selected("removeEdge") && m > 0) {
+        auto removed = sample(edges, k, generator);
+        record("removeEdge", removed.size(), measure(reps, [&] { return graph; }, [&](Graph &g) {
+            for (const auto &edge : removed) {
+                g.removeEdge(edge);
+            }
+        }));
+    }
+    if (selected("removeVertex")) {
+        auto removed = sample(vertices, k, generator);
+        record("removeVertex", removed.size(), measure(reps, [&] { return graph; }, [&](Graph &g) {
+            for (auto ix : removed) {
+                g.removeVertex(ix);
+            }
+        }));
+    }
+    if (selected("findNTuples")) {
+        std::size_t nTuples[3] {};
+        auto seconds = measure(reps, [] { return 0; }, [&](int &) {
+            nTuples[0] = nTuples[1] = nTuples[2] = 0;
+            graph.findNTuples([&](const auto &) { ++nTuples[0]; }, [&](const auto &) { ++nTuples[1]; },
+                              [&](const auto &) { ++nTuples[2]; });
+        });
+        // the counters are read after the measurement
+        record("findNTuples", 1, std::move(seconds),
+               {{"pairs", nTuples[0]}, {"triples", nTuples[1]}, {"quadruples", nTuples[2]}});
+    }
+    if (selected("graphDistance")) {
+        auto sources = sample(vertices, k, generator);
+        auto targets = sample(vertices, k, generator);
+        record("graphDistance", sources.size(), measure(reps, [] { return 0; }, [&](int &) {
+            std::int64_t total = 0;
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                total += graph.graphDistance(sources[i], targets[i]);
+            }
+            sink = static_cast<std::size_t>(total);
+        }));
+    }
+    if (selected("isConnected")) {
+        record("isConnected", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graph.isConnected();
+        }));
+    }
+    if (selected("connectedComponents")) {
+        record("connectedComponents", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graph.connectedComponents().size();
+        }));
+    }
+    if (selected("append")) {
+        record("append", 1, measure(reps, [&] { return graph; }, [&](Graph &g) {
+            sink = g.append(graph).size();
+        }));
+        // with a blank the mapping is no shift and append goes through addVertex and addEdge
+        record("appendElementwise", 1, measure(reps, [&] {
+            auto g = graph;
+            g.removeVertex(g.addVertex(0));
+            return g;
+        }, [&](Graph &g) {
+            sink = g.append(graph).size();
+        }));
+    }
+    if (selected("copy")) {
+        record("copy", 1, measure(reps, [] { return 0; }, [&](int &) {
+            Graph copy(graph);
+            sink = copy.nEdges();
+        }));
+    }
+    if (selected("gexf")) {
+        std::size_t nBytes = 0;
+        auto seconds = measure(reps, [] { return 0; }, [&](int &) {
+            nBytes = graph.gexf().size();
+        });
+        record("gexf", 1, std::move(seconds), {{"bytes", nBytes}});
+    }
+    if (selected("export")) {
+        for (auto [name, format] : {std::make_pair("exportGexf", graphs::ExportFormat::gexf),
+                                    std::make_pair("exportGraphml", graphs::ExportFormat::graphml),
+                                    std::make_pair("exportDot", graphs::ExportFormat::dot)}) {
+            std::size_t nBytes = 0;
+            auto seconds = measure(reps, [] { return NullBuffer{}; }, [&](NullBuffer &buffer) {
+                std::ostream os(&buffer);
+                graphs::exportGraph(graph, os, format, {true});
+                nBytes = buffer.nBytes;
+            });
+            record(name, 1, std::move(seconds), {{"bytes", nBytes}});
+        }
+    }
+    if (selected("serialization")) {
+        std::stringstream buffer(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        graph.write(buffer);
+        auto bytes = buffer.str();
+        record("serializationWrite", 1, measure(reps, [] {
+            return std::ostringstream(std::ios_base::out | std::ios_base::binary);
+        }, [&](std::ostringstream &os) {
+            graph.write(os);
+            sink = static_cast<std::size_t>(os.tellp());
+        }), {{"bytes", bytes.size()}});
+        record("serializationRead", 1, measure(reps, [&] {
+            return std::istringstream(bytes, std::ios_base::in | std::ios_base::binary);
+        }, [&](std::istringstream &is) {
+            sink = Graph::read(is).nEdges();
+        }), {{"bytes", bytes.size()}});
+        // delta after changing the data of k vertices, compare with the bytes of a full write
+        auto changed = sample(vertices, k, generator);
+        std::size_t deltaBytes = 0;
+        auto seconds = measure(reps, [&] {
+            auto g = graph;
+            g.mark();
+            for (auto ix : changed) {
+                g.setData(ix, {ix.value});
+            }
+            return std::make_pair(std::move(g), std::ostringstream(std::ios_base::out | std::ios_base::binary));
+        }, [&](auto &state) {
+            state.first.writeDelta(state.second);
+            deltaBytes = static_cast<std::size_t>(state.second.tellp());
+        });
+        record("serializationDelta", changed.size(), std::move(seconds),
+               {{"bytes", deltaBytes}, {"fullBytes", bytes.size()}});
+    }
+    if (selected("import")) {
+        std::string text;
+        for (const auto &[ix1, ix2] : graph.edges()) {
+            text += fmt::format("{} {}\n", ix1.value, ix2.value);
+        }
+        record("importEdgeList", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graphs::io::parseEdgeList<Graph>(text).nEdges();
+        }), {{"bytes", text.size()}});
+        graphs::ThreadPool pool;
+        record("importEdgeListParallel", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graphs::io::parseEdgeList<Graph>(pool, text).nEdges();
+        }), {{"bytes", text.size()}, {"threads", pool.nThreads()}});
+    }
+    if (selected("concurrentBuild")) {
+        // recording the edges from T threads and finalizing on a pool of T threads, for doubling T
+        auto maxThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 4);
+        for (std::size_t nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+            graphs::ThreadPool pool(nThreads);
+            record(fmt::format("concurrentBuild{}", nThreads), m, measure(reps, [&] {
+                return graphs::ConcurrentGraphBuilder<Graph>(verticesOnly(topology), m);
+            }, [&](graphs::ConcurrentGraphBuilder<Graph> &builder) {
+                std::vector<std::thread> threads;
+                for (std::size_t t = 0; t < nThreads; ++t) {
+                    threads.emplace_back([&, t] {
+                        auto first = topology.edges.begin() + static_cast<std::ptrdiff_t>(m * t / nThreads);
+                        auto last = topology.edges.begin() + static_cast<std::ptrdiff_t>(m * (t + 1) / nThreads);
+                        for (auto it = first; it != last; ++it) {
+                            builder.addEdge(graphs::PersistentIndex{std::get<0>(*it)},
+                                            graphs::PersistentIndex{std::get<1>(*it)});
+                        }
+                    });
+                }
+                for (auto &thread : threads) {
+                    thread.join();
+                }
+                sink = builder.finalize(pool).nEdges();
+            }), {{"threads", nThreads}});
+        }
+    }
+    if (selected("index32")) {
+        // the traversals of the default graph on a graph with 32-bit persistent indices
+        const auto graph32 = build<graphs::Graph32>(topology);
+        auto bytes = graph.memoryUsage().total();
+        auto bytes32 = graph32.memoryUsage().total();
+        record("index32FindNTuples", 1, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nTuples = 0;
+            graph32.findNTuples([&](const auto &) { ++nTuples; }, [&](const auto &) { ++nTuples; },
+                                [&](const auto &) { ++nTuples; });
+            sink = nTuples;
+        }), {{"bytes", bytes32}, {"bytes64", bytes}});
+        record("index32ConnectedComponents", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graph32.connectedComponents().size();
+        }), {{"bytes", bytes32}, {"bytes64", bytes}});
+    }
+    if (selected("soa")) {
+        // scanning one data field and only the topology, array-of-structs vs. columns
+        const auto soaGraph = build<graphs::SoaGraph>(topology);
+        record("scanData", n, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t sum = 0;
+            for (auto it = graph.cbegin_persistent(); it != graph.cend_persistent(); ++it) {
+                sum += it->data();
+            }
+            sink = sum;
+        }));
+        record("scanDataSoa", n, measure(reps, [] { return 0; }, [&](int &) {
+            auto column = soaGraph.vertices().column<0>();
+            sink = std::accumulate(column.begin(), column.end(), std::size_t{0});
+        }));
+        record("scanTopology", n, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nNeighbors = 0;
+            for (auto it = graph.cbegin_persistent(); it != graph.cend_persistent(); ++it) {
+                nNeighbors += it->neighbors().size();
+            }
+            sink = nNeighbors;
+        }));
+        record("scanTopologySoa", n, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nNeighbors = 0;
+            for (const auto &neighbors : soaGraph.vertices().adjacency()) {
+                nNeighbors += neighbors.size();
+            }
+            sink = nNeighbors;
+        }));
+        record("findNTuplesSoa", 1, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nTuples = 0;
+            soaGraph.findNTuples([&](const auto &) { ++nTuples; }, [&](const auto &) { ++nTuples; },
+                                 [&](const auto &) { ++nTuples; });
+            sink = nTuples;
+        }));
+    }
+    if (selected("packed")) {
+        // vertex layout without vtable and padding, relocated with memcpy when the vertex vector grows
+        const auto packedGraph = build<graphs::PackedGraph>(topology);
+        record("addVertexPacked", n, measure(reps, [] { return graphs::PackedGraph{}; }, [&](auto &g) {
+            for (std::size_t i = 0; i < n; ++i) {
+                g.addVertex(i);
+            }
+        }), {{"vertexBytes", sizeof(graphs::PackedVertex<std::size_t>)}, {"defaultVertexBytes", sizeof(graphs::DefaultVertex)}});
+        record("iteratePacked", n, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nNeighbors = 0;
+            for (const auto &v : packedGraph) {
+                nNeighbors += v.neighbors().size();
+            }
+            sink = nNeighbors;
+        }));
+        record("findNTuplesPacked", 1, measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nTuples = 0;
+            packedGraph.findNTuples([&](const auto &) { ++nTuples; }, [&](const auto &) { ++nTuples; },
+                                    [&](const auto &) { ++nTuples; });
+            sink = nTuples;
+        }));
+        record("connectedComponentsPacked", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = packedGraph.connectedComponents().size();
+        }), {{"bytes", packedGraph.memoryUsage().total()}, {"defaultBytes", graph.memoryUsage().total()}});
+    }
+    if (selected("bounded")) {
+        // inline neighbor arrays for topologies whose valence is bounded by 6 (all but erdos_renyi)
+        using BoundedGraph = graphs::BoundedGraph<6>;
+        std::vector<std::size_t> degrees(n);
+        for (const auto &[v1, v2] : topology.edges) {
+            ++degrees[v1];
+            ++degrees[v2];
+        }
+        if (n > 0 && *std::max_element(degrees.begin(), degrees.end()) <= BoundedGraph::MaxDegree) {
+            const auto boundedGraph = build<BoundedGraph>(topology);
+            record("addEdgeBounded", m, measure(reps, [&] { return verticesOnly<BoundedGraph>(topology); },
+                                                [&](BoundedGraph &g) {
+                for (const auto &[v1, v2] : topology.edges) {
+                    g.addEdge(graphs::PersistentIndex{v1}, graphs::PersistentIndex{v2});
+                }
+            }));
+            record("findNTuplesBounded", 1, measure(reps, [] { return 0; }, [&](int &) {
+                std::size_t nTuples = 0;
+                boundedGraph.findNTuples([&](const auto &) { ++nTuples; }, [&](const auto &) { ++nTuples; },
+                                         [&](const auto &) { ++nTuples; });
+                sink = nTuples;
+            }));
+            record("connectedComponentsBounded", 1, measure(reps, [] { return 0; }, [&](int &) {
+                sink = boundedGraph.connectedComponents().size();
+            }), {{"bytes", boundedGraph.memoryUsage().total()}, {"defaultBytes", graph.memoryUsage().total()}});
+            auto sources = sample(vertices, k, generator);
+            auto targets = sample(vertices, k, generator);
+            record("graphDistanceBounded", sources.size(), measure(reps, [] { return 0; }, [&](int &) {
+                std::int64_t total = 0;
+                for (std::size_t i = 0; i < sources.size(); ++i) {
+                    total += boundedGraph.graphDistance(sources[i], targets[i]);
+                }
+                sink = static_cast<std::size_t>(total);
+            }));
+        }
+    }
+    if (selected("sorted")) {
+        // neighbor lists kept sorted (bisection on insert, merge intersections) vs. the unsorted default
+        using SortedGraph = graphs::SortedGraph;
+        const auto sortedGraph = build<SortedGraph>(topology);
+        record("addEdgeUnsorted", m, measure(reps, [&] { return verticesOnly(topology); }, [&](Graph &g) {
+            for (const auto &[v1, v2] : topology.edges) {
+                g.addEdge(graphs::PersistentIndex{v1}, graphs::PersistentIndex{v2});
+            }
+        }));
+        record("addEdgeSorted", m, measure(reps, [&] { return verticesOnly<SortedGraph>(topology); },
+                                           [&](SortedGraph &g) {
+            for (const auto &[v1, v2] : topology.edges) {
+                g.addEdge(graphs::PersistentIndex{v1}, graphs::PersistentIndex{v2});
+            }
+        }));
+        // pairs at distance at most two, the end points of edges and of random 3-paths; the cost of an intersection
+        // is independent of the graph size
+        std::vector<std::tuple<graphs::PersistentIndex, graphs::PersistentIndex>> pairs;
+        for (const auto &[v1, v2] : sample(edges, options.maxOperations, generator)) {
+            pairs.emplace_back(v1, v2);
+            const auto &neighbors = graph.vertices().at(v2).neighbors();
+            pairs.emplace_back(v1, neighbors[generator() % neighbors.size()]);
+        }
+        auto intersect = [&](const auto &g) {
+            return measure(reps, [] { return 0; }, [&](int &) {
+                std::size_t nCommon = 0;
+                for (const auto &[v1, v2] : pairs) {
+                    nCommon += g.commonNeighbors(v1, v2).size();
+                }
+                sink = nCommon;
+            });
+        };
+        record("commonNeighborsUnsorted", pairs.size(), intersect(graph));
+        record("commonNeighborsSorted", pairs.size(), intersect(sortedGraph));
+        record("countTrianglesUnsorted", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graph.countTriangles();
+        }), {{"triangles", graph.countTriangles()}});
+        record("countTrianglesSorted", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = sortedGraph.countTriangles();
+        }), {{"triangles", sortedGraph.countTriangles()}});
+        record("countFourCyclesUnsorted", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = graph.countFourCycles();
+        }));
+        record("countFourCyclesSorted", 1, measure(reps, [] { return 0; }, [&](int &) {
+            sink = sortedGraph.countFourCycles();
+        }), {{"fourCycles", sortedGraph.countFourCycles()}});
+    }
+    if (selected("allocator")) {
+        // building and freeing the whole graph with the default allocator vs. std::pmr memory resources
+        record("allocatorDefault", n + m, measure(reps, [] { return 0; }, [&](int &) {
+            auto g = build(topology);
+            sink = g.nEdges();
+        }));
+        record("allocatorMonotonic", n + m, measure(reps, [] { return 0; }, [&](int &) {
+            std::pmr::monotonic_buffer_resource arena;
+            auto g = build<graphs::PmrGraph>(topology, &arena);
+            sink = g.nEdges();
+        }));
+        record("allocatorPool", n + m, measure(reps, [] { return 0; }, [&](int &) {
+            std::pmr::unsynchronized_pool_resource pool;
+            auto g = build<graphs::PmrGraph>(topology, &pool);
+            sink = g.nEdges();
+        }));
+        // the graph lives in the arena and is never destroyed, releasing the arena frees it in O(1)
+        record("allocatorMonotonicRelease", n + m, measure(reps, [] { return 0; }, [&](int &) {
+            std::pmr::monotonic_buffer_resource arena;
+            auto *g = new(arena.allocate(sizeof(graphs::PmrGraph), alignof(graphs::PmrGraph)))
+                    graphs::PmrGraph(build<graphs::PmrGraph>(topology, &arena));
+            sink = g->nEdges();
+            arena.release();
+        }));
+    }
+    if (selected("churn")) {
+        // every round removes k random vertices and adds back k/2 vertices with an edge each, so that blanks
+        // accumulate in the vertex collection
+        constexpr std::size_t nRounds = 4;
+        Graph churned;
+        auto churnSeconds = measure(reps, [&] { churned = graph; return std::mt19937_64(options.seed); },
+                                    [&](std::mt19937_64 &rng) {
+            for (std::size_t round = 0; round < nRounds; ++round) {
+                auto alive = activeIndices(churned);
+                if (alive.size() < 2) {
+                    break;
+                }
+                auto removed = sample(alive, std::min(k, alive.size() - 1), rng);
+                for (auto ix : removed) {
+                    churned.removeVertex(ix);
+                }
+                alive = activeIndices(churned);
+                std::uniform_int_distribution<std::size_t> distribution(0, alive.size() - 1);
+                for (std::size_t i = 0; i < removed.size() / 2; ++i) {
+                    auto ix = churned.addVertex(i);
+                    churned.addEdge(ix, alive[distribution(rng)]);
+                }
+            }
+        });
+        auto nBlanks = churned.vertices().size_persistent() - churned.nVertices();
+        record("churn", nRounds * k, std::move(churnSeconds), {{"blanks", nBlanks}});
+        record("iterateWithBlanks", churned.nVertices(), measure(reps, [] { return 0; }, [&](int &) {
+            std::size_t nNeighbors = 0;
+            for (const auto &v : churned) {
+                nNeighbors += v.neighbors().size();
+            }
+            sink = nNeighbors;
+        }), {{"blanks", nBlanks}});
+    }
+    if (selected("blankReuse")) {
+        // half of the vertices are removed at once, then every round removes n/20 random vertices in a batch and adds
+        // as many vertices bonded to random survivors, i.e., the vertices are replaced twice over 40 rounds; the
+        // footprint is the number of slots, traversals sum up the data of all neighbors
+        constexpr std::size_t nRounds = 40;
+        auto nReplaced = std::max<std::size_t>(n / 20, 1);
+        for (const auto &[name, policy] : {std::make_tuple("LargestFirst", graphs::BlankReuse::largestFirst),
+                                           std::make_tuple("LowestFirst", graphs::BlankReuse::lowestFirst),
+                                           std::make_tuple("Nearest", graphs::BlankReuse::nearest),
+                                           std::make_tuple("Fifo", graphs::BlankReuse::fifo)}) {
+            Graph churned;
+            std::vector<graphs::PersistentIndex> alive;
+            auto removeRandom = [&](std::size_t count, std::mt19937_64 &rng) {
+                auto batch = churned.batch();
+                for (std::size_t i = 0; i < count && alive.size() > 1; ++i) {
+                    auto position = rng() % alive.size();
+                    batch.removeVertex(alive[position]);
+                    alive[position] = alive.back();
+                    alive.pop_back();
+                }
+            };
+            auto churnSeconds = measure(reps, [&] {
+                churned = graph;
+                churned.vertices().set_blank_reuse(policy);
+                alive = vertices;
+                std::mt19937_64 rng(options.seed);
+                removeRandom(n / 2, rng);
+                return rng;
+            }, [&](std::mt19937_64 &rng) {
+                for (std::size_t round = 0; round < nRounds; ++round) {
+                    removeRandom(nReplaced, rng);
+                    for (std::size_t i = 0; i < nReplaced; ++i) {
+                        auto neighbor = alive[rng() % alive.size()];
+                        auto ix = churned.addVertex(i, neighbor);
+                        churned.addEdge(ix, neighbor);
+                        alive.push_back(ix);
+                    }
+                }
+            });
+            std::map<std::string, double> footprint {
+                    {"slots", churned.vertices().size_persistent()},
+                    {"blanks", churned.vertices().n_deactivated()},
+                    {"bytes", churned.memoryUsage().total()}
+            };
+            record(std::string("churn") + name, nRounds * nReplaced, std::move(churnSeconds), footprint);
+            record(std::string("traverse") + name, churned.nVertices(), measure(reps, [] { return 0; }, [&](int &) {
+                std::size_t total = 0;
+                for (const auto &v : churned) {
+                    for (auto neighbor : v.neighbors()) {
+                        total += churned.vertices().at(neighbor).data();
+                    }
+                }
+                sink = total;
+            }), footprint);
+        }
+    }
+    if (selected("reorder")) {
+        // the topology with randomly permuted vertex indices, as left behind by long-running churn, traversed before
+        // and after reordering
+        std::vector<std::size_t> permutation(n);
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::shuffle(permutation.begin(), permutation.end(), generator);
+        auto scattered = verticesOnly(topology);
+        for (const auto &[v1, v2] : topology.edges) {
+            scattered.addEdge(graphs::PersistentIndex{permutation[v1]}, graphs::PersistentIndex{permutation[v2]});
+        }
+        // breadth-first through graphDistance between the images of the first and the last vertex of the topology,
+        // depth-first through isConnected
+        auto source = graphs::PersistentIndex{permutation.front()};
+        auto target = graphs::PersistentIndex{permutation.back()};
+        auto traverse = [&](const std::string &name, const Graph &g,
+                            const std::vector<graphs::PersistentIndex> &mapping) {
+            auto ix1 = mapping.empty() ? source : mapping[source.value];
+            auto ix2 = mapping.empty() ? target : mapping[target.value];
+            record("bfs" + name, n, measure(reps, [] { return 0; }, [&](int &) {
+                sink = static_cast<std::size_t>(g.graphDistance(ix1, ix2));
+            }));
+            record("dfs" + name, n, measure(reps, [] { return 0; }, [&](int &) {
+                sink = g.isConnected();
+            }));
+        };
+        traverse("Scattered", scattered, {});
+        for (const auto &[name, strategy] : {std::make_tuple("Bfs", graphs::ReorderStrategy::bfs),
+                                             std::make_tuple("Rcm", graphs::ReorderStrategy::reverseCuthillMcKee),
+                                             std::make_tuple("Chain", graphs::ReorderStrategy::chain)}) {
+            Graph reordered;
+            std::vector<graphs::PersistentIndex> mapping;
+            record(std::string("reorder") + name, n, measure(reps, [&] { reordered = scattered; return 0; },
+                                                             [&](int &) {
+                mapping = reordered.reorder(strategy);
+            }));
+            traverse(std::string("After") + name, reordered, mapping);
+        }
+    }
+}
+
+/**
+ * Micro-benchmark of the search kernels on single neighbor lists with degrees from 4 to 4096, per instruction set and
+ * index width. Half of the searches hit a random position, the other half miss.
+ */
+void runNeighborSearch(const Options &options, std::vector<Result> &results) {
+    std::mt19937_64 generator(options.seed);
+    auto run = [&](auto index, const std::string &width) {
+        using Index = decltype(index);
+        for (std::size_t degree = 4; degree <= 4096; degree *= 2) {
+            std::vector<Index> neighbors(degree);
+            for (std::size_t i = 0; i < degree; ++i) {
+                neighbors[i] = Index::of(2 * i);
+            }
+            std::shuffle(neighbors.begin(), neighbors.end(), generator);
+            auto nQueries = std::max<std::size_t>(options.maxOperations * 10000 / degree, 10 * options.maxOperations);
+            std::vector<Index> queries(nQueries);
+            std::uniform_int_distribution<std::size_t> distribution(0, 2 * degree - 1);
+            for (auto &query : queries) {
+                query = Index::of(distribution(generator));
+            }
+            for (auto [level, name] : {std::make_tuple(graphs::SimdLevel::scalar, "Scalar"),
+                                       std::make_tuple(graphs::SimdLevel::sse2, "Sse2"),
+                                       std::make_tuple(graphs::SimdLevel::avx2, "Avx2")}) {
+                if (!graphs::simdSupported(level)) {
+                    continue;
+                }
+                const auto *first = neighbors.data();
+                const auto *last = first + degree;
+                auto seconds = measure(options.repetitions, [] { return 0; }, [&](int &) {
+                    std::size_t nFound = 0;
+                    for (auto query : queries) {
+                        nFound += graphs::findIndex(first, last, query, level) != last;
+                    }
+                    sink = nFound;
+                });
+                results.push_back({"neighborSearch" + width + name, "neighborList", degree, 0, nQueries,
+                                   std::move(seconds)});
+                const auto &result = results.back();
+                std::cerr << fmt::format("{:>20} {:>12} n={:<9} {:>12.6f}s\n", result.benchmark, result.topology,
+                                         degree, *std::min_element(result.seconds.begin(), result.seconds.end()));
+            }
+        }
+    };
+    run(graphs::PersistentIndex{}, "64");
+    run(graphs::PersistentIndex32{}, "32");
+}
+
+void writeJson(std::ostream &os, const Options &options, const std::vector<Result> &results) {
+    os << "{\n";
+    os << fmt::format("  \"context\": {{\"seed\": {}, \"repetitions\": {}, \"max_operations\": {}}},\n",
+                      options.seed, options.repetitions, options.maxOperations);
+    os << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &result = results[i];
+        auto min = *std::min_element(result.seconds.begin(), result.seconds.end());
+        auto mean = std::accumulate(result.seconds.begin(), result.seconds.end(), 0.) / result.seconds.size();
+        os << (i == 0 ? "\n" : ",\n");
+        os << fmt::format("    {{\"benchmark\": \"{}\", \"topology\": \"{}\", \"vertices\": {}, \"edges\": {}, "
+                          "\"operations\": {}, \"min_seconds\": {:.9g}, \"mean_seconds\": {:.9g}, "
+                          "\"ns_per_operation\": {:.6g}",
+                          result.benchmark, result.topology, result.nVertices, result.nEdges, result.nOperations,
+                          min, mean, 1e9 * min / std::max<std::size_t>(result.nOperations, 1));
+        os << ", \"seconds\": [";
+        for (std::size_t r = 0; r < result.seconds.size(); ++r) {
+            os << (r == 0 ? "" : ", ") << fmt::format("{:.9g}", result.seconds[r]);
+        }
+        os << "]";
+        for (const auto &[name, value] : result.counters) {
+            os << fmt::format(", \"{}\": {}", name, value);
+        }
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void usage(const char *program) {
+    std::cerr << "Usage: " << program << " [--min-vertices N] [--max-vertices N] [--repetitions N] "
+              << "[--max-operations N] [--seed N] [--topology NAME] [--filter BENCHMARK] [--output FILE]\n"
+              << "Sizes run in powers of ten from min to max vertices (up to 10^7), results are written as JSON "
+              << "to FILE or stdout.\n";
+}
+
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    std::vector<std::string> topologies = graphs::bench::topologyNames();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--min-vertices") options.minVertices = std::stoull(value);
+        else if (arg == "--max-vertices") options.maxVertices = std::stoull(value);
+        else if (arg == "--repetitions") options.repetitions = std::max<std::size_t>(1, std::stoull(value));
+        else if (arg == "--max-operations") options.maxOperations = std::max<std::size_t>(1, std::stoull(value));
+        else if (arg == "--seed") options.seed = std::stoull(value);
+        else if (arg == "--topology") topologies = {value};
+        else if (arg == "--filter") options.filter = value;
+        else if (arg == "--output") options.output = value;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    if (options.filter.empty() || std::string("neighborSearch").find(options.filter) != std::string::npos) {
+        runNeighborSearch(options, results);
+    }
+    for (const auto &name : topologies) {
+        for (std::size_t n = std::max<std::size_t>(options.minVertices, 1); n <= options.maxVertices; n *= 10) {
+            runTopology(options, graphs::bench::generate(name, n, options.seed), results);
+        }
+    }
+
+    if (options.output == "-") {
+        writeJson(std::cout, options, results);
+    } else {
+        std::ofstream os(options.output);
+        writeJson(os, options, results);
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * Vertex for topologies with a hard valence limit: up to MaxDegree neighbors are stored inline in a fixed-size array
+ * with a count, so that adding and removing neighbors never allocates and a vertex with its neighbors occupies one
+ * contiguous block. Graph::addEdge checks the limit once before mutating anything.
+ *
+ * @file BoundedVertex.h
+ * @brief Declarations for the vertex with bounded degree
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <tuple>
+
+#include <fmt/format.h>
+#include "IndexPersistentVector.h"
+#include "RelocatingVector.h"
+
+namespace graphs {
+
+namespace detail {
+template<typename Index, std::size_t N>
+class InlineNeighborList;
+}
+
+/**
+ * Vertex with at most MaxDegree neighbors, see BoundedVertex.h. Offers the interface of BasicVertex.
+ * @tparam MaxDegree the maximum number of neighbors
+ * @tparam Index the persistent index type of the neighbors
+ * @tparam T the data types
+ */
+template<std::size_t MaxDegree, typename Index, typename... T>
+class BasicBoundedVertex {
+    static_assert(MaxDegree > 0, "A bounded vertex needs room for at least one neighbor");
+public:
+    using data_type = std::tuple<T...>;
+    using NeighborList = detail::InlineNeighborList<Index, MaxDegree>;
+    using index_type = Index;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t max_degree = MaxDegree;
+
+    BasicBoundedVertex(T&&... data);
+
+    BasicBoundedVertex(data_type data);
+
+    BasicBoundedVertex(const BasicBoundedVertex &other);
+
+    BasicBoundedVertex &operator=(const BasicBoundedVertex &rhs);
+
+    BasicBoundedVertex(BasicBoundedVertex &&other) noexcept;
+
+    BasicBoundedVertex &operator=(BasicBoundedVertex &&rhs) noexcept;
+
+    ~BasicBoundedVertex() = default;
+
+    const NeighborList &neighbors() const;
+
+    NeighborList &neighbors();
+
+    /**
+     * Adds a neighbor if it is not a neighbor already.
+     * @throws std::length_error if the vertex already has MaxDegree neighbors
+     */
+    void addNeighbor(Index neighbor);
+
+    void removeNeighbor(Index neighbor);
+
+    const auto &data() const;
+
+    void setData(data_type data);
+
+    void deactivate();
+
+    bool deactivated() const;
+
+    auto operator->() {
+        return &std::get<0>(_data);
+    }
+
+    auto operator->() const {
+        return &std::get<0>(_data);
+    }
+
+private:
+    NeighborList _neighbors{};
+    data_type _data;
+};
+
+/**
+ * Bounded vertex with 64-bit persistent indices.
+ */
+template<std::size_t MaxDegree, typename... T>
+using BoundedVertex = BasicBoundedVertex<MaxDegree, PersistentIndex, T...>;
+
+/**
+ * Bounded vertex with 32-bit persistent indices.
+ */
+template<std::size_t MaxDegree, typename... T>
+using BoundedVertex32 = BasicBoundedVertex<MaxDegree, PersistentIndex32, T...>;
+
+}
+
+#include "bits/BoundedVertex_detail.h"
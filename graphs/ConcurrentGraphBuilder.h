@@ -0,0 +1,113 @@
+/**
+ * Builder which lets many threads insert edges into a graph at once. Edges are written into a preallocated pool,
+ * each insertion reserves its slot with a single atomic increment, insertions beyond the pool capacity go into an
+ * overflow list under a mutex. finalize() builds the adjacency from all collected edges like a compressed sparse row
+ * matrix: it counts the new neighbors per vertex, fills them into one array at the offsets given by the counts,
+ * sorts and deduplicates them per vertex and appends them to the neighbor lists. Given a ThreadPool, every step but
+ * the prefix sum over the counts runs in parallel.
+ *
+ * @file ConcurrentGraphBuilder.h
+ * @brief Declarations for the ConcurrentGraphBuilder
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace graphs {
+
+template<typename Graph>
+class ConcurrentGraphBuilder {
+public:
+    using PersistentVertexIndex = typename Graph::PersistentVertexIndex;
+    using Edge = typename Graph::Edge;
+    using VertexData = typename Graph::VertexList::value_type::data_type;
+
+    /**
+     * Creates a builder on top of an existing graph.
+     * @param graph the graph to add vertices and edges to
+     * @param edgeCapacity number of edges which can be inserted without taking a lock
+     */
+    explicit ConcurrentGraphBuilder(Graph graph = {}, std::size_t edgeCapacity = 0);
+
+    ConcurrentGraphBuilder(const ConcurrentGraphBuilder &) = delete;
+
+    ConcurrentGraphBuilder &operator=(const ConcurrentGraphBuilder &) = delete;
+
+    ConcurrentGraphBuilder(ConcurrentGraphBuilder &&) = delete;
+
+    ConcurrentGraphBuilder &operator=(ConcurrentGraphBuilder &&) = delete;
+
+    /**
+     * Adds a vertex to the graph, thread-safe. Vertex insertions are serialized among each other but do not block
+     * edge insertions.
+     * @param data the vertex data
+     * @return persistent index of the new vertex
+     */
+    PersistentVertexIndex addVertex(VertexData data = {});
+
+    /**
+     * Records an edge, thread-safe and lock-free as long as the edge pool is not exhausted. The vertices are only
+     * validated in finalize().
+     * @param ix1 first vertex
+     * @param ix2 second vertex
+     */
+    void addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2);
+
+    void addEdge(const Edge &edge);
+
+    /**
+     * Records a range of edges reserving all pool slots at once, thread-safe.
+     * @param first begin of the edge range
+     * @param last end of the edge range
+     */
+    template<typename InputIt>
+    void addEdges(InputIt first, InputIt last);
+
+    /**
+     * @return the number of recorded edges, including duplicates
+     */
+    std::size_t nRecordedEdges() const;
+
+    /**
+     * Applies all recorded edges to the graph, duplicates and edges which already exist are ignored. Must not be
+     * called concurrently with any other method of the builder. The builder can be reused afterwards, starting
+     * from an empty graph. While the graph is journaling, the edges are applied one by one through a batch.
+     * @throws std::invalid_argument if an edge refers to a vertex which does not exist or is not active, in which
+     * case neither the graph nor the recorded edges are changed
+     * @throws std::length_error if a vertex would exceed Graph::MaxDegree, in which case nothing is applied either
+     * @return the built graph
+     */
+    Graph finalize();
+
+    /**
+     * Same as finalize(), validating the edges and building the adjacency on the threads of a pool.
+     * @param pool the thread pool
+     * @return the built graph
+     */
+    Graph finalize(ThreadPool &pool);
+
+private:
+    void store(std::size_t slot, const Edge &edge);
+
+    Graph build(ThreadPool *pool);
+
+    const Edge &recorded(std::size_t i) const;
+
+    Graph _graph;
+    std::size_t _capacity;
+    std::unique_ptr<Edge[]> _pool;
+    std::atomic<std::size_t> _next {0};
+    std::mutex _vertexMutex {};
+    std::mutex _overflowMutex {};
+    std::vector<Edge> _overflow {};
+};
+
+}
+
+#include "bits/ConcurrentGraphBuilder_detail.h"
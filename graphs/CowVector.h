@@ -0,0 +1,18 @@
+/**
+ * Chunked copy-on-write vector which can be used as backing vector of the IndexPersistentContainer, making copies of
+ * the container and of graphs using it O(#chunks).
+ *
+ * @file CowVector.h
+ * @brief Declarations for the chunked copy-on-write vector
+ */
+
+#pragma once
+
+#include "bits/CowVector_detail.h"
+
+namespace graphs {
+
+template<typename T>
+using CowVector = detail::ChunkedCowVector<T, 256>;
+
+}
@@ -0,0 +1,56 @@
+/**
+ * Streaming export of graphs to GEXF, GraphML and DOT. The document is formatted into a fmt::memory_buffer without
+ * temporary strings per vertex or edge. When exporting to a std::ostream, the buffer is flushed whenever it exceeds
+ * the chunk size, so that memory stays bounded independently of the graph size. Vertices are identified by their
+ * persistent index, optionally their data is written through its fmt formatter (one attribute per field).
+ *
+ * @file Export.h
+ * @brief Declarations for the graph exporters
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include <fmt/format.h>
+
+namespace graphs {
+
+enum class ExportFormat {
+    gexf, graphml, dot
+};
+
+struct ExportOptions {
+    // whether to write the vertex data, requires an fmt formatter for every data field
+    bool vertexData {false};
+    // size in bytes above which the buffer is flushed to the output stream
+    std::size_t chunkSize {1 << 16};
+};
+
+/**
+ * Exports a graph to a stream in chunks.
+ * @param graph the graph
+ * @param os the output stream
+ * @param format the format
+ * @param options the options
+ * @throws std::invalid_argument if vertex data is requested but has no fmt formatter
+ */
+template<typename Graph>
+void exportGraph(const Graph &graph, std::ostream &os, ExportFormat format, const ExportOptions &options = {});
+
+/**
+ * Exports a graph by appending to a memory buffer.
+ * @param graph the graph
+ * @param buffer the buffer
+ * @param format the format
+ * @param options the options, the chunk size is ignored
+ * @throws std::invalid_argument if vertex data is requested but has no fmt formatter
+ */
+template<typename Graph>
+void exportGraph(const Graph &graph, fmt::memory_buffer &buffer, ExportFormat format,
+                 const ExportOptions &options = {});
+
+}
+
+#include "bits/Export_detail.h"
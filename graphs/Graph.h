@@ -5,18 +5,91 @@
 #pragma once
 
 #include <list>
+#include <exception>
 #include <algorithm>
+#include <optional>
 #include <vector>
 #include <sstream>
 
 #include <fmt/format.h>
 
 #include "IndexPersistentVector.h"
+#include "Instrumentation.h"
+#include "Serialization.h"
 
 namespace graphs {
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-class Graph {
+namespace detail {
+template<typename VertexList, typename Edge, typename = void>
+struct edge_list {
+    using type = std::vector<Edge>;
+};
+template<typename VertexList, typename Edge>
+struct edge_list<VertexList, Edge, std::void_t<typename VertexList::template backing_vector_t<Edge>>> {
+    using type = typename VertexList::template backing_vector_t<Edge>;
+};
+
+/**
+ * The compile-time limit on the number of neighbors of a vertex type (see BoundedVertex), zero if it has none.
+ */
+template<typename Vertex, typename = void>
+struct max_degree : std::integral_constant<std::size_t, 0> {
+};
+template<typename Vertex>
+struct max_degree<Vertex, std::void_t<decltype(Vertex::max_degree)>>
+        : std::integral_constant<std::size_t, Vertex::max_degree> {
+};
+template<typename Vertex>
+inline constexpr std::size_t max_degree_v = max_degree<Vertex>::value;
+}
+
+/**
+ * Memory held by a graph in bytes, broken down by component. Heap memory owned by the vertex data itself is not
+ * accounted for.
+ */
+struct MemoryUsage {
+    // capacity of the vertex collection's backing vector, including blanks
+    std::size_t vertices {0};
+    // capacity of the neighbor lists of all vertices, including deactivated ones
+    std::size_t neighbors {0};
+    // capacity of the edge list
+    std::size_t edges {0};
+    // memory of the set of blanks
+    std::size_t blanks {0};
+    // memory held by deactivated vertices: their slots in the backing vector and their neighbor lists
+    std::size_t deactivatedSlack {0};
+    // reserved but unused capacity of the backing vector, the edge list, the blanks and the active neighbor lists
+    std::size_t wastedCapacity {0};
+    // fraction of the vertex collection's slots which are blanks
+    double blankRatio {0};
+
+    /**
+     * @return the total number of bytes of all components
+     */
+    [[nodiscard]] std::size_t total() const {
+        return vertices + neighbors + edges + blanks;
+    }
+};
+
+/**
+ * Orders in which Graph::reorder() lays out the vertices.
+ */
+enum class ReorderStrategy {
+    // breadth-first, components in the order of their lowest persistent index
+    bfs,
+    // breadth-first from a pseudo-peripheral vertex with neighbors by ascending degree, reversed; this narrows the
+    // band of the adjacency matrix
+    reverseCuthillMcKee,
+    // depth-first from the ends of chains, so that consecutive vertices of a chain are adjacent in memory
+    chain
+};
+
+template<typename Graph>
+class ConcurrentGraphBuilder;
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation = NoInstrumentation,
+         typename... Rest>
+class Graph : private Instrumentation {
 public:
 
     using VertexList = VertexCollection<Vertex, Rest...>;
@@ -32,17 +105,42 @@ public:
     using Path3 = std::tuple<PersistentVertexIndex, PersistentVertexIndex, PersistentVertexIndex>;
     using Path4 = std::tuple<PersistentVertexIndex, PersistentVertexIndex, PersistentVertexIndex, PersistentVertexIndex>;
 
+    // edges are stored in the same kind of vector as the vertices
+    using EdgeList = typename detail::edge_list<VertexList, Edge>::type;
+
+    using allocator_type = typename VertexList::allocator_type;
+
     using iterator = typename VertexList::iterator;
     using const_iterator = typename VertexList::const_iterator;
 
     using persistent_iterator = typename VertexList::persistent_iterator;
     using const_persistent_iterator = typename VertexList::const_persistent_iterator;
 
+    // maximum number of neighbors per vertex if the vertex type stores them inline (see BoundedVertex), zero otherwise
+    static constexpr std::size_t MaxDegree = detail::max_degree_v<Vertex>;
+
+    // whether the vertex type keeps its neighbors sorted by index (see SortedVertex)
+    static constexpr bool SortedNeighbors = detail::sorted_neighbors_v<Vertex>;
+
     Graph();
 
     explicit Graph(VertexList vertexList);
 
-    virtual ~Graph();
+    /**
+     * Creates an empty graph whose vertices, blanks and edges allocate through the given allocator. With std::pmr
+     * (see PmrGraph) neighbor lists are allocated from the same memory resource.
+     * @param allocator the allocator
+     */
+    explicit Graph(const allocator_type &allocator);
+
+    /**
+     * Copies a graph into storage obtained from the given allocator.
+     * @param other the graph to copy
+     * @param allocator the allocator
+     */
+    Graph(const Graph &other, const allocator_type &allocator);
+
+    ~Graph();
 
     Graph(const Graph &) = default;
 
@@ -68,6 +166,8 @@ public:
     const_persistent_iterator end_persistent() const;
     const_persistent_iterator cend_persistent() const;
 
+    allocator_type get_allocator() const;
+
     const VertexList &vertices() const;
 
     VertexList &vertices();
@@ -86,8 +186,21 @@ public:
 
     PersistentVertexIndex addVertex(typename Vertex::data_type data = {});
 
+    /**
+     * Adds a vertex, with the BlankReuse::nearest policy of the vertex collection into the blank closest to another
+     * vertex, e.g., the one it is going to be bonded to.
+     * @param data the vertex data
+     * @param near the vertex close to which a blank is reused
+     * @return the persistent index of the new vertex
+     */
+    PersistentVertexIndex addVertex(typename Vertex::data_type data, PersistentVertexIndex near);
+
     void addEdge(iterator it1, iterator it2);
 
+    /**
+     * Adds an edge between two active vertices.
+     * @throws std::length_error if MaxDegree is set and one of the vertices already has that many other neighbors
+     */
     void addEdge(persistent_iterator it1, persistent_iterator it2);
 
     void addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2);
@@ -128,7 +241,7 @@ public:
     template<typename T1, typename T2>
     std::int32_t graphDistance(T1 it1, T2 it2) const;
 
-    const std::vector<Edge> &edges() const;
+    const EdgeList &edges() const;
 
     std::size_t nEdges() const;
 
@@ -138,20 +251,46 @@ public:
     template<typename TupleCallback, typename TripleCallback, typename QuadrupleCallback>
     void findNTuples(const TupleCallback &pairCallback,
                      const TripleCallback &tripleCallback,
-                     const QuadrupleCallback &quadrupleCallback);
+                     const QuadrupleCallback &quadrupleCallback) const;
 
-    std::tuple<std::vector<Edge>, std::vector<Path3>, std::vector<Path4>> findNTuples();
+    std::tuple<std::vector<Edge>, std::vector<Path3>, std::vector<Path4>> findNTuples() const;
+
+    /**
+     * Yields the vertices adjacent to both v1 and v2 in ascending order. With SortedNeighbors this is a linear merge of
+     * the two neighbor lists, otherwise every neighbor of v1 is searched in the neighbors of v2.
+     * @param v1 the first vertex
+     * @param v2 the second vertex
+     * @return the common neighbors
+     */
+    std::vector<PersistentVertexIndex> commonNeighbors(PersistentVertexIndex v1, PersistentVertexIndex v2) const;
+
+    /**
+     * Counts the triangles, i.e., the sets of three distinct vertices which are pairwise adjacent. Every edge (u, v)
+     * with u < v is intersected with the neighbors of both ends which are larger than v.
+     * @return the number of triangles
+     */
+    std::size_t countTriangles() const;
+
+    /**
+     * Counts the 4-cycles (v1, v2, v3, v4) of distinct vertices, irrespective of chords. For every pair of vertices at
+     * distance at most two the common neighbors are intersected, each cycle is found through both of its diagonals.
+     * The graph contains a 4-cycle if the count is not zero.
+     * @return the number of 4-cycles
+     */
+    std::size_t countFourCycles() const;
 
     /**
      * Returns the connected components in terms of a list of new graph objects
      * @return connected components
      */
-    std::vector<Graph> connectedComponents();
+    std::vector<Graph> connectedComponents() const;
 
     /**
      * Appends the graph `other` to this graph. No edge is introduced, this graph will have at least two connected
      * components afterwards. Returns an index mapping for the `other` graph which (for the active vertices) contains
-     * the index of the vertex in this graph, i.e., `newIndex = mapping[oldIndex]`.
+     * the index of the vertex in this graph, i.e., `newIndex = mapping[oldIndex]`. If neither graph has blanks and no
+     * checkpoint is open, the mapping is a shift and vertices, neighbor lists and edges are copied in bulk; otherwise
+     * the vertices and edges are added one by one, reusing blanks of this graph.
      * @param other the other graph
      * @return index mapping
      */
@@ -169,21 +308,270 @@ public:
     std::vector<PersistentVertexIndex> append(const Graph &other, PersistentVertexIndex edgeIndexThis, PersistentVertexIndex edgeIndexOther);
     std::vector<PersistentVertexIndex> append(const Graph &other, ActiveVertexIndex edgeIndexThis, ActiveVertexIndex edgeIndexOther);
 
+    /**
+     * Exports this graph to GEXF, see exportGraph() for streaming, other formats and vertex data.
+     * @return the document
+     */
     std::string gexf() const;
 
+    /**
+     * Writes this graph in a compact binary format: a versioned header, the blanks of the vertex collection, the
+     * vertex data in blocks of columns, the neighbor lists in CSR form (offsets and concatenated neighbors) and the
+     * edge list. Integers are stored little-endian, trivially copyable vertex data is copied in bulk, other data types
+     * go through graphs::Serializer. Persistent indices as well as the order of neighbors and edges survive a round
+     * trip, checkpoints and instrumentation counters are not stored.
+     * @param os the output stream, opened in binary mode
+     * @throws std::runtime_error if writing to the stream fails
+     */
+    void write(std::ostream &os) const;
+
+    /**
+     * Reads a graph written by write(). Data which was read ahead beyond the end of the graph is handed back to the
+     * stream by seeking, so that further content can follow the graph in a seekable stream.
+     * @param is the input stream, opened in binary mode
+     * @param allocator the allocator of the graph
+     * @return the graph
+     * @throws std::runtime_error if the data is truncated, corrupt or was written with another vertex data layout
+     */
+    static Graph read(std::istream &is, const allocator_type &allocator = {});
+
+    /**
+     * Takes a snapshot of this graph. With copy-on-write storage (see CowGraph) this is O(#chunks) and subsequent
+     * writes to either graph only duplicate the chunks they touch, otherwise it is a deep copy.
+     * @return the snapshot
+     */
+    Graph snapshot() const;
+
+    /**
+     * Buffers edge and vertex mutations and applies them in one sorted, deduplicated pass over the affected
+     * neighbor lists, the edge list and the blanks of the vertex collection. Vertices are added immediately so that
+     * their persistent index can be used for edges within the same batch. Edge operations on the same (undirected)
+     * edge resolve to the last recorded one, removing a vertex removes all of its edges including those added in the
+     * batch. Pending operations are committed on destruction, unless the batch is destroyed during stack unwinding
+     * caused by an exception thrown since it was opened (e.g., by a failed precondition of one of its operations), in
+     * which case they are discarded. They are discarded as well if committing them on destruction would let a vertex
+     * exceed MaxDegree; commit() explicitly to get the std::length_error.
+     */
+    class Batch {
+    public:
+        explicit Batch(Graph &graph);
+
+        ~Batch();
+
+        Batch(const Batch &) = delete;
+
+        Batch &operator=(const Batch &) = delete;
+
+        Batch(Batch &&other) noexcept;
+
+        Batch &operator=(Batch &&) = delete;
+
+        PersistentVertexIndex addVertex(typename Vertex::data_type data = {});
+
+        void addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2);
+
+        void addEdge(const Edge &edge);
+
+        void removeEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2);
+
+        void removeEdge(const Edge &edge);
+
+        void removeVertex(PersistentVertexIndex ix);
+
+        /**
+         * @return the number of buffered edge and vertex removal operations
+         */
+        std::size_t nPending() const;
+
+        /**
+         * Applies all buffered operations to the graph.
+         * @throws std::length_error if a vertex would exceed MaxDegree, in which case nothing is applied and the
+         * buffered operations are dropped
+         */
+        void commit();
+
+    private:
+        Graph *_graph;
+        // normalized edge (smaller index first) together with whether it should be added or removed
+        std::vector<std::tuple<Edge, bool>> _edgeOperations {};
+        std::vector<PersistentVertexIndex> _removedVertices {};
+        // std::uncaught_exceptions() when the batch was opened
+        int _uncaughtExceptions;
+    };
+
+    /**
+     * Opens a batch of mutations on this graph, see Batch.
+     * @return the batch
+     */
+    Batch batch();
+
+    /**
+     * Opens a checkpoint. While at least one checkpoint is open, edge and vertex mutations through this graph are
+     * journaled so that they can be undone with rollback() in O(#changes) instead of copying the graph up front.
+     * Changes to vertex data are not journaled. Checkpoints can be nested.
+     */
+    void checkpoint();
+
+    /**
+     * Undoes all mutations since the last checkpoint and closes it. Edges and neighbors are restored at their
+     * previous positions, vertices at their previous persistent indices.
+     */
+    void rollback();
+
+    /**
+     * Keeps all mutations since the last checkpoint and closes it.
+     */
+    void commit();
+
+    /**
+     * @return whether mutations are currently journaled
+     */
+    bool journaling() const;
+
+    /**
+     * Sets a change marker, replacing an earlier one. From now on the persistent indices of vertices which are added,
+     * removed, gain or lose edges (including through Batch and rollback()) or whose data is set through setData() are
+     * recorded, see writeDelta(). Vertex data modified through references has to be reported with touch().
+     */
+    void mark();
+
+    /**
+     * Removes the change marker and stops recording changes.
+     */
+    void unmark();
+
+    /**
+     * @return whether a change marker is set
+     */
+    bool tracking() const;
+
+    /**
+     * Reports a change of the data of a vertex which was made without going through the graph. Does nothing if no
+     * change marker is set.
+     * @param ix the vertex
+     */
+    void touch(PersistentVertexIndex ix);
+
+    /**
+     * Sets the data of a vertex and records the change.
+     * @param ix the vertex
+     * @param data the data
+     */
+    void setData(PersistentVertexIndex ix, typename Vertex::data_type data);
+
+    /**
+     * @return the sorted persistent indices of the vertices changed since the change marker
+     */
+    std::vector<PersistentVertexIndex> changedVertices() const;
+
+    /**
+     * Writes the changes since the change marker as a binary delta: for every changed vertex slot whether it is
+     * active and, if it is, its data and neighbors. The size is proportional to the number of changed vertices and
+     * their degrees, not to the size of the graph. Together with mark() this allows periodic checkpoints which
+     * consist of one full write() followed by deltas.
+     * @param os the output stream, opened in binary mode
+     * @throws std::logic_error if no change marker is set
+     * @throws std::runtime_error if writing to the stream fails
+     */
+    void writeDelta(std::ostream &os) const;
+
+    /**
+     * Applies a delta written by writeDelta() to this graph, which has to be in the state the written graph was in at
+     * its change marker (e.g., a snapshot or a checkpoint read back with read()). Afterwards vertex slots, data and
+     * edges match the written graph; the order of neighbors and edges may differ. Edges are updated in one Batch.
+     * @param is the input stream, opened in binary mode
+     * @throws std::runtime_error if the delta is corrupt, was written with another vertex data layout or does not
+     * match this graph
+     */
+    void applyDelta(std::istream &is);
+
+    /**
+     * Reports the memory held by this graph, see MemoryUsage.
+     * @return the breakdown by component
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * Releases unused capacity of the vertex collection, the edge list and all neighbor lists, drops the neighbor
+     * lists of deactivated vertices and the blanks at the end of the vertex collection. Persistent indices of active
+     * vertices stay valid.
+     * @throws std::logic_error while journaling
+     */
+    void shrinkToFit();
+
+    /**
+     * Permutes the vertices so that adjacent vertices are close in memory, which speeds up traversals after churn
+     * has scattered them across the vertex collection. Blanks are dropped, the neighbor lists and the edges are
+     * rewritten in terms of the new persistent indices; the order of neighbors and edges is kept unless the neighbor
+     * lists are sorted. While a change marker is set, every vertex slot counts as changed.
+     * @param strategy the vertex order
+     * @return index mapping which (for the active vertices) contains the new persistent index of a vertex, i.e.,
+     * `newIndex = mapping[oldIndex]`
+     * @throws std::logic_error while journaling
+     */
+    std::vector<PersistentVertexIndex> reorder(ReorderStrategy strategy = ReorderStrategy::bfs);
+
+    /**
+     * Yields the counters maintained by the instrumentation policy, all zero with the default NoInstrumentation.
+     * @return the counters
+     */
+    Stats stats() const;
+
+    /**
+     * Resets the counters of the instrumentation policy.
+     */
+    void resetStats();
+
 private:
+    // fills the neighbor lists and the edge list directly when finalizing
+    template<typename> friend class ConcurrentGraphBuilder;
+
+    struct JournalEntry {
+        Edge edge;
+        // whether the edge was added or removed
+        bool added;
+        std::size_t edgePosition;
+        // position of the second vertex in the neighbors of the first vertex and vice versa, npos if unchanged
+        std::size_t neighborPosition1;
+        std::size_t neighborPosition2;
+        // size of the vertex list journal at the time of the mutation
+        std::size_t verticesJournalSize;
+    };
+
+    // size of the graph when the change marker was set, a delta only applies to a graph of the same size
+    struct ChangeMarker {
+        std::size_t nVertices;
+        std::size_t nEdges;
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
     VertexList _vertices{};
-    std::vector<Edge> _edges {};
+    EdgeList _edges {};
+    std::vector<JournalEntry> _journal {};
+    std::vector<std::size_t> _checkpoints {};
+    std::optional<ChangeMarker> _marker {};
+    // vertices changed since the marker, may contain duplicates
+    std::vector<PersistentVertexIndex> _changed {};
+
+    const Instrumentation &instrumentation() const {
+        return *this;
+    }
 
     void removeNeighborsEdges(PersistentVertexIndex ix);
 
+    /**
+     * @throws std::length_error if the degree exceeds MaxDegree
+     */
+    static void checkDegree(PersistentVertexIndex ix, std::size_t degree);
+
     /**
      * this has always to be called for both v1 and v2 (symmetric neighborship)
      * @tparam debug
      * @param v1
      * @param v2
      */
-    void addVertexNeighbor(Vertex& v1, PersistentVertexIndex v2);
+    void addVertexNeighbor(typename VertexList::reference v1, PersistentVertexIndex v2);
 
     /**
      * this has always to be called for both v1 and v2 (symmetric neighborship)
@@ -191,7 +579,7 @@ private:
      * @param v1
      * @param v2
      */
-    void removeVertexNeighbor(Vertex& v1, PersistentVertexIndex v2);
+    void removeVertexNeighbor(typename VertexList::reference v1, PersistentVertexIndex v2);
 
     template<typename T>
     auto toPersistentIterator(T it) const {
@@ -0,0 +1,154 @@
+/**
+ * Container for many small graphs which share contiguous pools for vertex data and adjacency. Every graph occupies a
+ * contiguous range of vertex slots and a contiguous range of the adjacency pool (compressed sparse rows), vertices are
+ * addressed by the graph id and their local index within the graph. Graphs are added and removed as a whole, removed
+ * ranges are reclaimed by compaction once they make up more than half of the pools.
+ *
+ * @file GraphCollection.h
+ * @brief Declarations for the GraphCollection
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "IndexPersistentVector.h"
+
+namespace graphs {
+
+template<typename Graph>
+class GraphCollection {
+    using Vertex = typename Graph::VertexList::value_type;
+
+    struct GraphRecord {
+        std::size_t vertexOffset;
+        std::size_t nVertices;
+        std::size_t nEdges;
+        bool active {true};
+
+        void deactivate() {
+            active = false;
+        }
+
+        [[nodiscard]] bool deactivated() const {
+            return !active;
+        }
+    };
+
+public:
+    /**
+     * persistent id of a graph in the collection, stays valid until the graph is removed
+     */
+    using GraphId = PersistentIndex;
+    /**
+     * index of a vertex within its graph, 0, ..., nVertices(graph) - 1
+     */
+    using LocalVertexIndex = PersistentIndex;
+    using data_type = std::decay_t<decltype(std::declval<const Vertex &>().data())>;
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * Contiguous range of the neighbors of a vertex in terms of local vertex indices.
+     */
+    struct NeighborRange {
+        const LocalVertexIndex *first;
+        const LocalVertexIndex *last;
+
+        const LocalVertexIndex *begin() const { return first; }
+
+        const LocalVertexIndex *end() const { return last; }
+
+        [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(last - first); }
+
+        [[nodiscard]] bool empty() const { return first == last; }
+    };
+
+    /**
+     * Adds a copy of a graph. Its active vertices are renumbered to 0, ..., nVertices() - 1 in order of their
+     * persistent indices.
+     * @param graph the graph
+     * @return the id of the graph in the collection
+     */
+    GraphId add(const Graph &graph);
+
+    /**
+     * Removes a graph, O(1) amortized.
+     * @param id the graph id
+     */
+    void remove(GraphId id);
+
+    /**
+     * Reconstructs a graph of the collection as a standalone Graph, e.g., for modifying it.
+     * @param id the graph id
+     * @return the graph
+     */
+    Graph graph(GraphId id) const;
+
+    /**
+     * @return the ids of all graphs in the collection
+     */
+    std::vector<GraphId> graphIds() const;
+
+    [[nodiscard]] std::size_t nGraphs() const;
+
+    [[nodiscard]] std::size_t nVertices(GraphId id) const;
+
+    [[nodiscard]] std::size_t nEdges(GraphId id) const;
+
+    /**
+     * Offset of the graph's vertices in the vertex pool, see componentLabels().
+     * @param id the graph id
+     * @return the offset
+     */
+    [[nodiscard]] std::size_t vertexOffset(GraphId id) const;
+
+    /**
+     * @return the number of vertex slots in the pool, including slots of removed graphs which were not yet compacted
+     */
+    [[nodiscard]] std::size_t vertexPoolSize() const;
+
+    const data_type &data(GraphId id, LocalVertexIndex vertex) const;
+
+    data_type &data(GraphId id, LocalVertexIndex vertex);
+
+    NeighborRange neighbors(GraphId id, LocalVertexIndex vertex) const;
+
+    /**
+     * Enumerates the pairs, triples and quadruples (paths of length 1, 2 and 3) of all graphs in one pass over the
+     * pools, in the same way as Graph::findNTuples. The callbacks are invoked with the graph id and a tuple of local
+     * vertex indices.
+     */
+    template<typename PairCallback, typename TripleCallback, typename QuadrupleCallback>
+    void findNTuples(const PairCallback &pairCallback, const TripleCallback &tripleCallback,
+                     const QuadrupleCallback &quadrupleCallback) const;
+
+    /**
+     * Labels the connected components of all graphs at once. Labels are unique across the collection, the label of
+     * vertex v of graph id is `labels[vertexOffset(id) + v.value]`, slots of removed graphs are labeled npos.
+     * @return the labels in vertex pool order
+     */
+    std::vector<std::size_t> componentLabels() const;
+
+    /**
+     * Moves all graphs together, dropping the pool ranges of removed graphs. Graph ids stay valid.
+     */
+    void compact();
+
+    void reserve(std::size_t nVertices, std::size_t nAdjacency);
+
+private:
+    const GraphRecord &record(GraphId id) const;
+
+    IndexPersistentVector<GraphRecord> _graphs {};
+    std::vector<data_type> _data {};
+    // begin of the neighbors of every vertex slot in the adjacency pool, the end is the begin of the next slot
+    std::vector<std::size_t> _neighborOffsets {0};
+    std::vector<LocalVertexIndex> _adjacency {};
+    std::size_t _garbageVertices {0};
+};
+
+}
+
+#include "bits/GraphCollection_detail.h"
@@ -0,0 +1,75 @@
+/**
+ * Import of graphs from plain-text edge lists and from GEXF as written by exportGraph() / Graph::gexf(). Files are
+ * memory-mapped, edge lists are split into chunks at line boundaries which are parsed with std::from_chars in
+ * parallel. The parsed edges are sorted and deduplicated, then the graph is constructed in one pass: neighbor lists
+ * are reserved to their final degree up front (as for compressed sparse rows) and the edge list is derived from them.
+ *
+ * Edge lists contain one edge per line as two non-negative integer vertex ids separated by whitespace or a comma,
+ * further columns (e.g., weights) are ignored, lines starting with '#' or '%' are comments. The graph has one vertex
+ * per id from 0 up to the largest id, edges are undirected, duplicates and self-loops are dropped. Vertex data is
+ * value-initialized. Ids have to be smaller than the largest value of the graph's index type.
+ *
+ * @file Import.h
+ * @brief Declarations for the graph importers
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "ThreadPool.h"
+
+namespace graphs::io {
+
+/**
+ * Parses an edge list in parallel.
+ * @tparam Graph the graph type
+ * @param pool the thread pool
+ * @param text the edge list
+ * @return the graph, vertex ids are persistent indices
+ * @throws std::runtime_error if the text is not a valid edge list
+ */
+template<typename Graph>
+Graph parseEdgeList(ThreadPool &pool, std::string_view text);
+
+/**
+ * Parses an edge list on the calling thread.
+ */
+template<typename Graph>
+Graph parseEdgeList(std::string_view text);
+
+/**
+ * Memory-maps a file and parses it as edge list in parallel.
+ * @throws std::system_error if the file cannot be opened
+ */
+template<typename Graph>
+Graph readEdgeList(ThreadPool &pool, const std::string &path);
+
+/**
+ * Memory-maps a file and parses it as edge list on the calling thread.
+ */
+template<typename Graph>
+Graph readEdgeList(const std::string &path);
+
+/**
+ * Parses the nodes and edges of a GEXF document with integer node ids. Node ids become persistent indices, ids which
+ * do not occur as node are blanks. Attributes are not restored.
+ * @tparam Graph the graph type
+ * @param text the document
+ * @return the graph
+ * @throws std::runtime_error if the document is malformed, edges refer to undeclared nodes or a node id does not
+ * fit the index type
+ */
+template<typename Graph>
+Graph parseGexf(std::string_view text);
+
+/**
+ * Memory-maps a file and parses it as GEXF document.
+ */
+template<typename Graph>
+Graph readGexf(const std::string &path);
+
+}
+
+#include "bits/Import_detail.h"
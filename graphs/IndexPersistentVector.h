@@ -1,6 +1,6 @@
 /**
- * This file contains the index_persistent_vector, a vector structure together with a stack of 'blanks'. Removal of
- * elements will result in a push back onto the stack of their respective indices, rendering them 'blank'. This handling
+ * This file contains the index_persistent_vector, a vector structure together with a set of 'blanks'. Removal of
+ * elements will result in an insertion of their respective indices into the set, rendering them 'blank'. This handling
  * potentially increases the memory requirements but avoids the shift of access indices.
  *
  * @file index_persistent_vector.h
@@ -12,13 +12,42 @@
 
 #pragma once
 
+#include <memory_resource>
+
 #include "bits/IndexPersistentVector_detail.h"
+#include "CowVector.h"
+#include "SoaVector.h"
+#include "RelocatingVector.h"
 
 namespace graphs {
 
-struct PersistentIndex;
-
 template<typename T>
 using IndexPersistentVector = detail::IndexPersistentContainer<std::vector, T>;
 
+/**
+ * IndexPersistentVector backed by a chunked copy-on-write vector, copies are O(#chunks) and share unmodified chunks.
+ */
+template<typename T>
+using CowIndexPersistentVector = detail::IndexPersistentContainer<CowVector, T>;
+
+/**
+ * IndexPersistentVector whose backing vector and blanks allocate through std::pmr::polymorphic_allocator. Together
+ * with PmrVertex all allocations of a graph come from one memory resource.
+ */
+template<typename T>
+using PmrIndexPersistentVector = detail::IndexPersistentContainer<std::pmr::vector, T>;
+
+/**
+ * IndexPersistentVector storing vertices in columns, see SoaVector. Elements are accessed through proxies, the data
+ * fields are exposed as spans with column<I>().
+ */
+template<typename T>
+using SoaIndexPersistentVector = detail::IndexPersistentContainer<SoaVector, T>;
+
+/**
+ * IndexPersistentVector which relocates its elements with memcpy when growing, see RelocatingVector and PackedVertex.
+ */
+template<typename T>
+using PackedIndexPersistentVector = detail::IndexPersistentContainer<RelocatingVector, T>;
+
 }
@@ -0,0 +1,218 @@
+/**
+ * Compile-time instrumentation policies for the Graph. The policy is a template parameter of the Graph, the default
+ * NoInstrumentation consists of empty inline functions and an empty base so that it compiles to nothing. With
+ * CountingInstrumentation the graph maintains counters for its hot paths (BFS passes, visited vertices, linear scans
+ * of the edge list, skipped blanks) and the number of calls per public operation, TimingInstrumentation additionally
+ * accumulates the wall time spent in each operation.
+ *
+ * @file Instrumentation.h
+ * @brief Instrumentation policies for the Graph
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace graphs {
+
+/**
+ * Events counted on the hot paths of the graph.
+ */
+enum class Counter : std::size_t {
+    // breadth- or depth-first traversals (graphDistance, isConnected, one per component in connectedComponents)
+    bfsPasses,
+    // vertices expanded during traversals
+    visitedVertices,
+    // linear searches through the edge list (containsEdge, removeEdge, removeVertex)
+    edgeListScans,
+    // edges inspected during these searches
+    scannedEdges,
+    // blanks of the vertex collection which were skipped by full passes over the vertices
+    skippedBlanks,
+    nCounters
+};
+
+/**
+ * Public operations of the graph for which calls (and optionally time) are recorded.
+ */
+enum class Operation : std::size_t {
+    addVertex,
+    addEdge,
+    removeEdge,
+    removeVertex,
+    containsEdge,
+    isConnected,
+    graphDistance,
+    findNTuples,
+    connectedComponents,
+    append,
+    gexf,
+    commonNeighbors,
+    countTriangles,
+    countFourCycles,
+    reorder,
+    nOperations
+};
+
+/**
+ * Snapshot of the instrumentation counters of a graph.
+ */
+struct Stats {
+    static constexpr auto nCounters = static_cast<std::size_t>(Counter::nCounters);
+    static constexpr auto nOperations = static_cast<std::size_t>(Operation::nOperations);
+
+    std::array<std::uint64_t, nCounters> counters {};
+    std::array<std::uint64_t, nOperations> calls {};
+    std::array<std::chrono::nanoseconds, nOperations> times {};
+
+    /**
+     * @param counter the counter
+     * @return the number of counted events
+     */
+    [[nodiscard]] std::uint64_t count(Counter counter) const {
+        return counters[static_cast<std::size_t>(counter)];
+    }
+
+    /**
+     * @param operation the operation
+     * @return the number of calls to the operation
+     */
+    [[nodiscard]] std::uint64_t nCalls(Operation operation) const {
+        return calls[static_cast<std::size_t>(operation)];
+    }
+
+    /**
+     * @param operation the operation
+     * @return the accumulated time spent in the operation, zero unless timing is enabled
+     */
+    [[nodiscard]] std::chrono::nanoseconds time(Operation operation) const {
+        return times[static_cast<std::size_t>(operation)];
+    }
+};
+
+/**
+ * Default policy, all hooks are no-ops.
+ */
+struct NoInstrumentation {
+    static constexpr bool enabled = false;
+
+    struct Scope {};
+
+    void count(Counter, std::uint64_t = 1) const noexcept {}
+
+    Scope scope(Operation) const noexcept { return {}; }
+
+    Stats stats() const { return {}; }
+
+    void reset() noexcept {}
+};
+
+/**
+ * Policy which counts events and calls per operation. The counters are relaxed atomics so that const operations can
+ * be instrumented while being called concurrently (e.g., through a PublishedGraph).
+ * @tparam Timing whether to also accumulate the wall time spent in each operation
+ */
+template<bool Timing = false>
+class CountingInstrumentation {
+public:
+    static constexpr bool enabled = true;
+
+    /**
+     * Records the time spent in an operation on destruction if timing is enabled.
+     */
+    class Scope {
+    public:
+        Scope(const CountingInstrumentation *instrumentation, Operation operation)
+                : _instrumentation(instrumentation), _operation(operation) {
+            if constexpr (Timing) {
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            if constexpr (Timing) {
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - _start);
+                _instrumentation->_times[static_cast<std::size_t>(_operation)].fetch_add(
+                        static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        const CountingInstrumentation *_instrumentation;
+        Operation _operation;
+        std::chrono::steady_clock::time_point _start {};
+    };
+
+    CountingInstrumentation() = default;
+
+    CountingInstrumentation(const CountingInstrumentation &other) {
+        assign(other);
+    }
+
+    CountingInstrumentation &operator=(const CountingInstrumentation &rhs) {
+        if (this != &rhs) {
+            assign(rhs);
+        }
+        return *this;
+    }
+
+    void count(Counter counter, std::uint64_t n = 1) const noexcept {
+        _counters[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * Counts a call of the operation and, if timing is enabled, measures the time until the returned scope ends.
+     * @param operation the operation
+     * @return the scope
+     */
+    Scope scope(Operation operation) const noexcept {
+        _calls[static_cast<std::size_t>(operation)].fetch_add(1, std::memory_order_relaxed);
+        return {this, operation};
+    }
+
+    Stats stats() const {
+        Stats stats;
+        for (std::size_t i = 0; i < Stats::nCounters; ++i) {
+            stats.counters[i] = _counters[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < Stats::nOperations; ++i) {
+            stats.calls[i] = _calls[i].load(std::memory_order_relaxed);
+            stats.times[i] = std::chrono::nanoseconds(_times[i].load(std::memory_order_relaxed));
+        }
+        return stats;
+    }
+
+    void reset() noexcept {
+        for (auto &counter : _counters) counter.store(0, std::memory_order_relaxed);
+        for (auto &calls : _calls) calls.store(0, std::memory_order_relaxed);
+        for (auto &time : _times) time.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    void assign(const CountingInstrumentation &other) {
+        for (std::size_t i = 0; i < Stats::nCounters; ++i) {
+            _counters[i].store(other._counters[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < Stats::nOperations; ++i) {
+            _calls[i].store(other._calls[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _times[i].store(other._times[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    mutable std::array<std::atomic<std::uint64_t>, Stats::nCounters> _counters {};
+    mutable std::array<std::atomic<std::uint64_t>, Stats::nOperations> _calls {};
+    mutable std::array<std::atomic<std::uint64_t>, Stats::nOperations> _times {};
+};
+
+using TimingInstrumentation = CountingInstrumentation<true>;
+
+}
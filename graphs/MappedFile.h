@@ -0,0 +1,141 @@
+/**
+ * Read-only memory mapping of a file. On platforms without mmap the file is read into an owned buffer instead, so
+ * users see the same interface either way.
+ *
+ * @file MappedFile.h
+ * @brief Read-only file mapping
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GRAPHS_HAS_MMAP 1
+#else
+#define GRAPHS_HAS_MMAP 0
+#endif
+
+namespace graphs {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /**
+     * Maps a file. The mapping is aligned at least like std::max_align_t.
+     * @param path path to the file
+     * @throws std::system_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string &path) {
+#if GRAPHS_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat status {};
+        if (::fstat(fd, &status) != 0) {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+        auto size = static_cast<std::size_t>(status.st_size);
+        if (size == 0) {
+            // empty files cannot be mapped
+            ::close(fd);
+            return;
+        }
+        void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        auto error = errno;
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+        }
+        _data = static_cast<const unsigned char *>(data);
+        _size = size;
+        _mapped = true;
+#else
+        std::ifstream is(path, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+        if (!is) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        auto size = static_cast<std::size_t>(is.tellg());
+        is.seekg(0);
+        _buffer.reset(new std::max_align_t[(size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t)]);
+        if (!is.read(reinterpret_cast<char *>(_buffer.get()), static_cast<std::streamsize>(size))) {
+            throw std::system_error(errno, std::generic_category(), "Cannot read " + path);
+        }
+        _data = reinterpret_cast<const unsigned char *>(_buffer.get());
+        _size = size;
+#endif
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile &operator=(MappedFile &&rhs) noexcept {
+        if (this != &rhs) {
+            unmap();
+            _data = std::exchange(rhs._data, nullptr);
+            _size = std::exchange(rhs._size, 0);
+            _mapped = std::exchange(rhs._mapped, false);
+            _buffer = std::move(rhs._buffer);
+        }
+        return *this;
+    }
+
+    /**
+     * @return the contents of the file, nullptr if it is empty
+     */
+    [[nodiscard]] const unsigned char *data() const {
+        return _data;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return _size;
+    }
+
+private:
+    void unmap() noexcept {
+#if GRAPHS_HAS_MMAP
+        if (_mapped) {
+            ::munmap(const_cast<unsigned char *>(_data), _size);
+        }
+#endif
+        _mapped = false;
+        _data = nullptr;
+        _size = 0;
+        _buffer.reset();
+    }
+
+    const unsigned char *_data {nullptr};
+    std::size_t _size {0};
+    // whether _data is a mapping owned by this object
+    bool _mapped {false};
+    // copy of the file on platforms without mmap
+    std::unique_ptr<std::max_align_t[]> _buffer {};
+};
+
+}
+
+#undef GRAPHS_HAS_MMAP
@@ -0,0 +1,177 @@
+/**
+ * Read-only view of a graph stored in a memory-mappable file. The file consists of a header followed by 64 byte
+ * aligned sections: the CSR offsets and neighbor array of all vertex slots, the activity flag of every slot, the
+ * persistent indices of the active vertices (in order) and one column per vertex data field. The view queries the
+ * mapped sections in place, opening a file costs O(1) independent of the graph size and the pages are shared with
+ * the page cache instead of being copied into Graph objects.
+ *
+ * @file MappedGraph.h
+ * @brief Declarations for the MappedGraph
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "IndexPersistentVector.h"
+#include "MappedFile.h"
+
+namespace graphs {
+
+namespace detail {
+template<typename Tuple>
+struct is_mappable;
+
+template<typename... T>
+struct is_mappable<std::tuple<T...>> : std::bool_constant<(std::is_trivially_copyable_v<T> && ...)> {};
+}
+
+template<typename Graph>
+class MappedGraph {
+    using Vertex = typename Graph::VertexList::value_type;
+    using Fields = typename Vertex::data_type;
+
+    static_assert(detail::is_mappable<Fields>::value, "Mapped graphs require trivially copyable vertex data");
+
+public:
+    using PersistentVertexIndex = PersistentIndex;
+    using data_type = std::decay_t<decltype(std::declval<const Vertex &>().data())>;
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * Contiguous range of the neighbors of a vertex, pointing into the mapped file.
+     */
+    struct NeighborRange {
+        const PersistentVertexIndex *first;
+        const PersistentVertexIndex *last;
+
+        const PersistentVertexIndex *begin() const { return first; }
+
+        const PersistentVertexIndex *end() const { return last; }
+
+        [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(last - first); }
+
+        [[nodiscard]] bool empty() const { return first == last; }
+    };
+
+    /**
+     * Writes a graph in the mappable layout. Persistent indices are kept, blanks become inactive slots without
+     * neighbors.
+     * @param graph the graph
+     * @param os the output stream, opened in binary mode
+     * @throws std::runtime_error if writing to the stream fails
+     */
+    static void write(const Graph &graph, std::ostream &os);
+
+    /**
+     * Maps a file written by write() into memory. Only the header and the bounds of the sections are validated, so
+     * that opening stays O(1); offsets and indices read from the sections are checked where they are used.
+     * @param path path to the file
+     * @throws std::system_error if the file cannot be opened or mapped
+     * @throws std::runtime_error if the file is not a mappable graph of this vertex data layout
+     */
+    explicit MappedGraph(const std::string &path);
+
+    /**
+     * Creates a view on a graph in the mappable layout which is already in memory. The memory is not owned, it must
+     * be aligned like std::max_align_t and outlive the view.
+     * @param data the memory
+     * @param size its size in bytes
+     * @throws std::runtime_error if the memory does not contain a mappable graph of this vertex data layout
+     */
+    MappedGraph(const void *data, std::size_t size);
+
+    MappedGraph(const MappedGraph &) = delete;
+
+    MappedGraph &operator=(const MappedGraph &) = delete;
+
+    MappedGraph(MappedGraph &&) noexcept = default;
+
+    MappedGraph &operator=(MappedGraph &&) noexcept = default;
+
+    /**
+     * @return the number of vertex slots, including inactive ones
+     */
+    [[nodiscard]] std::size_t size_persistent() const;
+
+    /**
+     * @return the number of active vertices
+     */
+    [[nodiscard]] std::size_t nVertices() const;
+
+    [[nodiscard]] std::size_t nEdges() const;
+
+    /**
+     * @param ix the persistent index
+     * @return whether the slot holds an active vertex
+     */
+    [[nodiscard]] bool active(PersistentVertexIndex ix) const;
+
+    /**
+     * Maps an active vertex index (0, ..., nVertices() - 1) to its persistent index.
+     * @param activeIndex the active index
+     * @return the persistent index
+     */
+    [[nodiscard]] PersistentVertexIndex persistentIndex(std::size_t activeIndex) const;
+
+    /**
+     * @param ix the persistent index
+     * @return the neighbors of the vertex, empty for inactive slots
+     * @throws std::out_of_range if the index is not a slot
+     * @throws std::runtime_error if the neighbor offsets of the slot are corrupt
+     */
+    NeighborRange neighbors(PersistentVertexIndex ix) const;
+
+    /**
+     * @param ix the persistent index
+     * @return the data of the vertex, a reference into the mapped file for single field data, a tuple otherwise
+     */
+    decltype(auto) data(PersistentVertexIndex ix) const;
+
+    /**
+     * Finds the shortest distance between two vertices, see Graph::graphDistance().
+     * @return the distance or -1 if there is no path
+     */
+    std::int32_t graphDistance(PersistentVertexIndex source, PersistentVertexIndex target) const;
+
+    /**
+     * Labels the connected components, labels are numbered consecutively in order of the smallest persistent index
+     * per component.
+     * @return the label of every vertex slot, npos for inactive slots
+     */
+    std::vector<std::size_t> componentLabels() const;
+
+private:
+    template<std::size_t I>
+    const std::tuple_element_t<I, Fields> *column() const;
+
+    void attach(const void *data, std::size_t size);
+
+    /**
+     * @return the index if it is a slot
+     * @throws std::runtime_error otherwise, it was read from a corrupt section
+     */
+    PersistentVertexIndex checked(PersistentVertexIndex ix) const;
+
+    // the mapping if the view was opened from a file, the sections point into it
+    MappedFile _file {};
+
+    std::size_t _nSlots {0};
+    std::size_t _nVertices {0};
+    std::size_t _nEdges {0};
+    std::size_t _nNeighbors {0};
+    const std::uint64_t *_offsets {nullptr};
+    const PersistentVertexIndex *_neighbors {nullptr};
+    const std::uint8_t *_active {nullptr};
+    const PersistentVertexIndex *_activeIndices {nullptr};
+    std::vector<const unsigned char *> _columns {};
+};
+
+}
+
+#include "bits/MappedGraph_detail.h"
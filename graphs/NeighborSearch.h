@@ -0,0 +1,73 @@
+/**
+ * Linear search over contiguous arrays of persistent indices, i.e., neighbor lists and edge lists. On x86-64 the
+ * kernels compare 16 (SSE2) or 32 (AVX2) bytes per instruction, the instruction set is detected once at runtime.
+ * Elsewhere, or if GRAPHS_NO_SIMD is defined, the search is std::find. Vertices use the kernels for the duplicate
+ * check in addNeighbor and for removeNeighbor, the graph for containsEdge, removeEdge and removeVertex.
+ *
+ * @file NeighborSearch.h
+ * @brief Declarations for the vectorized neighbor and edge search
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace graphs {
+
+/**
+ * Instruction set of the search kernels, ordered by width.
+ */
+enum class SimdLevel {
+    scalar,
+    sse2,
+    avx2
+};
+
+/**
+ * @return the widest instruction set supported by the CPU, determined on first use
+ */
+SimdLevel simdLevel();
+
+/**
+ * @param level an instruction set
+ * @return whether the kernels for the instruction set were compiled in and the CPU supports them
+ */
+bool simdSupported(SimdLevel level);
+
+/**
+ * Finds the first occurrence of an index in a contiguous range, like std::find.
+ * @tparam Index a BasicPersistentIndex
+ * @param first begin of the range
+ * @param last end of the range
+ * @param value the index to look for
+ * @param level the instruction set, must be supported (see simdSupported)
+ * @return pointer to the first occurrence or last
+ */
+template<typename Index>
+const Index *findIndex(const Index *first, const Index *last, Index value, SimdLevel level = simdLevel());
+
+/**
+ * Finds the first edge between two vertices in a contiguous range of edges, in either orientation.
+ * @tparam Index a BasicPersistentIndex
+ * @tparam Edge a tuple of two indices
+ * @param first begin of the range
+ * @param last end of the range
+ * @param ix1 the first vertex
+ * @param ix2 the second vertex
+ * @param level the instruction set, must be supported (see simdSupported)
+ * @return pointer to the first edge (ix1, ix2) or (ix2, ix1), last if there is none
+ */
+template<typename Edge, typename Index>
+const Edge *findEdge(const Edge *first, const Edge *last, Index ix1, Index ix2, SimdLevel level = simdLevel());
+
+/**
+ * Finds the first edge incident to a vertex in a contiguous range of edges.
+ * @return pointer to the first edge with ix as one of its ends, last if there is none
+ */
+template<typename Edge, typename Index>
+const Edge *findIncidentEdge(const Edge *first, const Edge *last, Index ix, SimdLevel level = simdLevel());
+
+}
+
+#include "bits/NeighborSearch_detail.h"
@@ -0,0 +1,104 @@
+/**
+ * Vertex without virtual functions and padding: the neighbor list is a pointer with 32-bit size and capacity, and the
+ * deactivated flag is stored in the otherwise unused top bit of the capacity. Vertices with trivially copyable data
+ * are trivially relocatable, a RelocatingVector moves them with memcpy when it grows.
+ *
+ * @file PackedVertex.h
+ * @brief Declarations for the packed vertex
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <tuple>
+
+#include <fmt/format.h>
+#include "IndexPersistentVector.h"
+#include "RelocatingVector.h"
+
+namespace graphs {
+
+namespace detail {
+template<typename Index>
+class PackedNeighborList;
+}
+
+/**
+ * Packed vertex, see PackedVertex.h. Offers the interface of BasicVertex.
+ * @tparam Index the persistent index type of the neighbors
+ * @tparam T the data types
+ */
+template<typename Index, typename... T>
+class BasicPackedVertex {
+public:
+    using data_type = std::tuple<T...>;
+    using NeighborList = detail::PackedNeighborList<Index>;
+    using index_type = Index;
+    using size_type = std::size_t;
+
+    BasicPackedVertex(T&&... data);
+
+    BasicPackedVertex(data_type data);
+
+    BasicPackedVertex(const BasicPackedVertex &other);
+
+    BasicPackedVertex &operator=(const BasicPackedVertex &rhs);
+
+    BasicPackedVertex(BasicPackedVertex &&other) noexcept;
+
+    BasicPackedVertex &operator=(BasicPackedVertex &&rhs) noexcept;
+
+    ~BasicPackedVertex() = default;
+
+    const NeighborList &neighbors() const;
+
+    NeighborList &neighbors();
+
+    void addNeighbor(Index neighbor);
+
+    void removeNeighbor(Index neighbor);
+
+    const auto &data() const;
+
+    void setData(data_type data);
+
+    void deactivate();
+
+    bool deactivated() const;
+
+    auto operator->() {
+        return &std::get<0>(_data);
+    }
+
+    auto operator->() const {
+        return &std::get<0>(_data);
+    }
+
+private:
+    NeighborList _neighbors{};
+    data_type _data;
+};
+
+/**
+ * Packed vertex with 64-bit persistent indices.
+ */
+template<typename... T>
+using PackedVertex = BasicPackedVertex<PersistentIndex, T...>;
+
+/**
+ * Packed vertex with 32-bit persistent indices.
+ */
+template<typename... T>
+using PackedVertex32 = BasicPackedVertex<PersistentIndex32, T...>;
+
+}
+
+#include "bits/PackedVertex_detail.h"
+
+namespace graphs {
+static_assert(sizeof(PackedVertex<std::size_t>) == sizeof(void *) + 2 * sizeof(std::uint32_t) + sizeof(std::size_t),
+              "A packed vertex consists of its neighbor list and its data");
+static_assert(detail::is_trivially_relocatable_v<PackedVertex<std::size_t>>);
+}
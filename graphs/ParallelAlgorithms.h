@@ -0,0 +1,54 @@
+/**
+ * Batch entry points which run graph algorithms on many independent graphs using a ThreadPool. Graphs are scheduled
+ * by decreasing size (number of vertices and edges) for load balancing, results are returned in the order of the
+ * input range regardless of the schedule.
+ *
+ * @file ParallelAlgorithms.h
+ * @brief Declarations for the parallel batch algorithms
+ */
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace graphs::parallel {
+
+/**
+ * Applies a function to every graph of a range in parallel.
+ * @param pool the thread pool
+ * @param first begin of the graph range (random access)
+ * @param last end of the graph range
+ * @param function function taking a const reference to a graph
+ * @return the results, results[i] belongs to first[i]
+ */
+template<typename RandomIt, typename Function>
+auto transform(ThreadPool &pool, RandomIt first, RandomIt last, const Function &function);
+
+/**
+ * Graph::isConnected() for every graph of a range.
+ * @return connectedness in the order of the range
+ */
+template<typename RandomIt>
+std::vector<bool> isConnected(ThreadPool &pool, RandomIt first, RandomIt last);
+
+/**
+ * Graph::connectedComponents() for every graph of a range.
+ * @return the components in the order of the range
+ */
+template<typename RandomIt>
+auto connectedComponents(ThreadPool &pool, RandomIt first, RandomIt last);
+
+/**
+ * Graph::findNTuples() for every graph of a range.
+ * @return the pairs, triples and quadruples in the order of the range
+ */
+template<typename RandomIt>
+auto findNTuples(ThreadPool &pool, RandomIt first, RandomIt last);
+
+}
+
+#include "bits/ParallelAlgorithms_detail.h"
@@ -0,0 +1,131 @@
+/**
+ * Single writer, many readers publication of graph versions. The writer mutates a private working copy and publishes
+ * immutable snapshots of it, readers pin the currently published version without taking a lock. Retired versions
+ * are reclaimed once no reader can still see them (epoch-based reclamation).
+ *
+ * @file PublishedGraph.h
+ * @brief Declarations for the PublishedGraph
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <tuple>
+
+namespace graphs {
+
+template<typename Graph>
+class PublishedGraph {
+    struct Version {
+        Graph graph;
+        std::uint64_t number;
+    };
+
+    struct alignas(64) ReaderSlot {
+        // epoch in which the reader pinned the published version, 0 if the slot is free
+        std::atomic<std::uint64_t> epoch {0};
+    };
+
+public:
+    /**
+     * Handle to a pinned, immutable version of the graph. The version stays valid as long as the handle lives.
+     * Handles must not outlive the PublishedGraph.
+     */
+    class ReadHandle {
+    public:
+        ReadHandle(const ReadHandle &) = delete;
+
+        ReadHandle &operator=(const ReadHandle &) = delete;
+
+        ReadHandle(ReadHandle &&other) noexcept;
+
+        ReadHandle &operator=(ReadHandle &&rhs) noexcept;
+
+        ~ReadHandle();
+
+        const Graph &operator*() const;
+
+        const Graph *operator->() const;
+
+        /**
+         * @return the number of the pinned version, increasing with every publish()
+         */
+        std::uint64_t version() const;
+
+    private:
+        friend class PublishedGraph;
+
+        ReadHandle(ReaderSlot *slot, const Version *version);
+
+        void release();
+
+        ReaderSlot *_slot;
+        const Version *_version;
+    };
+
+    /**
+     * Creates a published graph, the initial graph is published as version 0.
+     * @param graph the initial graph
+     * @param nReaderSlots maximum number of concurrently pinned versions, further readers spin until a slot is free
+     */
+    explicit PublishedGraph(Graph graph = {}, std::size_t nReaderSlots = defaultReaderSlots());
+
+    ~PublishedGraph();
+
+    PublishedGraph(const PublishedGraph &) = delete;
+
+    PublishedGraph &operator=(const PublishedGraph &) = delete;
+
+    PublishedGraph(PublishedGraph &&) = delete;
+
+    PublishedGraph &operator=(PublishedGraph &&) = delete;
+
+    /**
+     * Pins the currently published version. Lock-free, can be called from any number of threads.
+     * @return handle to the pinned version
+     */
+    ReadHandle read() const;
+
+    /**
+     * The writer's working copy. Must only be accessed from the (single) writer thread.
+     * @return reference to the working copy
+     */
+    Graph &writer();
+
+    /**
+     * Publishes a snapshot of the working copy (see Graph::snapshot(), O(#chunks) for copy-on-write graphs) and
+     * reclaims versions which are no longer visible. Must only be called from the writer thread.
+     * @return the number of the published version
+     */
+    std::uint64_t publish();
+
+    /**
+     * Frees all retired versions which no reader can still see. Must only be called from the writer thread.
+     * @return the number of retired versions which are still pinned by readers
+     */
+    std::size_t reclaim();
+
+    /**
+     * @return the number of retired versions which are not yet freed
+     */
+    std::size_t nRetired() const;
+
+private:
+    static std::size_t defaultReaderSlots();
+
+    Graph _writer;
+    std::atomic<const Version *> _current;
+    std::atomic<std::uint64_t> _epoch {1};
+    std::size_t _nSlots;
+    std::unique_ptr<ReaderSlot[]> _slots;
+    // retired versions together with the epoch in which they were unpublished
+    std::vector<std::tuple<std::unique_ptr<const Version>, std::uint64_t>> _retired {};
+};
+
+}
+
+#include "bits/PublishedGraph_detail.h"
@@ -0,0 +1,21 @@
+/**
+ * Backing vector for the IndexPersistentContainer which relocates trivially relocatable elements, e.g., PackedVertex,
+ * with memcpy when it grows.
+ *
+ * @file RelocatingVector.h
+ * @brief Declarations for the trivially relocating vector
+ */
+
+#pragma once
+
+#include "bits/RelocatingVector_detail.h"
+
+namespace graphs {
+
+/**
+ * TriviallyRelocatingVector for types which opted into detail::is_trivially_relocatable, std::vector otherwise.
+ */
+template<typename T>
+using RelocatingVector = typename detail::relocating_vector<T>::type;
+
+}
@@ -0,0 +1,268 @@
+/**
+ * Building blocks of the binary graph format (see Graph::write() and Graph::read()): buffered little-endian writers and
+ * readers on top of std::ostream / std::istream and the Serializer customization point for vertex data. Arithmetic
+ * types are stored little-endian, other trivially copyable types byte-wise, strings and vectors with a length prefix.
+ * Specialize Serializer for other data types.
+ *
+ * @file Serialization.h
+ * @brief Binary serialization helpers
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graphs {
+
+namespace detail {
+inline constexpr bool littleEndianHost() {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return false;
+#else
+    return true;
+#endif
+}
+
+template<typename T>
+T byteSwap(T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T) / 2; ++i) {
+        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    }
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+template<typename T, typename = void>
+struct is_bulk_serializable : std::false_type {};
+
+template<typename T>
+struct is_bulk_serializable<T, std::void_t<decltype(T::bulk)>> : std::bool_constant<T::bulk> {};
+
+/**
+ * whether values of type T are stored as their in-memory bytes, i.e., arrays of them can be copied in bulk
+ */
+template<typename T>
+inline constexpr bool bulk_copyable_v = std::is_trivially_copyable_v<T> &&
+                                        (littleEndianHost() || sizeof(T) == 1 || !std::is_arithmetic_v<T>);
+}
+
+/**
+ * Buffered writer of little-endian binary data.
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream &os, std::size_t bufferSize = 1 << 20) : _os(os) {
+        _buffer.reserve(bufferSize);
+    }
+
+    BinaryWriter(const BinaryWriter &) = delete;
+
+    BinaryWriter &operator=(const BinaryWriter &) = delete;
+
+    void writeBytes(const void *data, std::size_t n) {
+        if (n == 0) {
+            return;
+        }
+        if (_buffer.size() + n > _buffer.capacity()) {
+            flush();
+            if (n > _buffer.capacity()) {
+                _os.write(static_cast<const char *>(data), static_cast<std::streamsize>(n));
+                return;
+            }
+        }
+        auto bytes = static_cast<const char *>(data);
+        _buffer.insert(_buffer.end(), bytes, bytes + n);
+    }
+
+    template<typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if constexpr (std::is_arithmetic_v<T> && !detail::littleEndianHost()) {
+            value = detail::byteSwap(value);
+        }
+        writeBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void writeArray(const T *data, std::size_t n) {
+        if constexpr (detail::bulk_copyable_v<T>) {
+            writeBytes(data, n * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                write(data[i]);
+            }
+        }
+    }
+
+    /**
+     * Writes the buffered data to the stream.
+     * @throws std::runtime_error if the stream is in a failed state
+     */
+    void flush() {
+        _os.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+        if (!_os) {
+            throw std::runtime_error("Failed to write graph data to the stream.");
+        }
+    }
+
+private:
+    std::ostream &_os;
+    std::vector<char> _buffer;
+};
+
+/**
+ * Buffered reader of little-endian binary data.
+ */
+class BinaryReader {
+public:
+    explicit BinaryReader(std::istream &is, std::size_t bufferSize = 1 << 20) : _is(is), _buffer(bufferSize) {}
+
+    BinaryReader(const BinaryReader &) = delete;
+
+    BinaryReader &operator=(const BinaryReader &) = delete;
+
+    /**
+     * @throws std::runtime_error if the stream ends early
+     */
+    void readBytes(void *data, std::size_t n) {
+        if (n == 0) {
+            return;
+        }
+        auto out = static_cast<char *>(data);
+        auto available = _end - _position;
+        if (n <= available) {
+            std::memcpy(out, _buffer.data() + _position, n);
+            _position += n;
+            return;
+        }
+        std::memcpy(out, _buffer.data() + _position, available);
+        out += available;
+        n -= available;
+        _position = _end = 0;
+        if (n >= _buffer.size()) {
+            _is.read(out, static_cast<std::streamsize>(n));
+            if (static_cast<std::size_t>(_is.gcount()) != n) {
+                throw std::runtime_error("Unexpected end of graph data.");
+            }
+            return;
+        }
+        _is.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _end = static_cast<std::size_t>(_is.gcount());
+        if (_end < n) {
+            throw std::runtime_error("Unexpected end of graph data.");
+        }
+        std::memcpy(out, _buffer.data(), n);
+        _position = n;
+    }
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        readBytes(&value, sizeof(T));
+        if constexpr (std::is_arithmetic_v<T> && !detail::littleEndianHost()) {
+            value = detail::byteSwap(value);
+        }
+        return value;
+    }
+
+    template<typename T>
+    void readArray(T *data, std::size_t n) {
+        if constexpr (detail::bulk_copyable_v<T>) {
+            readBytes(data, n * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                data[i] = read<T>();
+            }
+        }
+    }
+
+    /**
+     * Hands the data which was read ahead but not consumed back to the stream, so that it can be read further.
+     */
+    void release() {
+        if (_position < _end) {
+            _is.clear();
+            _is.seekg(-static_cast<std::streamoff>(_end - _position), std::ios_base::cur);
+        }
+        _position = _end = 0;
+    }
+
+private:
+    std::istream &_is;
+    std::vector<char> _buffer;
+    std::size_t _position {0};
+    std::size_t _end {0};
+};
+
+/**
+ * Customization point for the serialization of vertex data. Specializations provide static write(BinaryWriter&,
+ * const T&) and read(BinaryReader&, T&). The default handles trivially copyable types and is marked as `bulk`, i.e.,
+ * arrays of values are copied as a whole.
+ * @tparam T the data type
+ */
+template<typename T, typename = void>
+struct Serializer {
+    static_assert(std::is_trivially_copyable_v<T>, "Specialize graphs::Serializer for non-trivially copyable data");
+
+    static constexpr bool bulk = true;
+
+    static void write(BinaryWriter &writer, const T &value) {
+        writer.write(value);
+    }
+
+    static void read(BinaryReader &reader, T &value) {
+        value = reader.read<T>();
+    }
+};
+
+namespace detail {
+/**
+ * whether arrays of T are written and read through BinaryWriter::writeArray / BinaryReader::readArray
+ */
+template<typename T>
+inline constexpr bool bulk_serializable_v = is_bulk_serializable<Serializer<T>>::value;
+}
+
+template<typename Char, typename Traits, typename Allocator>
+struct Serializer<std::basic_string<Char, Traits, Allocator>> {
+    static void write(BinaryWriter &writer, const std::basic_string<Char, Traits, Allocator> &value) {
+        writer.write(static_cast<std::uint64_t>(value.size()));
+        writer.writeArray(value.data(), value.size());
+    }
+
+    static void read(BinaryReader &reader, std::basic_string<Char, Traits, Allocator> &value) {
+        value.resize(reader.read<std::uint64_t>());
+        reader.readArray(value.data(), value.size());
+    }
+};
+
+template<typename T, typename Allocator>
+struct Serializer<std::vector<T, Allocator>> {
+    static void write(BinaryWriter &writer, const std::vector<T, Allocator> &value) {
+        writer.write(static_cast<std::uint64_t>(value.size()));
+        for (const auto &x : value) {
+            Serializer<T>::write(writer, x);
+        }
+    }
+
+    static void read(BinaryReader &reader, std::vector<T, Allocator> &value) {
+        value.resize(reader.read<std::uint64_t>());
+        for (auto &x : value) {
+            Serializer<T>::read(reader, x);
+        }
+    }
+};
+
+}
@@ -0,0 +1,28 @@
+/**
+ * Columnar backing vector for the IndexPersistentContainer: vertices are stored as one column per data field, a
+ * column of neighbor lists and a bitmap of active vertices, so that scanning one field or only the topology touches
+ * nothing else. Element access goes through proxies with the interface of the vertex.
+ *
+ * @file SoaVector.h
+ * @brief Declarations for the columnar vertex storage
+ */
+
+#pragma once
+
+#include "bits/SoaVector_detail.h"
+
+namespace graphs {
+
+/**
+ * Non-owning view of a column.
+ */
+template<typename T>
+using Span = detail::Span<T>;
+
+/**
+ * Columnar storage if T is a vertex, std::vector otherwise.
+ */
+template<typename T>
+using SoaVector = typename detail::soa_vector<T>::type;
+
+}
@@ -0,0 +1,83 @@
+/**
+ * Fixed-size work-stealing thread pool for running batches of independent tasks. Each worker owns a queue which it
+ * processes from the front, idle workers steal from the back of the other queues.
+ *
+ * @file ThreadPool.h
+ * @brief Declarations for the ThreadPool
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graphs {
+
+class ThreadPool {
+public:
+    /**
+     * Creates a pool. The calling thread of run() takes part in the work, so nThreads - 1 workers are started.
+     * @param nThreads number of threads working on a batch
+     */
+    explicit ThreadPool(std::size_t nThreads = defaultThreads());
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ThreadPool(ThreadPool &&) = delete;
+
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+    /**
+     * @return the number of threads working on a batch, including the calling thread
+     */
+    [[nodiscard]] std::size_t nThreads() const;
+
+    /**
+     * Calls task(i) for all i in `order` and blocks until all calls returned. The tasks are dealt out round-robin in
+     * the given order, so ordering them by decreasing cost balances the load (longest processing time first). The
+     * first exception thrown by a task is rethrown after the batch finished. Must not be called from within a task.
+     * @param order the task indices
+     * @param task the task
+     */
+    void run(const std::vector<std::size_t> &order, const std::function<void(std::size_t)> &task);
+
+    static std::size_t defaultThreads();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> items;
+    };
+
+    void work(std::size_t self);
+
+    bool pop(std::size_t self, std::size_t &item);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers {};
+
+    std::mutex _runMutex {};
+    std::mutex _mutex {};
+    std::condition_variable _wake {};
+    std::condition_variable _done {};
+    const std::function<void(std::size_t)> *_task {nullptr};
+    std::uint64_t _generation {0};
+    std::size_t _nBusy {0};
+    bool _stop {false};
+    std::exception_ptr _error {};
+};
+
+}
+
+#include "bits/ThreadPool_detail.h"
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <list>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
 #include <vector>
 #include <sstream>
@@ -14,37 +16,88 @@
 
 namespace graphs {
 
-template<typename... T>
-class Vertex {
+/**
+ * Vertex traits with neighbor lists allocated through std::allocator.
+ */
+struct DefaultVertexTraits {
+    using NeighborList = std::vector<PersistentIndex>;
+};
+
+/**
+ * Vertex traits with neighbor lists allocated through std::pmr::polymorphic_allocator, so that vertices stored in a
+ * pmr container (see PmrIndexPersistentVector) allocate their neighbors from the same memory resource.
+ */
+struct PmrVertexTraits {
+    using NeighborList = std::pmr::vector<PersistentIndex>;
+};
+
+/**
+ * Vertex traits with 32-bit persistent indices, halving the memory of neighbor lists and edges for graphs with less
+ * than 2^32 vertex slots.
+ */
+struct Index32VertexTraits {
+    using NeighborList = std::vector<PersistentIndex32>;
+};
+
+/**
+ * Vertex traits with neighbor lists kept sorted by index. Adding and removing a neighbor bisects instead of scanning
+ * the list, and the graph can intersect neighborhoods by a linear merge (see Graph::commonNeighbors).
+ */
+struct SortedVertexTraits {
+    using NeighborList = std::vector<PersistentIndex>;
+    static constexpr bool sorted_neighbors = true;
+};
+
+/**
+ * Vertex whose representation is configured by traits. Vertices are allocator-aware (std::uses_allocator), the
+ * allocator is used for the neighbor list, the data is constructed as is.
+ * @tparam Traits the traits, see DefaultVertexTraits
+ * @tparam T the data types
+ */
+template<typename Traits, typename... T>
+class BasicVertex {
 public:
     using data_type = std::tuple<T...>;
-    using NeighborList = std::vector<PersistentIndex>;
-    using size_type = typename std::vector<Vertex<T...>>::size_type;
+    using NeighborList = typename Traits::NeighborList;
+    using index_type = typename NeighborList::value_type;
+    using allocator_type = typename NeighborList::allocator_type;
+    using size_type = std::size_t;
+
+    // whether the neighbor list is kept sorted, see SortedVertexTraits
+    static constexpr bool sorted_neighbors = detail::sorted_neighbors_v<Traits>;
+
+    BasicVertex(T&&... data);
+
+    BasicVertex(data_type data);
+
+    BasicVertex(std::allocator_arg_t, const allocator_type &allocator);
 
-    Vertex(T&&... data);
+    BasicVertex(std::allocator_arg_t, const allocator_type &allocator, data_type data);
 
-    Vertex(data_type data);
+    BasicVertex(const BasicVertex &);
 
-    Vertex(const Vertex &);
+    BasicVertex(std::allocator_arg_t, const allocator_type &allocator, const BasicVertex &other);
 
-    Vertex &operator=(const Vertex &);
+    BasicVertex &operator=(const BasicVertex &);
 
-    Vertex(Vertex && other) noexcept;
+    BasicVertex(BasicVertex && other) noexcept;
 
-    Vertex &operator=(Vertex && rhs) noexcept;
+    BasicVertex(std::allocator_arg_t, const allocator_type &allocator, BasicVertex &&other);
 
-    virtual ~Vertex();
+    BasicVertex &operator=(BasicVertex && rhs) noexcept;
 
-    template<typename... T2>
-    friend std::ostream &operator<<(std::ostream &os, const Vertex<T2...> &vertex);
+    virtual ~BasicVertex();
+
+    template<typename Traits2, typename... T2>
+    friend std::ostream &operator<<(std::ostream &os, const BasicVertex<Traits2, T2...> &vertex);
 
     const NeighborList &neighbors() const;
 
     NeighborList &neighbors();
 
-    void addNeighbor(NeighborList::value_type neighbor);
+    void addNeighbor(typename NeighborList::value_type neighbor);
 
-    void removeNeighbor(NeighborList::value_type neighbor);
+    void removeNeighbor(typename NeighborList::value_type neighbor);
 
     const auto &data() const;
 
@@ -54,6 +107,8 @@ public:
 
     bool deactivated() const;
 
+    allocator_type get_allocator() const;
+
     auto operator->() {
         return &std::get<0>(_data);
     }
@@ -68,6 +123,36 @@ private:
     bool _deactivated {false};
 };
 
+template<typename... T>
+class Vertex : public BasicVertex<DefaultVertexTraits, T...> {
+public:
+    using BasicVertex<DefaultVertexTraits, T...>::BasicVertex;
+};
+
+template<typename... T>
+Vertex(T...) -> Vertex<T...>;
+
+template<typename... T>
+Vertex(std::tuple<T...>) -> Vertex<T...>;
+
+/**
+ * Vertex allocating its neighbors through std::pmr::polymorphic_allocator.
+ */
+template<typename... T>
+using PmrVertex = BasicVertex<PmrVertexTraits, T...>;
+
+/**
+ * Vertex referring to its neighbors by 32-bit persistent indices.
+ */
+template<typename... T>
+using Vertex32 = BasicVertex<Index32VertexTraits, T...>;
+
+/**
+ * Vertex keeping its neighbors sorted by index.
+ */
+template<typename... T>
+using SortedVertex = BasicVertex<SortedVertexTraits, T...>;
+
 }
 
 #include "bits/Vertex_detail.h"
@@ -0,0 +1,295 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../BoundedVertex.h"
+
+namespace graphs {
+
+namespace detail {
+
+/**
+ * Smallest unsigned integer type which can count up to N.
+ */
+template<std::size_t N>
+using inline_count_t = std::conditional_t<N <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+        std::conditional_t<N <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t, std::uint32_t>>;
+
+/**
+ * Vector of at most N neighbor indices stored inline. Besides the count it holds a flag owned by the vertex (its
+ * deactivated state), which is neither copied nor moved along with the elements.
+ * @tparam Index the persistent index type
+ * @tparam N the capacity
+ */
+template<typename Index, std::size_t N>
+class InlineNeighborList {
+    static_assert(std::is_trivially_copyable_v<Index>);
+    using count_type = inline_count_t<N>;
+public:
+    using value_type = Index;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = Index &;
+    using const_reference = const Index &;
+    using iterator = Index *;
+    using const_iterator = const Index *;
+
+    InlineNeighborList() noexcept = default;
+
+    InlineNeighborList(const InlineNeighborList &other) noexcept : _data(other._data), _size(other._size) {}
+
+    InlineNeighborList &operator=(const InlineNeighborList &rhs) noexcept {
+        _data = rhs._data;
+        _size = rhs._size;
+        return *this;
+    }
+
+    /**
+     * Swaps the elements, the flags stay with their lists.
+     */
+    void swap(InlineNeighborList &other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+
+    iterator begin() noexcept { return _data.data(); }
+
+    iterator end() noexcept { return _data.data() + _size; }
+
+    const_iterator begin() const noexcept { return _data.data(); }
+
+    const_iterator end() const noexcept { return _data.data() + _size; }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] size_type size() const noexcept { return _size; }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return N; }
+
+    [[nodiscard]] static constexpr size_type max_size() noexcept { return N; }
+
+    [[nodiscard]] bool full() const noexcept { return _size == N; }
+
+    Index *data() noexcept { return _data.data(); }
+
+    const Index *data() const noexcept { return _data.data(); }
+
+    Index &operator[](size_type index) { return _data[index]; }
+
+    const Index &operator[](size_type index) const { return _data[index]; }
+
+    Index &front() { return _data[0]; }
+
+    const Index &front() const { return _data[0]; }
+
+    Index &back() { return _data[_size - 1]; }
+
+    const Index &back() const { return _data[_size - 1]; }
+
+    void reserve(size_type n) {
+        checkSize(n);
+    }
+
+    void shrink_to_fit() noexcept {}
+
+    void resize(size_type n, Index value = {}) {
+        checkSize(n);
+        if (n > _size) {
+            std::fill(end(), begin() + n, value);
+        }
+        _size = static_cast<count_type>(n);
+    }
+
+    void clear() noexcept {
+        _size = 0;
+    }
+
+    void push_back(Index value) {
+        checkSize(_size + 1u);
+        _data[_size++] = value;
+    }
+
+    Index &emplace_back(Index value) {
+        push_back(value);
+        return back();
+    }
+
+    void pop_back() {
+        --_size;
+    }
+
+    iterator insert(const_iterator pos, Index value) {
+        auto offset = pos - begin();
+        push_back(value);
+        std::rotate(begin() + offset, end() - 1, end());
+        return begin() + offset;
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        auto offset = first - begin();
+        auto it = std::copy(begin() + (last - begin()), end(), begin() + offset);
+        _size = static_cast<count_type>(it - begin());
+        return begin() + offset;
+    }
+
+    bool operator==(const InlineNeighborList &rhs) const {
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    bool operator!=(const InlineNeighborList &rhs) const {
+        return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool flagged() const noexcept {
+        return _flag;
+    }
+
+    void setFlag(bool flag) noexcept {
+        _flag = flag;
+    }
+
+private:
+    static void checkSize(size_type n) {
+        if (n > N) {
+            throw std::length_error(fmt::format("A bounded vertex has at most {} neighbors.", N));
+        }
+    }
+
+    std::array<Index, N> _data {};
+    count_type _size {0};
+    bool _flag {false};
+};
+
+/**
+ * A bounded vertex holds no pointers, it can be relocated by copying its bytes if its data can.
+ */
+template<std::size_t MaxDegree, typename Index, typename... T>
+struct is_trivially_relocatable<BasicBoundedVertex<MaxDegree, Index, T...>>
+        : std::bool_constant<(std::is_trivially_copyable_v<T> && ...)> {
+};
+
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline BasicBoundedVertex<MaxDegree, Index, T...>::BasicBoundedVertex(T&&... data)
+        : _data(std::tuple<T...>(std::forward<T>(data)...)) {}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline BasicBoundedVertex<MaxDegree, Index, T...>::BasicBoundedVertex(data_type data) : _data(std::move(data)) {}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline BasicBoundedVertex<MaxDegree, Index, T...>::BasicBoundedVertex(const BasicBoundedVertex &other)
+        : _neighbors(other._neighbors), _data(other._data) {
+    _neighbors.setFlag(other._neighbors.flagged());
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline BasicBoundedVertex<MaxDegree, Index, T...> &BasicBoundedVertex<MaxDegree, Index, T...>::operator=(
+        const BasicBoundedVertex &rhs) {
+    _neighbors = rhs._neighbors;
+    _neighbors.setFlag(rhs._neighbors.flagged());
+    _data = rhs._data;
+    return *this;
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline BasicBoundedVertex<MaxDegree, Index, T...>::BasicBoundedVertex(BasicBoundedVertex &&other) noexcept
+        : _neighbors(other._neighbors), _data(std::move(other._data)) {
+    _neighbors.setFlag(other._neighbors.flagged());
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline BasicBoundedVertex<MaxDegree, Index, T...> &BasicBoundedVertex<MaxDegree, Index, T...>::operator=(
+        BasicBoundedVertex &&rhs) noexcept {
+    _neighbors = rhs._neighbors;
+    _neighbors.setFlag(rhs._neighbors.flagged());
+    _data = std::move(rhs._data);
+    return *this;
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline const typename BasicBoundedVertex<MaxDegree, Index, T...>::NeighborList &
+BasicBoundedVertex<MaxDegree, Index, T...>::neighbors() const {
+    return _neighbors;
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline typename BasicBoundedVertex<MaxDegree, Index, T...>::NeighborList &
+BasicBoundedVertex<MaxDegree, Index, T...>::neighbors() {
+    return _neighbors;
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline void BasicBoundedVertex<MaxDegree, Index, T...>::addNeighbor(Index neighbor) {
+    detail::insertNeighbor<false>(_neighbors, neighbor);
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline void BasicBoundedVertex<MaxDegree, Index, T...>::removeNeighbor(Index neighbor) {
+    detail::eraseNeighbor<false>(_neighbors, neighbor);
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline const auto &BasicBoundedVertex<MaxDegree, Index, T...>::data() const {
+    if constexpr (std::tuple_size_v<data_type> == 1) {
+        return std::get<0>(_data);
+    } else {
+        return _data;
+    }
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline void BasicBoundedVertex<MaxDegree, Index, T...>::setData(data_type data) {
+    _data = std::move(data);
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline void BasicBoundedVertex<MaxDegree, Index, T...>::deactivate() {
+    _neighbors.setFlag(true);
+}
+
+template<std::size_t MaxDegree, typename Index, typename... T>
+inline bool BasicBoundedVertex<MaxDegree, Index, T...>::deactivated() const {
+    return _neighbors.flagged();
+}
+
+}
+
+namespace fmt {
+template<std::size_t MaxDegree, typename Index, typename... T>
+struct formatter<graphs::BasicBoundedVertex<MaxDegree, Index, T...>> {
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext &ctx) { return ctx.begin(); }
+
+    template <typename FormatContext>
+    auto format(const graphs::BasicBoundedVertex<MaxDegree, Index, T...> &v, FormatContext &ctx) {
+        std::stringstream ss;
+        bool first {true};
+        for (const auto neighbor : v.neighbors()) {
+            if(!first) {
+                ss << ",";
+            }
+            ss << neighbor.value;
+            first = false;
+        }
+        return format_to(ctx.out(), "Vertex[{}, neighbors=[{}]]", v.data(), ss.str());
+    }
+};
+}
@@ -0,0 +1,236 @@
+/**
+ * @file ConcurrentGraphBuilder_detail.h
+ * @brief Definitions for the ConcurrentGraphBuilder
+ */
+
+#pragma once
+
+#include <iterator>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "../ConcurrentGraphBuilder.h"
+
+namespace graphs {
+
+template<typename Graph>
+inline ConcurrentGraphBuilder<Graph>::ConcurrentGraphBuilder(Graph graph, std::size_t edgeCapacity)
+        : _graph(std::move(graph)), _capacity(edgeCapacity), _pool(new Edge[edgeCapacity]) {}
+
+template<typename Graph>
+inline typename ConcurrentGraphBuilder<Graph>::PersistentVertexIndex ConcurrentGraphBuilder<Graph>::addVertex(VertexData data) {
+    std::lock_guard<std::mutex> lock(_vertexMutex);
+    return _graph.addVertex(std::move(data));
+}
+
+template<typename Graph>
+inline void ConcurrentGraphBuilder<Graph>::addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
+    store(_next.fetch_add(1, std::memory_order_relaxed), std::make_tuple(ix1, ix2));
+}
+
+template<typename Graph>
+inline void ConcurrentGraphBuilder<Graph>::addEdge(const Edge &edge) {
+    store(_next.fetch_add(1, std::memory_order_relaxed), edge);
+}
+
+template<typename Graph>
+template<typename InputIt>
+inline void ConcurrentGraphBuilder<Graph>::addEdges(InputIt first, InputIt last) {
+    auto n = static_cast<std::size_t>(std::distance(first, last));
+    auto slot = _next.fetch_add(n, std::memory_order_relaxed);
+    for (; first != last; ++first, ++slot) {
+        store(slot, *first);
+    }
+}
+
+template<typename Graph>
+inline void ConcurrentGraphBuilder<Graph>::store(std::size_t slot, const Edge &edge) {
+    // every slot is reserved by exactly one thread, so no further synchronization is needed
+    if (slot < _capacity) {
+        _pool[slot] = edge;
+    } else {
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+        _overflow.push_back(edge);
+    }
+}
+
+template<typename Graph>
+inline std::size_t ConcurrentGraphBuilder<Graph>::nRecordedEdges() const {
+    return _next.load(std::memory_order_relaxed);
+}
+
+template<typename Graph>
+inline const typename ConcurrentGraphBuilder<Graph>::Edge &ConcurrentGraphBuilder<Graph>::recorded(std::size_t i) const {
+    auto nPooled = std::min(_next.load(), _capacity);
+    return i < nPooled ? _pool[i] : _overflow[i - nPooled];
+}
+
+template<typename Graph>
+inline Graph ConcurrentGraphBuilder<Graph>::finalize() {
+    return build(nullptr);
+}
+
+template<typename Graph>
+inline Graph ConcurrentGraphBuilder<Graph>::finalize(ThreadPool &pool) {
+    return build(&pool);
+}
+
+namespace detail {
+/**
+ * Splits [0, n) into consecutive ranges and calls task(begin, end) for each of them, on the threads of the pool if
+ * there is one. The first exception thrown by a task is rethrown after all ranges were processed.
+ */
+inline void forEachRange(ThreadPool *pool, std::size_t n, const std::function<void(std::size_t, std::size_t)> &task) {
+    // a few ranges per thread so that idle threads can steal, but not so many that scheduling dominates
+    auto nRanges = pool ? std::max<std::size_t>(1, std::min(4 * pool->nThreads(), n / 1024)) : 1;
+    if (nRanges == 1) {
+        task(0, n);
+        return;
+    }
+    std::vector<std::size_t> order(nRanges);
+    std::iota(order.begin(), order.end(), 0);
+    pool->run(order, [&](std::size_t i) {
+        task(n * i / nRanges, n * (i + 1) / nRanges);
+    });
+}
+}
+
+template<typename Graph>
+inline Graph ConcurrentGraphBuilder<Graph>::build(ThreadPool *pool) {
+    auto nRecorded = std::min(_next.load(), _capacity) + _overflow.size();
+    const auto &vertices = std::as_const(_graph).vertices();
+    auto nSlots = vertices.size_persistent();
+    {
+        // validate everything up front so that a failure leaves the graph and the recorded edges untouched
+        auto isActive = [&vertices](PersistentVertexIndex ix) {
+            return ix.value < vertices.size_persistent() && !(vertices.begin_persistent() + ix.value)->deactivated();
+        };
+        detail::forEachRange(pool, nRecorded, [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i) {
+                const auto &[ix1, ix2] = recorded(i);
+                if (!isActive(ix1) || !isActive(ix2)) {
+                    throw std::invalid_argument("Tried adding an edge to a vertex which does not exist or was removed.");
+                }
+            }
+        });
+    }
+
+    if (_graph.journaling()) {
+        // every mutation has to be journaled
+        auto batch = _graph.batch();
+        for (std::size_t i = 0; i < nRecorded; ++i) {
+            batch.addEdge(recorded(i));
+        }
+        batch.commit();
+    } else {
+        // number of recorded neighbors per vertex, then the fill cursor of every vertex
+        std::vector<std::atomic<std::size_t>> cursors(nSlots);
+        detail::forEachRange(pool, nRecorded, [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i) {
+                const auto &[ix1, ix2] = recorded(i);
+                cursors[ix1.value].fetch_add(1, std::memory_order_relaxed);
+                if (ix1 != ix2) {
+                    cursors[ix2.value].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        std::vector<std::size_t> offsets(nSlots + 1, 0);
+        for (std::size_t v = 0; v < nSlots; ++v) {
+            offsets[v + 1] = offsets[v] + cursors[v].load(std::memory_order_relaxed);
+            cursors[v].store(offsets[v], std::memory_order_relaxed);
+        }
+        std::vector<PersistentVertexIndex> adjacency(offsets.back());
+        detail::forEachRange(pool, nRecorded, [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i) {
+                const auto &[ix1, ix2] = recorded(i);
+                adjacency[cursors[ix1.value].fetch_add(1, std::memory_order_relaxed)] = ix2;
+                if (ix1 != ix2) {
+                    adjacency[cursors[ix2.value].fetch_add(1, std::memory_order_relaxed)] = ix1;
+                }
+            }
+        });
+
+        // per vertex, the new neighbors sorted and without duplicates or existing neighbors at the front of its
+        // range in the adjacency, and the number of new edges it is the smaller vertex of
+        std::vector<std::size_t> nNeighbors(nSlots, 0);
+        std::vector<std::size_t> edgeOffsets(nSlots + 1, 0);
+        detail::forEachRange(pool, nSlots, [&](std::size_t firstVertex, std::size_t lastVertex) {
+            std::vector<PersistentVertexIndex> existing;
+            for (auto v = firstVertex; v < lastVertex; ++v) {
+                auto first = adjacency.begin() + offsets[v];
+                auto last = adjacency.begin() + offsets[v + 1];
+                if (first == last) {
+                    continue;
+                }
+                std::sort(first, last);
+                last = std::unique(first, last);
+                const auto &neighbors = (vertices.begin_persistent() + v)->neighbors();
+                if (!neighbors.empty()) {
+                    if constexpr (Graph::SortedNeighbors) {
+                        last = std::remove_if(first, last, [&neighbors](PersistentVertexIndex ix) {
+                            return std::binary_search(neighbors.begin(), neighbors.end(), ix);
+                        });
+                    } else {
+                        existing.assign(neighbors.begin(), neighbors.end());
+                        std::sort(existing.begin(), existing.end());
+                        last = std::remove_if(first, last, [&existing](PersistentVertexIndex ix) {
+                            return std::binary_search(existing.begin(), existing.end(), ix);
+                        });
+                    }
+                }
+                nNeighbors[v] = static_cast<std::size_t>(std::distance(first, last));
+                if constexpr (Graph::MaxDegree > 0) {
+                    Graph::checkDegree(PersistentVertexIndex::of(v), neighbors.size() + nNeighbors[v]);
+                }
+                edgeOffsets[v + 1] = static_cast<std::size_t>(
+                        std::distance(std::lower_bound(first, last, PersistentVertexIndex::of(v)), last));
+            }
+        });
+        std::partial_sum(edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin());
+
+        // mutable access to the neighbor lists may detach copy-on-write storage, which is not thread-safe
+        using NeighborList = std::remove_reference_t<decltype(_graph._vertices.begin_persistent()->neighbors())>;
+        std::vector<NeighborList *> neighborLists(nSlots, nullptr);
+        for (std::size_t v = 0; v < nSlots; ++v) {
+            if (nNeighbors[v] > 0) {
+                neighborLists[v] = &(_graph._vertices.begin_persistent() + v)->neighbors();
+                _graph.touch(PersistentVertexIndex::of(v));
+            }
+        }
+        std::vector<Edge> edges(edgeOffsets.back());
+        detail::forEachRange(pool, nSlots, [&](std::size_t firstVertex, std::size_t lastVertex) {
+            for (auto v = firstVertex; v < lastVertex; ++v) {
+                if (nNeighbors[v] == 0) {
+                    continue;
+                }
+                auto first = adjacency.begin() + offsets[v];
+                auto last = first + nNeighbors[v];
+                auto &neighbors = *neighborLists[v];
+                auto nKept = neighbors.size();
+                neighbors.reserve(nKept + nNeighbors[v]);
+                for (auto it = first; it != last; ++it) {
+                    neighbors.push_back(*it);
+                }
+                if constexpr (Graph::SortedNeighbors) {
+                    std::inplace_merge(neighbors.begin(), neighbors.begin() + nKept, neighbors.end());
+                }
+                auto edge = edges.begin() + edgeOffsets[v];
+                for (auto it = std::lower_bound(first, last, PersistentVertexIndex::of(v)); it != last; ++it) {
+                    *edge++ = std::make_tuple(PersistentVertexIndex::of(v), *it);
+                }
+            }
+        });
+        _graph._edges.insert(_graph._edges.end(), edges.begin(), edges.end());
+    }
+    _next.store(0);
+    _overflow.clear();
+    Graph result = std::move(_graph);
+    _graph = Graph{};
+    return result;
+}
+
+}
@@ -0,0 +1,361 @@
+/**
+ * This file contains the chunked copy-on-write vector. Elements are stored in fixed-size chunks which are shared
+ * between copies of the vector through reference counting. Copying the vector is O(#chunks), a chunk is duplicated
+ * on the first non-const access through a copy which shares it.
+ *
+ * @file CowVector_detail.h
+ * @brief Definitions for the chunked copy-on-write vector
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace graphs::detail {
+
+template<typename T, std::size_t ChunkSize>
+class ChunkedCowVector {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize has to be a power of two");
+
+    using Chunk = std::vector<T>;
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = std::allocator<T>;
+    using reference = T &;
+    using const_reference = const T &;
+
+    /**
+     * Random access iterator over the elements. Dereferencing a non-const iterator detaches the pointed-to chunk
+     * if it is shared, so algorithms which only read should use const iterators.
+     * @tparam Const whether this is a const iterator
+     */
+    template<bool Const>
+    class basic_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = std::conditional_t<Const, const T &, T &>;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using iterator_category = std::random_access_iterator_tag;
+        using container_pointer = std::conditional_t<Const, const ChunkedCowVector *, ChunkedCowVector *>;
+
+        basic_iterator() = default;
+
+        basic_iterator(container_pointer container, size_type index) : _container(container), _index(index) {}
+
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &other) : _container(other._container), _index(other._index) {}
+
+        reference operator*() const { return (*_container)[_index]; }
+
+        pointer operator->() const { return &(*_container)[_index]; }
+
+        reference operator[](difference_type n) const { return (*_container)[_index + n]; }
+
+        basic_iterator &operator++() {
+            ++_index;
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator copy(*this);
+            ++_index;
+            return copy;
+        }
+
+        basic_iterator &operator--() {
+            --_index;
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            basic_iterator copy(*this);
+            --_index;
+            return copy;
+        }
+
+        basic_iterator &operator+=(difference_type n) {
+            _index += n;
+            return *this;
+        }
+
+        basic_iterator &operator-=(difference_type n) {
+            _index -= n;
+            return *this;
+        }
+
+        basic_iterator operator+(difference_type n) const { return {_container, _index + n}; }
+
+        friend basic_iterator operator+(difference_type n, const basic_iterator &it) { return it + n; }
+
+        basic_iterator operator-(difference_type n) const { return {_container, _index - n}; }
+
+        template<bool C>
+        difference_type operator-(const basic_iterator<C> &rhs) const {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(rhs._index);
+        }
+
+        template<bool C>
+        bool operator==(const basic_iterator<C> &rhs) const { return _index == rhs._index; }
+
+        template<bool C>
+        bool operator!=(const basic_iterator<C> &rhs) const { return _index != rhs._index; }
+
+        template<bool C>
+        bool operator<(const basic_iterator<C> &rhs) const { return _index < rhs._index; }
+
+        template<bool C>
+        bool operator>(const basic_iterator<C> &rhs) const { return _index > rhs._index; }
+
+        template<bool C>
+        bool operator<=(const basic_iterator<C> &rhs) const { return _index <= rhs._index; }
+
+        template<bool C>
+        bool operator>=(const basic_iterator<C> &rhs) const { return _index >= rhs._index; }
+
+    private:
+        friend class ChunkedCowVector;
+
+        friend class basic_iterator<!Const>;
+
+        container_pointer _container {};
+        size_type _index {};
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    ChunkedCowVector() = default;
+
+    ChunkedCowVector(std::initializer_list<T> init) {
+        for (const auto &x : init) {
+            push_back(x);
+        }
+    }
+
+    /**
+     * Copies share all chunks, O(#chunks).
+     */
+    ChunkedCowVector(const ChunkedCowVector &) = default;
+
+    ChunkedCowVector &operator=(const ChunkedCowVector &) = default;
+
+    ChunkedCowVector(ChunkedCowVector &&other) noexcept : _chunks(std::move(other._chunks)), _size(other._size) {
+        other._chunks.clear();
+        other._size = 0;
+    }
+
+    ChunkedCowVector &operator=(ChunkedCowVector &&rhs) noexcept {
+        _chunks = std::move(rhs._chunks);
+        _size = rhs._size;
+        rhs._chunks.clear();
+        rhs._size = 0;
+        return *this;
+    }
+
+    ~ChunkedCowVector() = default;
+
+    [[nodiscard]] size_type size() const {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _size == 0;
+    }
+
+    [[nodiscard]] size_type capacity() const {
+        return _chunks.size() * ChunkSize;
+    }
+
+    /**
+     * @return the number of chunks
+     */
+    [[nodiscard]] size_type n_chunks() const {
+        return _chunks.size();
+    }
+
+    /**
+     * @return the number of chunks which are currently shared with other copies
+     */
+    [[nodiscard]] size_type n_shared_chunks() const {
+        return static_cast<size_type>(std::count_if(_chunks.begin(), _chunks.end(), [](const auto &chunk) {
+            return chunk.use_count() > 1;
+        }));
+    }
+
+    void reserve(size_type n) {
+        _chunks.reserve((n + ChunkSize - 1) / ChunkSize);
+    }
+
+    allocator_type get_allocator() const {
+        return {};
+    }
+
+    const T &operator[](size_type index) const {
+        return (*_chunks[index / ChunkSize])[index % ChunkSize];
+    }
+
+    T &operator[](size_type index) {
+        return mutableChunk(index / ChunkSize)[index % ChunkSize];
+    }
+
+    const T &at(size_type index) const {
+        if (index >= _size) {
+            throw std::out_of_range("ChunkedCowVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    T &at(size_type index) {
+        if (index >= _size) {
+            throw std::out_of_range("ChunkedCowVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    const T &front() const { return (*this)[0]; }
+
+    T &front() { return (*this)[0]; }
+
+    const T &back() const { return (*this)[_size - 1]; }
+
+    T &back() { return (*this)[_size - 1]; }
+
+    iterator begin() { return {this, 0}; }
+
+    const_iterator begin() const { return {this, 0}; }
+
+    const_iterator cbegin() const { return {this, 0}; }
+
+    iterator end() { return {this, _size}; }
+
+    const_iterator end() const { return {this, _size}; }
+
+    const_iterator cend() const { return {this, _size}; }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        if (_size % ChunkSize == 0) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->reserve(ChunkSize);
+            chunk->emplace_back(std::forward<Args>(args)...);
+            _chunks.push_back(std::move(chunk));
+        } else {
+            mutableChunk(_chunks.size() - 1).emplace_back(std::forward<Args>(args)...);
+        }
+        ++_size;
+        return _chunks.back()->back();
+    }
+
+    void pop_back() {
+        auto &chunk = mutableChunk(_chunks.size() - 1);
+        chunk.pop_back();
+        --_size;
+        if (chunk.empty()) {
+            _chunks.pop_back();
+        }
+    }
+
+    iterator insert(const_iterator pos, const T &value) {
+        auto index = pos._index;
+        push_back(value);
+        std::rotate(begin() + index, end() - 1, end());
+        return {this, index};
+    }
+
+    template<typename InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        auto index = pos._index;
+        auto oldSize = _size;
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+        std::rotate(begin() + index, begin() + oldSize, end());
+        return {this, index};
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        auto n = last._index - first._index;
+        if (n > 0) {
+            for (auto i = last._index; i < _size; ++i) {
+                (*this)[i - n] = std::move((*this)[i]);
+            }
+            for (size_type i = 0; i < n; ++i) {
+                pop_back();
+            }
+        }
+        return {this, first._index};
+    }
+
+    void clear() {
+        _chunks.clear();
+        _size = 0;
+    }
+
+    void shrink_to_fit() {
+        _chunks.shrink_to_fit();
+        if (!_chunks.empty() && _chunks.back()->capacity() > _chunks.back()->size()) {
+            auto &chunk = mutableChunk(_chunks.size() - 1);
+            chunk.shrink_to_fit();
+        }
+    }
+
+    bool operator==(const ChunkedCowVector &rhs) const {
+        return _size == rhs._size && std::equal(cbegin(), cend(), rhs.cbegin());
+    }
+
+    bool operator!=(const ChunkedCowVector &rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    /**
+     * Yields a chunk for writing, duplicating it first in case it is shared with another copy.
+     * @param index the chunk index
+     * @return reference to the chunk
+     */
+    Chunk &mutableChunk(size_type index) {
+        auto &chunk = _chunks[index];
+        if (chunk.use_count() > 1) {
+            auto copy = std::make_shared<Chunk>();
+            copy->reserve(ChunkSize);
+            copy->insert(copy->end(), chunk->begin(), chunk->end());
+            chunk = std::move(copy);
+        }
+        return *chunk;
+    }
+
+    std::vector<std::shared_ptr<Chunk>> _chunks {};
+    size_type _size {0};
+};
+
+}
@@ -0,0 +1,299 @@
+/**
+ * @file Export_detail.h
+ * @brief Definitions for the graph exporters
+ */
+
+#pragma once
+
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "../Export.h"
+
+namespace graphs {
+
+namespace detail {
+
+template<typename Tuple>
+struct all_formattable;
+
+template<typename... T>
+struct all_formattable<std::tuple<T...>> : std::bool_constant<(fmt::is_formattable<T>::value && ...)> {};
+
+template<typename Vertex, typename F>
+void forEachDataField(const Vertex &vertex, F &&f) {
+    if constexpr (std::tuple_size_v<typename Vertex::data_type> == 1) {
+        f(vertex.data());
+    } else {
+        std::apply([&f](const auto &... fields) { (f(fields), ...); }, vertex.data());
+    }
+}
+
+/**
+ * Appends to the export buffer and flushes it to the output stream (if any) in chunks.
+ */
+class ExportWriter {
+public:
+    enum class Escape {
+        xml, dot
+    };
+
+    ExportWriter(fmt::memory_buffer &buffer, std::ostream *os, std::size_t chunkSize)
+            : _buffer(buffer), _os(os), _chunkSize(chunkSize) {}
+
+    void append(std::string_view text) {
+        _buffer.append(text.data(), text.data() + text.size());
+    }
+
+    void appendIndex(std::size_t value) {
+        fmt::format_int formatted(value);
+        _buffer.append(formatted.data(), formatted.data() + formatted.size());
+    }
+
+    /**
+     * Formats a value and appends it with the special characters of the format escaped. Values without formatter
+     * are skipped, exportGraph() rejects them up front.
+     */
+    template<typename T>
+    void appendEscaped(const T &value, Escape escape) {
+        _scratch.clear();
+        if constexpr (fmt::is_formattable<T>::value) {
+            fmt::format_to(std::back_inserter(_scratch), "{}", value);
+        }
+        for (auto c : _scratch) {
+            if (escape == Escape::xml) {
+                switch (c) {
+                    case '&': append("&amp;"); break;
+                    case '<': append("&lt;"); break;
+                    case '>': append("&gt;"); break;
+                    case '"': append("&quot;"); break;
+                    case '\'': append("&apos;"); break;
+                    default: _buffer.push_back(c);
+                }
+            } else {
+                if (c == '"' || c == '\\') {
+                    _buffer.push_back('\\');
+                }
+                _buffer.push_back(c);
+            }
+        }
+    }
+
+    /**
+     * Flushes the buffer if it exceeds the chunk size.
+     */
+    void chunk() {
+        if (_os && _buffer.size() >= _chunkSize) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (_os) {
+            _os->write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+            _buffer.clear();
+            if (!*_os) {
+                throw std::runtime_error("Failed to write the exported graph to the stream.");
+            }
+        }
+    }
+
+private:
+    fmt::memory_buffer &_buffer;
+    std::ostream *_os;
+    std::size_t _chunkSize;
+    fmt::memory_buffer _scratch {};
+};
+
+template<typename Graph>
+void exportGexf(const Graph &graph, ExportWriter &writer, bool vertexData) {
+    using Vertex = typename Graph::VertexList::value_type;
+    constexpr auto nFields = std::tuple_size_v<typename Vertex::data_type>;
+    const auto &vertices = graph.vertices();
+    writer.append(R"(<?xml version="1.0" encoding="UTF-8"?>)");
+    writer.append(R"(<gexf xmlns="http://www.gexf.net/1.2draft" version="1.2">)");
+    writer.append(R"(<graph mode="static" defaultedgetype="undirected">)");
+    if (vertexData) {
+        writer.append(R"(<attributes class="node">)");
+        for (std::size_t field = 0; field < nFields; ++field) {
+            writer.append(R"(<attribute id=")");
+            writer.appendIndex(field);
+            writer.append(R"(" title="data)");
+            writer.appendIndex(field);
+            writer.append(R"(" type="string" />)");
+        }
+        writer.append("</attributes>");
+    }
+    writer.append("<nodes>");
+    std::size_t id = 0;
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it, ++id) {
+        if (it->deactivated()) {
+            continue;
+        }
+        writer.append(R"(<node id=")");
+        writer.appendIndex(id);
+        if (vertexData) {
+            writer.append(R"("><attvalues>)");
+            std::size_t field = 0;
+            forEachDataField(*it, [&writer, &field](const auto &value) {
+                writer.append(R"(<attvalue for=")");
+                writer.appendIndex(field++);
+                writer.append(R"(" value=")");
+                writer.appendEscaped(value, ExportWriter::Escape::xml);
+                writer.append(R"(" />)");
+            });
+            writer.append("</attvalues></node>");
+        } else {
+            writer.append(R"(" />)");
+        }
+        writer.chunk();
+    }
+    writer.append("</nodes>");
+    writer.append("<edges>");
+    id = 0;
+    for (const auto &[ix1, ix2] : graph.edges()) {
+        writer.append(R"(<edge id=")");
+        writer.appendIndex(id++);
+        writer.append(R"(" source=")");
+        writer.appendIndex(ix1.value);
+        writer.append(R"(" target=")");
+        writer.appendIndex(ix2.value);
+        writer.append(R"(" />)");
+        writer.chunk();
+    }
+    writer.append("</edges>");
+    writer.append("</graph>");
+    writer.append("</gexf>");
+}
+
+template<typename Graph>
+void exportGraphml(const Graph &graph, ExportWriter &writer, bool vertexData) {
+    using Vertex = typename Graph::VertexList::value_type;
+    constexpr auto nFields = std::tuple_size_v<typename Vertex::data_type>;
+    const auto &vertices = graph.vertices();
+    writer.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    writer.append("<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n");
+    if (vertexData) {
+        for (std::size_t field = 0; field < nFields; ++field) {
+            writer.append("<key id=\"d");
+            writer.appendIndex(field);
+            writer.append("\" for=\"node\" attr.name=\"data");
+            writer.appendIndex(field);
+            writer.append("\" attr.type=\"string\"/>\n");
+        }
+    }
+    writer.append("<graph id=\"G\" edgedefault=\"undirected\">\n");
+    std::size_t id = 0;
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it, ++id) {
+        if (it->deactivated()) {
+            continue;
+        }
+        writer.append("<node id=\"n");
+        writer.appendIndex(id);
+        if (vertexData) {
+            writer.append("\">");
+            std::size_t field = 0;
+            forEachDataField(*it, [&writer, &field](const auto &value) {
+                writer.append("<data key=\"d");
+                writer.appendIndex(field++);
+                writer.append("\">");
+                writer.appendEscaped(value, ExportWriter::Escape::xml);
+                writer.append("</data>");
+            });
+            writer.append("</node>\n");
+        } else {
+            writer.append("\"/>\n");
+        }
+        writer.chunk();
+    }
+    id = 0;
+    for (const auto &[ix1, ix2] : graph.edges()) {
+        writer.append("<edge id=\"e");
+        writer.appendIndex(id++);
+        writer.append("\" source=\"n");
+        writer.appendIndex(ix1.value);
+        writer.append("\" target=\"n");
+        writer.appendIndex(ix2.value);
+        writer.append("\"/>\n");
+        writer.chunk();
+    }
+    writer.append("</graph>\n");
+    writer.append("</graphml>\n");
+}
+
+template<typename Graph>
+void exportDot(const Graph &graph, ExportWriter &writer, bool vertexData) {
+    const auto &vertices = graph.vertices();
+    writer.append("graph G {\n");
+    std::size_t id = 0;
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it, ++id) {
+        if (it->deactivated()) {
+            continue;
+        }
+        writer.appendIndex(id);
+        if (vertexData) {
+            writer.append(" [label=\"");
+            bool first = true;
+            forEachDataField(*it, [&writer, &first](const auto &value) {
+                if (!first) {
+                    writer.append(", ");
+                }
+                first = false;
+                writer.appendEscaped(value, ExportWriter::Escape::dot);
+            });
+            writer.append("\"]");
+        }
+        writer.append(";\n");
+        writer.chunk();
+    }
+    for (const auto &[ix1, ix2] : graph.edges()) {
+        writer.appendIndex(ix1.value);
+        writer.append(" -- ");
+        writer.appendIndex(ix2.value);
+        writer.append(";\n");
+        writer.chunk();
+    }
+    writer.append("}\n");
+}
+
+template<typename Graph>
+void exportGraph(const Graph &graph, ExportWriter &writer, ExportFormat format, bool vertexData) {
+    using Vertex = typename Graph::VertexList::value_type;
+    if constexpr (!all_formattable<typename Vertex::data_type>::value) {
+        if (vertexData) {
+            throw std::invalid_argument("The vertex data has no fmt formatter.");
+        }
+    }
+    switch (format) {
+        case ExportFormat::gexf:
+            exportGexf(graph, writer, vertexData);
+            break;
+        case ExportFormat::graphml:
+            exportGraphml(graph, writer, vertexData);
+            break;
+        case ExportFormat::dot:
+            exportDot(graph, writer, vertexData);
+            break;
+    }
+    writer.flush();
+}
+}
+
+template<typename Graph>
+inline void exportGraph(const Graph &graph, std::ostream &os, ExportFormat format, const ExportOptions &options) {
+    fmt::memory_buffer buffer;
+    detail::ExportWriter writer(buffer, &os, options.chunkSize);
+    detail::exportGraph(graph, writer, format, options.vertexData);
+}
+
+template<typename Graph>
+inline void exportGraph(const Graph &graph, fmt::memory_buffer &buffer, ExportFormat format,
+                        const ExportOptions &options) {
+    detail::ExportWriter writer(buffer, nullptr, options.chunkSize);
+    detail::exportGraph(graph, writer, format, options.vertexData);
+}
+
+}
@@ -0,0 +1,223 @@
+/**
+ * @file GraphCollection_detail.h
+ * @brief Definitions for the GraphCollection
+ */
+
+#pragma once
+
+#include <tuple>
+#include <iterator>
+#include <algorithm>
+
+#include "../GraphCollection.h"
+
+namespace graphs {
+
+template<typename Graph>
+inline typename GraphCollection<Graph>::GraphId GraphCollection<Graph>::add(const Graph &graph) {
+    const auto &vertices = graph.vertices();
+    auto offset = _data.size();
+    std::vector<std::size_t> mapping(vertices.size_persistent(), npos);
+    {
+        std::size_t local = 0;
+        for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it) {
+            if (!it->deactivated()) {
+                mapping[static_cast<std::size_t>(std::distance(vertices.cbegin_persistent(), it))] = local++;
+                _data.push_back(it->data());
+            }
+        }
+    }
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            for (auto neighbor : it->neighbors()) {
+                _adjacency.push_back({mapping[neighbor.value]});
+            }
+            _neighborOffsets.push_back(_adjacency.size());
+        }
+    }
+    return _graphs.push_back(GraphRecord{offset, _data.size() - offset, graph.nEdges()}).persistent_index();
+}
+
+template<typename Graph>
+inline void GraphCollection<Graph>::remove(GraphId id) {
+    _garbageVertices += record(id).nVertices;
+    _graphs.erase(_graphs.begin_persistent() + id.value);
+    if (2 * _garbageVertices > _data.size()) {
+        compact();
+    }
+}
+
+template<typename Graph>
+inline Graph GraphCollection<Graph>::graph(GraphId id) const {
+    using Index = typename Graph::PersistentVertexIndex;
+    const auto &rec = record(id);
+    Graph graph;
+    for (std::size_t v = 0; v < rec.nVertices; ++v) {
+        graph.addVertex(_data[rec.vertexOffset + v]);
+    }
+    for (std::size_t v = 0; v < rec.nVertices; ++v) {
+        for (auto neighbor : neighbors(id, {v})) {
+            if (v <= neighbor.value) {
+                graph.addEdge(Index::of(v), Index::of(neighbor.value));
+            }
+        }
+    }
+    return graph;
+}
+
+template<typename Graph>
+inline std::vector<typename GraphCollection<Graph>::GraphId> GraphCollection<Graph>::graphIds() const {
+    std::vector<GraphId> ids;
+    ids.reserve(_graphs.size());
+    for (auto it = _graphs.begin(); it != _graphs.end(); ++it) {
+        ids.push_back(it.persistent_index());
+    }
+    return ids;
+}
+
+template<typename Graph>
+inline std::size_t GraphCollection<Graph>::nGraphs() const {
+    return _graphs.size();
+}
+
+template<typename Graph>
+inline std::size_t GraphCollection<Graph>::nVertices(GraphId id) const {
+    return record(id).nVertices;
+}
+
+template<typename Graph>
+inline std::size_t GraphCollection<Graph>::nEdges(GraphId id) const {
+    return record(id).nEdges;
+}
+
+template<typename Graph>
+inline std::size_t GraphCollection<Graph>::vertexOffset(GraphId id) const {
+    return record(id).vertexOffset;
+}
+
+template<typename Graph>
+inline std::size_t GraphCollection<Graph>::vertexPoolSize() const {
+    return _data.size();
+}
+
+template<typename Graph>
+inline const typename GraphCollection<Graph>::data_type &GraphCollection<Graph>::data(GraphId id, LocalVertexIndex vertex) const {
+    return _data[record(id).vertexOffset + vertex.value];
+}
+
+template<typename Graph>
+inline typename GraphCollection<Graph>::data_type &GraphCollection<Graph>::data(GraphId id, LocalVertexIndex vertex) {
+    return _data[record(id).vertexOffset + vertex.value];
+}
+
+template<typename Graph>
+inline typename GraphCollection<Graph>::NeighborRange GraphCollection<Graph>::neighbors(GraphId id, LocalVertexIndex vertex) const {
+    auto slot = record(id).vertexOffset + vertex.value;
+    return {_adjacency.data() + _neighborOffsets[slot], _adjacency.data() + _neighborOffsets[slot + 1]};
+}
+
+template<typename Graph>
+template<typename PairCallback, typename TripleCallback, typename QuadrupleCallback>
+inline void GraphCollection<Graph>::findNTuples(const PairCallback &pairCallback, const TripleCallback &tripleCallback,
+                                                const QuadrupleCallback &quadrupleCallback) const {
+    std::vector<char> visited;
+    for (auto it = _graphs.begin(); it != _graphs.end(); ++it) {
+        auto id = it.persistent_index();
+        visited.assign(it->nVertices, false);
+        for (std::size_t v = 0; v < it->nVertices; ++v) {
+            // vertex v1
+            auto v1 = LocalVertexIndex{v};
+            visited[v] = true;
+            auto neighbors1 = neighbors(id, v1);
+            for (auto v2 : neighbors1) {
+                // vertex v2 in N(v1)
+                if (!visited[v2.value]) {
+                    pairCallback(id, std::make_tuple(v1, v2));
+                    for (auto v3 : neighbors1) {
+                        if (v2 != v3) {
+                            // vertex v3 in N(v1)\{v2}
+                            for (auto v4 : neighbors(id, v2)) {
+                                if (v4 != v1 && v4 != v3) {
+                                    // vertex v4 in N(v2)\{v1, v3}
+                                    quadrupleCallback(id, std::make_tuple(v3, v1, v2, v4));
+                                }
+                            }
+                        }
+                    }
+                }
+                for (auto v3 : neighbors1) {
+                    if (v3 != v2 && v3 < v2) {
+                        tripleCallback(id, std::make_tuple(v3, v1, v2));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename Graph>
+inline std::vector<std::size_t> GraphCollection<Graph>::componentLabels() const {
+    std::vector<std::size_t> labels(_data.size(), npos);
+    std::vector<std::size_t> unvisited;
+    std::size_t label = 0;
+    for (auto it = _graphs.begin(); it != _graphs.end(); ++it) {
+        auto offset = it->vertexOffset;
+        for (auto slot = offset; slot < offset + it->nVertices; ++slot) {
+            if (labels[slot] != npos) {
+                continue;
+            }
+            unvisited.push_back(slot);
+            labels[slot] = label;
+            while (!unvisited.empty()) {
+                auto current = unvisited.back();
+                unvisited.pop_back();
+                for (auto i = _neighborOffsets[current]; i < _neighborOffsets[current + 1]; ++i) {
+                    auto neighbor = offset + _adjacency[i].value;
+                    if (labels[neighbor] == npos) {
+                        labels[neighbor] = label;
+                        unvisited.push_back(neighbor);
+                    }
+                }
+            }
+            ++label;
+        }
+    }
+    return labels;
+}
+
+template<typename Graph>
+inline void GraphCollection<Graph>::compact() {
+    std::vector<data_type> data;
+    std::vector<std::size_t> neighborOffsets {0};
+    std::vector<LocalVertexIndex> adjacency;
+    data.reserve(_data.size() - _garbageVertices);
+    neighborOffsets.reserve(_data.size() - _garbageVertices + 1);
+    for (auto it = _graphs.begin(); it != _graphs.end(); ++it) {
+        auto offset = it->vertexOffset;
+        it->vertexOffset = data.size();
+        std::move(_data.begin() + offset, _data.begin() + offset + it->nVertices, std::back_inserter(data));
+        for (auto slot = offset; slot < offset + it->nVertices; ++slot) {
+            adjacency.insert(adjacency.end(), _adjacency.begin() + _neighborOffsets[slot],
+                             _adjacency.begin() + _neighborOffsets[slot + 1]);
+            neighborOffsets.push_back(adjacency.size());
+        }
+    }
+    _data = std::move(data);
+    _neighborOffsets = std::move(neighborOffsets);
+    _adjacency = std::move(adjacency);
+    _garbageVertices = 0;
+}
+
+template<typename Graph>
+inline void GraphCollection<Graph>::reserve(std::size_t nVertices, std::size_t nAdjacency) {
+    _data.reserve(nVertices);
+    _neighborOffsets.reserve(nVertices + 1);
+    _adjacency.reserve(nAdjacency);
+}
+
+template<typename Graph>
+inline const typename GraphCollection<Graph>::GraphRecord &GraphCollection<Graph>::record(GraphId id) const {
+    return _graphs.at(id);
+}
+
+}
@@ -6,6 +6,7 @@
 
 #include <queue>
 #include "../Graph.h"
+#include "../Export.h"
 
 namespace graphs {
 
@@ -21,31 +22,174 @@ auto reverse_tuple(T t) {
 }
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline Graph<VertexCollection, Vertex, Rest...>::Graph() = default;
+namespace detail {
+inline constexpr char graphFormatMagic[4] {'G', 'R', 'P', 'H'};
+inline constexpr std::uint32_t graphFormatVersion = 1;
+// number of vertex slots whose data is stored as one block of columns
+inline constexpr std::size_t graphFormatBlockSize = 4096;
+inline constexpr char graphDeltaMagic[4] {'G', 'R', 'P', 'D'};
+inline constexpr std::uint32_t graphDeltaVersion = 1;
+
+template<typename Tuple>
+struct data_columns;
+
+template<typename... T>
+struct data_columns<std::tuple<T...>> {
+    using type = std::tuple<std::vector<T>...>;
+};
+
+template<std::size_t I, typename V>
+const auto &dataField(const V &vertex) {
+    if constexpr (std::tuple_size_v<typename V::data_type> == 1) {
+        return vertex.data();
+    } else {
+        return std::get<I>(vertex.data());
+    }
+}
+
+template<typename Tuple, typename F, std::size_t... I>
+void forEachField(F &&f, std::index_sequence<I...>) {
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+template<typename Tuple, typename F>
+void forEachField(F &&f) {
+    forEachField<Tuple>(std::forward<F>(f), std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+}
+
+template<typename Tuple, std::size_t... I>
+constexpr auto fieldIndices(std::index_sequence<I...>) {
+    return std::make_tuple(std::integral_constant<std::size_t, I>{}...);
+}
+
+/**
+ * @return a tuple of std::integral_constant with the indices of the fields of Tuple, e.g., for std::apply
+ */
+template<typename Tuple>
+constexpr auto fieldIndices() {
+    return fieldIndices<Tuple>(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+}
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline Graph<VertexCollection, Vertex, Rest...>::Graph(VertexList vertexList) : _vertices(std::move(vertexList)) {
+/**
+ * Format code of a vertex data field: its size if it is copied in bulk, zero if it goes through the Serializer.
+ */
+template<typename T>
+constexpr std::uint32_t fieldCode() {
+    if constexpr (bulk_serializable_v<T>) {
+        return sizeof(T);
+    } else {
+        return 0;
+    }
+}
+
+template<typename Index>
+void writeIndices(BinaryWriter &writer, const Index *indices, std::size_t n) {
+    static_assert(std::is_trivially_copyable_v<Index>);
+    if constexpr (sizeof(Index) == sizeof(std::uint64_t) && bulk_copyable_v<std::uint64_t>) {
+        writer.writeBytes(indices, n * sizeof(Index));
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            writer.write(static_cast<std::uint64_t>(indices[i].value));
+        }
+    }
+}
+
+template<typename Index>
+Index readIndex(BinaryReader &reader, std::size_t bound) {
+    auto value = reader.read<std::uint64_t>();
+    if (value >= bound) {
+        throw std::runtime_error(fmt::format("Corrupt graph data: vertex index {} out of range.", value));
+    }
+    return Index::of(value);
+}
+
+template<typename Index>
+void readIndices(BinaryReader &reader, Index *indices, std::size_t n, std::size_t bound) {
+    static_assert(std::is_trivially_copyable_v<Index>);
+    if constexpr (sizeof(Index) == sizeof(std::uint64_t) && bulk_copyable_v<std::uint64_t>) {
+        reader.readBytes(indices, n * sizeof(Index));
+        for (std::size_t i = 0; i < n; ++i) {
+            if (indices[i].value >= bound) {
+                throw std::runtime_error(fmt::format("Corrupt graph data: vertex index {} out of range.",
+                                                     indices[i].value));
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            indices[i] = readIndex<Index>(reader, bound);
+        }
+    }
+}
+
+/**
+ * Calls f for every index contained in both neighbor ranges. Sorted ranges are merged in one linear pass and the
+ * indices come in ascending order, otherwise every element of the first range is searched in the second.
+ */
+template<bool Sorted, typename It1, typename It2, typename F>
+void forEachCommonNeighbor(It1 first1, It1 last1, It2 first2, It2 last2, F &&f) {
+    if constexpr (Sorted) {
+        while (first1 != last1 && first2 != last2) {
+            if (*first1 < *first2) {
+                ++first1;
+            } else if (*first2 < *first1) {
+                ++first2;
+            } else {
+                f(*first1);
+                ++first1;
+                ++first2;
+            }
+        }
+    } else {
+        for (; first1 != last1; ++first1) {
+            if (std::find(first2, last2, *first1) != last2) {
+                f(*first1);
+            }
+        }
+    }
+}
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Graph() = default;
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Graph(VertexList vertexList) : _vertices(std::move(vertexList)) {
     findEdges([this](const auto& edge) {
         _edges.push_back(edge);
     });
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline Graph<VertexCollection, Vertex, Rest...>::~Graph() = default;
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Graph(const allocator_type &allocator) : _vertices(allocator), _edges(allocator) {}
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Graph(const Graph &other, const allocator_type &allocator)
+        : Instrumentation(other), _vertices(other._vertices, allocator), _edges(other._edges, allocator),
+          _journal(other._journal), _checkpoints(other._checkpoints), _marker(other._marker),
+          _changed(other._changed) {}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::allocator_type Graph<VertexCollection, Vertex, Instrumentation, Rest...>::get_allocator() const {
+    return _vertices.get_allocator();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::~Graph() = default;
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
 template<typename PairCallback, typename TripleCallback, typename QuadrupleCallback>
-inline void Graph<VertexCollection, Vertex, Rest...>::findNTuples(const PairCallback &pairCallback,
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::findNTuples(const PairCallback &pairCallback,
                                        const TripleCallback &tripleCallback,
-                                       const QuadrupleCallback &quadrupleCallback) {
+                                       const QuadrupleCallback &quadrupleCallback) const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::findNTuples);
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
     std::vector<char> visited (_vertices.size_persistent(), false);
 
     for (std::size_t vertexIndex = 0; vertexIndex < _vertices.size_persistent(); ++vertexIndex) {
         // vertex v1
-        auto pvix = PersistentVertexIndex{vertexIndex};
+        auto pvix = PersistentVertexIndex::of(vertexIndex);
         visited.at(vertexIndex) = true;
-        const auto &v1 = vertices().at(PersistentVertexIndex{vertexIndex});
+        const auto &v1 = *(_vertices.begin_persistent() + vertexIndex);
         if(!v1.deactivated()) {
             auto &neighbors = v1.neighbors();
             for (auto neighborIndex : neighbors) {
@@ -75,101 +219,158 @@ inline void Graph<VertexCollection, Vertex, Rest...>::findNTuples(const PairCall
     }
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline const typename Graph<VertexCollection, Vertex, Rest...>::VertexList &Graph<VertexCollection, Vertex, Rest...>::vertices() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline const typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList &Graph<VertexCollection, Vertex, Instrumentation, Rest...>::vertices() const {
     return _vertices;
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList &Graph<VertexCollection, Vertex, Rest...>::vertices() {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList &Graph<VertexCollection, Vertex, Instrumentation, Rest...>::vertices() {
     return _vertices;
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline bool Graph<VertexCollection, Vertex, Rest...>::containsEdge(const Edge &edge) const {
-    if(std::find(edges().begin(), edges().end(), edge) != edges().end()) {
-        return true;
-    } else {
-        return std::find(edges().begin(), edges().end(), reverse_tuple(edge)) != edges().end();
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::containsEdge(const Edge &edge) const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::containsEdge);
+    // one pass for both orientations
+    auto it = detail::findEdge(_edges, std::get<0>(edge), std::get<1>(edge));
+    if constexpr (Instrumentation::enabled) {
+        instrumentation().count(Counter::edgeListScans);
+        instrumentation().count(Counter::scannedEdges, std::distance(_edges.cbegin(), it) + (it != _edges.cend()));
     }
+    return it != _edges.cend();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline bool Graph<VertexCollection, Vertex, Rest...>::containsEdge(iterator v1, iterator v2) const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::containsEdge(iterator v1, iterator v2) const {
     return containsEdge(v1.persistent_index(), v2.persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline bool Graph<VertexCollection, Vertex, Rest...>::containsEdge(PersistentVertexIndex v1, PersistentVertexIndex v2) const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::containsEdge(PersistentVertexIndex v1, PersistentVertexIndex v2) const {
     return containsEdge(std::tie(v1, v2));
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline bool Graph<VertexCollection, Vertex, Rest...>::containsEdge(ActiveVertexIndex v1, ActiveVertexIndex v2) const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::containsEdge(ActiveVertexIndex v1, ActiveVertexIndex v2) const {
     auto it1 = begin() + v1;
     auto it2 = begin() + v2;
     return containsEdge(it1.persistent_index(), it2.persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::PersistentVertexIndex Graph<VertexCollection, Vertex, Rest...>::addVertex(typename Vertex::data_type data) {
-    return _vertices.emplace_back(data);
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addVertex(typename Vertex::data_type data) {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::addVertex);
+    auto ix = _vertices.emplace_back(data);
+    touch(ix);
+    return ix;
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::addEdge(iterator it1, iterator it2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex
+Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addVertex(typename Vertex::data_type data,
+                                                                     PersistentVertexIndex near) {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::addVertex);
+    auto ix = _vertices.emplace_near(near, data);
+    touch(ix);
+    return ix;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addEdge(iterator it1, iterator it2) {
     addEdge(it1.persistent_index(), it2.persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::addEdge(persistent_iterator it1, persistent_iterator it2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addEdge(persistent_iterator it1, persistent_iterator it2) {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::addEdge);
     if(it1->deactivated() || it2->deactivated()) {
         throw std::invalid_argument("Tried adding an edge between vertices of which at least one was deactivated.");
     }
     auto ix1 = _vertices.persistentIndex(it1);
     auto ix2 = _vertices.persistentIndex(it2);
+    if constexpr (MaxDegree > 0) {
+        // the neighbor lists below cannot overflow once this check passed
+        const auto &neighbors1 = it1->neighbors();
+        const auto &neighbors2 = it2->neighbors();
+        checkDegree(ix1, neighbors1.size() + (detail::findNeighbor(neighbors1, ix2) == neighbors1.end()));
+        checkDegree(ix2, neighbors2.size() + (detail::findNeighbor(neighbors2, ix1) == neighbors2.end()));
+    }
+    touch(ix1);
+    touch(ix2);
+    auto nNeighbors1 = it1->neighbors().size();
+    auto nNeighbors2 = it2->neighbors().size();
     addVertexNeighbor(*it1, ix2);
     addVertexNeighbor(*it2, ix1);
     _edges.push_back(std::make_tuple(ix1, ix2));
+    if (journaling()) {
+        // a new neighbor is appended, or inserted at its position if the lists are sorted
+        auto neighborPosition = [](const auto &neighbors, std::size_t nNeighbors, PersistentVertexIndex ix) {
+            if (neighbors.size() == nNeighbors) {
+                return npos;
+            }
+            if constexpr (SortedNeighbors) {
+                return static_cast<std::size_t>(std::distance(
+                        neighbors.begin(), std::lower_bound(neighbors.begin(), neighbors.end(), ix)));
+            } else {
+                return nNeighbors;
+            }
+        };
+        _journal.push_back({_edges.back(), true, _edges.size() - 1,
+                            neighborPosition(it1->neighbors(), nNeighbors1, ix2),
+                            ix1 != ix2 ? neighborPosition(it2->neighbors(), nNeighbors2, ix1) : npos,
+                            _vertices.journal_size()});
+    }
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::addEdge(ActiveVertexIndex ix1, ActiveVertexIndex ix2) {
-    auto it1 = _vertices.begin() + ix1;
-    auto it2 = _vertices.begin() + ix2;
-    addVertexNeighbor(*it1, it2.persistent_index());
-    addVertexNeighbor(*it2, it1.persistent_index());
-    _edges.push_back(std::make_tuple(PersistentVertexIndex{it1.persistent_index()},
-                                     PersistentVertexIndex{it2.persistent_index()}));
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addEdge(ActiveVertexIndex ix1, ActiveVertexIndex ix2) {
+    addEdge((_vertices.begin() + ix1).to_persistent(), (_vertices.begin() + ix2).to_persistent());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
     addEdge(_vertices.begin_persistent() + ix1.value, _vertices.begin_persistent() + ix2.value);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::addEdge(const Edge &edge) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addEdge(const Edge &edge) {
     addEdge(std::get<0>(edge), std::get<1>(edge));
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-void Graph<VertexCollection, Vertex, Rest...>::removeEdge(iterator it1, iterator it2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeEdge(iterator it1, iterator it2) {
     removeEdge(it1.persistent_index(), it2.persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-void Graph<VertexCollection, Vertex, Rest...>::removeEdge(persistent_iterator it1, persistent_iterator it2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeEdge(persistent_iterator it1, persistent_iterator it2) {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::removeEdge);
     if(it1->deactivated() || it2->deactivated()) {
         throw std::invalid_argument("Tried removing an edge between vertices of which at least one was deactivated.");
     }
     auto ix1 = _vertices.persistentIndex(it1);
     auto ix2 = _vertices.persistentIndex(it2);
-    auto it = std::find_if(_edges.begin(), _edges.end(), [ix1, ix2](const auto& edge) {
-        const auto &[e1, e2] = edge;
-        return (e1 == ix1 && e2 == ix2) || (e1 == ix2 && e2 == ix1);
-    });
+    auto it = detail::findEdge(_edges, ix1, ix2);
+    if constexpr (Instrumentation::enabled) {
+        instrumentation().count(Counter::edgeListScans);
+        instrumentation().count(Counter::scannedEdges, std::distance(_edges.cbegin(), it) + (it != _edges.cend()));
+    }
     if(it != edges().end()) {
+        touch(ix1);
+        touch(ix2);
+        if (journaling()) {
+            const auto &[e1, e2] = *it;
+            const auto &neighbors1 = (_vertices.begin_persistent() + e1.value)->neighbors();
+            const auto &neighbors2 = (_vertices.begin_persistent() + e2.value)->neighbors();
+            auto neighborPosition = [](const auto &neighbors, PersistentVertexIndex ix) {
+                auto pos = detail::findNeighbor(neighbors, ix);
+                return pos != neighbors.end() ? static_cast<std::size_t>(std::distance(neighbors.begin(), pos)) : npos;
+            };
+            _journal.push_back({*it, false, static_cast<std::size_t>(std::distance(_edges.cbegin(), it)),
+                                neighborPosition(neighbors1, e2), e1 != e2 ? neighborPosition(neighbors2, e1) : npos,
+                                _vertices.journal_size()});
+        }
         removeVertexNeighbor(*it1, ix2);
         removeVertexNeighbor(*it2, ix1);
         _edges.erase(it);
@@ -178,56 +379,81 @@ void Graph<VertexCollection, Vertex, Rest...>::removeEdge(persistent_iterator it
     }*/
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeEdge(ActiveVertexIndex ix1, ActiveVertexIndex ix2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeEdge(ActiveVertexIndex ix1, ActiveVertexIndex ix2) {
     removeEdge(begin() + ix1, begin() + ix2);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
     removeEdge(_vertices.begin_persistent() + ix1.value, _vertices.begin_persistent() + ix2.value);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeEdge(const Edge &edge) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeEdge(const Edge &edge) {
     removeEdge(std::get<0>(edge), std::get<1>(edge));
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-void Graph<VertexCollection, Vertex, Rest...>::removeVertex(iterator it) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeVertex(iterator it) {
     removeVertex(it.to_persistent());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-void Graph<VertexCollection, Vertex, Rest...>::removeVertex(persistent_iterator it) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeVertex(persistent_iterator it) {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::removeVertex);
     auto ix = _vertices.persistentIndex(it);
+    if (tracking()) {
+        touch(ix);
+        for (auto neighbor : it->neighbors()) {
+            touch(neighbor);
+        }
+    }
+    if (journaling()) {
+        // decompose into journaled edge removals, the vertex itself is journaled by the vertex list
+        for (auto edgeIt = detail::findIncidentEdge(_edges, ix); edgeIt != _edges.cend();
+             edgeIt = detail::findIncidentEdge(_edges, ix)) {
+            removeEdge(std::get<0>(*edgeIt), std::get<1>(*edgeIt));
+        }
+        _vertices.erase(it);
+        return;
+    }
     removeNeighborsEdges(ix);
     _vertices.erase(it);
-    _edges.erase(std::remove_if(_edges.begin(), _edges.end(), [ix](const auto &edge) {
+    auto touches = [ix](const auto &edge) {
         return std::get<0>(edge) == ix || std::get<1>(edge) == ix;
-    }), _edges.end());
+    };
+    // find the first affected edge through const access so that copy-on-write storage is only detached from there
+    auto first = detail::findIncidentEdge(_edges, ix);
+    instrumentation().count(Counter::edgeListScans);
+    instrumentation().count(Counter::scannedEdges, _edges.size());
+    if (first != _edges.cend()) {
+        _edges.erase(std::remove_if(_edges.begin() + std::distance(_edges.cbegin(), first), _edges.end(), touches),
+                     _edges.end());
+    }
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeVertex(PersistentVertexIndex ix) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeVertex(PersistentVertexIndex ix) {
     removeVertex(_vertices.begin_persistent() + ix.value);
 }
 
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeVertex(ActiveVertexIndex ix) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeVertex(ActiveVertexIndex ix) {
     auto it = begin() + ix;
     removeVertex(it.persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline const std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Edge> &Graph<VertexCollection, Vertex, Rest...>::edges() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline const typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::EdgeList &Graph<VertexCollection, Vertex, Instrumentation, Rest...>::edges() const {
     return _edges;
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
 template<typename PairCallback>
-inline void Graph<VertexCollection, Vertex, Rest...>::findEdges(const PairCallback &edgeCallback) const {
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::findEdges(const PairCallback &edgeCallback) const {
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
     for(auto it = _vertices.begin(); it != _vertices.end(); ++it) {
         const auto& ix = it.persistent_index();
         for(auto neighbor : it->neighbors()) {
@@ -239,10 +465,10 @@ inline void Graph<VertexCollection, Vertex, Rest...>::findEdges(const PairCallba
     }
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::tuple<std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Edge>,
-                  std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Path3>,
-                  std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Path4>> Graph<VertexCollection, Vertex, Rest...>::findNTuples() {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::tuple<std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Edge>,
+                  std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Path3>,
+                  std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Path4>> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::findNTuples() const {
     auto tuple = std::make_tuple(std::vector<Edge>(), std::vector<Path3>(), std::vector<Path4>());
     findNTuples([&](const Edge &edge) {
         std::get<0>(tuple).push_back(edge);
@@ -254,23 +480,111 @@ inline std::tuple<std::vector<typename Graph<VertexCollection, Vertex, Rest...>:
     return tuple;
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::addVertexNeighbor(Vertex &v1, PersistentVertexIndex v2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex>
+Graph<VertexCollection, Vertex, Instrumentation, Rest...>::commonNeighbors(PersistentVertexIndex v1,
+                                                                          PersistentVertexIndex v2) const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::commonNeighbors);
+    const auto &neighbors1 = _vertices.at(v1).neighbors();
+    const auto &neighbors2 = _vertices.at(v2).neighbors();
+    std::vector<PersistentVertexIndex> common;
+    detail::forEachCommonNeighbor<SortedNeighbors>(neighbors1.begin(), neighbors1.end(),
+                                                   neighbors2.begin(), neighbors2.end(), [&common](auto neighbor) {
+        common.push_back(neighbor);
+    });
+    if constexpr (!SortedNeighbors) {
+        std::sort(common.begin(), common.end());
+    }
+    return common;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::size_t Graph<VertexCollection, Vertex, Instrumentation, Rest...>::countTriangles() const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::countTriangles);
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
+    std::size_t nTriangles {0};
+    for (auto it = _vertices.cbegin_persistent(); it != _vertices.cend_persistent(); ++it) {
+        if (it->deactivated()) {
+            continue;
+        }
+        auto ix1 = _vertices.persistentIndex(it);
+        const auto &neighbors1 = it->neighbors();
+        for (auto ix2 : neighbors1) {
+            if (ix2 <= ix1) {
+                continue;
+            }
+            // third vertices larger than ix2, so that every triangle is counted once
+            const auto &neighbors2 = _vertices.at(ix2).neighbors();
+            auto larger = [ix2](const auto &neighbors) {
+                if constexpr (SortedNeighbors) {
+                    return std::upper_bound(neighbors.begin(), neighbors.end(), ix2);
+                } else {
+                    return neighbors.begin();
+                }
+            };
+            detail::forEachCommonNeighbor<SortedNeighbors>(larger(neighbors1), neighbors1.end(),
+                                                           larger(neighbors2), neighbors2.end(),
+                                                           [&nTriangles, ix2](auto ix3) {
+                nTriangles += ix2 < ix3;
+            });
+        }
+    }
+    return nTriangles;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::size_t Graph<VertexCollection, Vertex, Instrumentation, Rest...>::countFourCycles() const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::countFourCycles);
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
+    std::size_t nDiagonals {0};
+    // the last vertex for which a slot was considered as opposite corner, to intersect each pair only once
+    std::vector<std::size_t> seen(_vertices.size_persistent(), npos);
+    for (auto it = _vertices.cbegin_persistent(); it != _vertices.cend_persistent(); ++it) {
+        if (it->deactivated()) {
+            continue;
+        }
+        auto ix1 = _vertices.persistentIndex(it);
+        const auto &neighbors1 = it->neighbors();
+        for (auto middle : neighbors1) {
+            for (auto ix2 : _vertices.at(middle).neighbors()) {
+                if (ix2 <= ix1 || seen[ix2.value] == ix1.value) {
+                    continue;
+                }
+                seen[ix2.value] = ix1.value;
+                // corners adjacent to both ends of the diagonal (ix1, ix2), self-loops excluded
+                const auto &neighbors2 = _vertices.at(ix2).neighbors();
+                std::size_t nCorners {0};
+                detail::forEachCommonNeighbor<SortedNeighbors>(neighbors1.begin(), neighbors1.end(),
+                                                               neighbors2.begin(), neighbors2.end(),
+                                                               [&nCorners, ix1, ix2](auto corner) {
+                    nCorners += corner != ix1 && corner != ix2;
+                });
+                nDiagonals += nCorners * (nCorners - 1) / 2;
+            }
+        }
+    }
+    return nDiagonals / 2;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::addVertexNeighbor(typename VertexList::reference v1, PersistentVertexIndex v2) {
     v1.addNeighbor(v2);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeVertexNeighbor(Vertex &v1, PersistentVertexIndex v2) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeVertexNeighbor(typename VertexList::reference v1, PersistentVertexIndex v2) {
     v1.removeNeighbor(v2);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
 template<typename T1, typename T2>
-std::int32_t Graph<VertexCollection, Vertex, Rest...>::graphDistance(T1 it1, T2 it2) const {
+std::int32_t Graph<VertexCollection, Vertex, Instrumentation, Rest...>::graphDistance(T1 it1, T2 it2) const {
     const_persistent_iterator it1Persistent = toPersistentIterator(it1);
     const_persistent_iterator it2Persistent = toPersistentIterator(it2);
-    PersistentIndex ixSource = _vertices.persistentIndex(it1Persistent);
-    PersistentIndex ixTarget = _vertices.persistentIndex(it2Persistent);
+    PersistentVertexIndex ixSource = _vertices.persistentIndex(it1Persistent);
+    PersistentVertexIndex ixTarget = _vertices.persistentIndex(it2Persistent);
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::graphDistance);
+    instrumentation().count(Counter::bfsPasses);
 
     std::vector<char> visited (_vertices.size_persistent(), false);
     std::vector<std::int32_t> dists (_vertices.size_persistent(), 0);
@@ -283,6 +597,7 @@ std::int32_t Graph<VertexCollection, Vertex, Rest...>::graphDistance(T1 it1, T2
         auto ix = unvisited.front();
         unvisited.pop();
         auto dCurr = dists[ix.value];
+        instrumentation().count(Counter::visitedVertices);
 
         const auto &vertex = _vertices.at(ix);
         for(auto neighbor : vertex.neighbors()) {
@@ -306,9 +621,11 @@ std::int32_t Graph<VertexCollection, Vertex, Rest...>::graphDistance(T1 it1, T2
     return -1;
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline bool Graph<VertexCollection, Vertex, Rest...>::isConnected() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::isConnected() const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::isConnected);
     if(_vertices.empty()) return true;
+    instrumentation().count(Counter::bfsPasses);
 
     std::vector<char> visited (_vertices.size_persistent(), false);
 
@@ -337,32 +654,37 @@ inline bool Graph<VertexCollection, Vertex, Rest...>::isConnected() const {
             }
         }
     }
+    instrumentation().count(Counter::visitedVertices, nVisited);
     return nVisited == _vertices.size();
 }
 
-template<template <typename...>class VertexCollection, typename Vertex, typename... Rest>
-inline auto Graph<VertexCollection, Vertex, Rest...>::connectedComponents() -> std::vector<Graph>{
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline auto Graph<VertexCollection, Vertex, Instrumentation, Rest...>::connectedComponents() const -> std::vector<Graph>{
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::connectedComponents);
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
     std::vector<VertexList> subVertexLists {};
     {
         std::vector<std::vector<PersistentVertexIndex>> components {};
         std::vector<char> visited (_vertices.size_persistent(), false);
 
         for(std::size_t ix = 0; ix < _vertices.size_persistent(); ++ix) {
-            if(!_vertices.at(PersistentVertexIndex{ix}).deactivated() && !visited.at(ix)) {
+            if(!(_vertices.begin_persistent() + ix)->deactivated() && !visited.at(ix)) {
                 // got a new component
+                instrumentation().count(Counter::bfsPasses);
                 components.emplace_back();
                 subVertexLists.emplace_back();
 
                 auto& component = components.back();
 
                 std::vector<PersistentVertexIndex> unvisitedInComponent;
-                unvisitedInComponent.emplace_back(PersistentVertexIndex{ix});
+                unvisitedInComponent.emplace_back(PersistentVertexIndex::of(ix));
                 while (!unvisitedInComponent.empty()) {
                     auto vertexIndex = unvisitedInComponent.back();
                     unvisitedInComponent.pop_back();
                     if (!visited.at(vertexIndex.value)) {
                         visited.at(vertexIndex.value) = true;
                         component.emplace_back(vertexIndex);
+                        instrumentation().count(Counter::visitedVertices);
                         for (auto neighbor : _vertices.at(vertexIndex).neighbors()) {
                             if (!visited.at(neighbor.value)) {
                                 unvisitedInComponent.emplace_back(neighbor);
@@ -378,35 +700,33 @@ inline auto Graph<VertexCollection, Vertex, Rest...>::connectedComponents() -> s
             auto itComponents = components.begin();
             auto itSubLists = subVertexLists.begin();
 
-            // mapping (previous vertex index) -> (new vertex index)
-            std::vector<std::vector<PersistentVertexIndex>> reverseMappings;
-            {
-                reverseMappings.reserve(components.size());
-                for(const auto &component : components) {
-                    std::vector<PersistentVertexIndex> reverseMapping {};
-                    reverseMapping.resize(_vertices.size_persistent());
-                    for(std::size_t i = 0; i < component.size(); ++i) {
-                        reverseMapping[component.at(i).value] = PersistentVertexIndex{i};
-                    }
-                    reverseMappings.push_back(std::move(reverseMapping));
+            // mapping (previous vertex index) -> (new vertex index), every vertex belongs to exactly one component
+            std::vector<PersistentVertexIndex> reverseMapping(_vertices.size_persistent());
+            for (const auto &component : components) {
+                for (std::size_t i = 0; i < component.size(); ++i) {
+                    reverseMapping[component[i].value] = PersistentVertexIndex::of(i);
                 }
             }
 
-            auto itReverseMappings = reverseMappings.begin();
-
-            for(; itComponents != components.end(); ++itComponents, ++itSubLists, ++itReverseMappings) {
+            for(; itComponents != components.end(); ++itComponents, ++itSubLists) {
+                itSubLists->reserve(itComponents->size());
                 for(std::size_t i = 0; i < (*itComponents).size(); ++i) {
-                    auto previousVertexIndex = itComponents->at(i);
+                    auto previousVertexIndex = (*itComponents)[i];
                     itSubLists->push_back(_vertices.at(previousVertexIndex));
-                    for(auto &neighborIndex : (itSubLists->end()-1)->neighbors()) {
-                        neighborIndex = itReverseMappings->at(neighborIndex.value);
+                    auto &neighbors = (itSubLists->end()-1)->neighbors();
+                    for(auto &neighborIndex : neighbors) {
+                        neighborIndex = reverseMapping[neighborIndex.value];
+                    }
+                    if constexpr (SortedNeighbors) {
+                        // the vertices are numbered in the order of traversal
+                        std::sort(neighbors.begin(), neighbors.end());
                     }
                 }
             }
         }
     }
 
-    std::vector<Graph<VertexCollection, Vertex, Rest...>> subGraphs {};
+    std::vector<Graph<VertexCollection, Vertex, Instrumentation, Rest...>> subGraphs {};
     subGraphs.reserve(subVertexLists.size());
     {
         for (auto &subVertexList : subVertexLists) {
@@ -416,23 +736,234 @@ inline auto Graph<VertexCollection, Vertex, Rest...>::connectedComponents() -> s
     return std::move(subGraphs);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline void Graph<VertexCollection, Vertex, Rest...>::removeNeighborsEdges(PersistentVertexIndex ix) {
-    auto &vertex = *(_vertices.begin_persistent() + ix.value);
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline auto Graph<VertexCollection, Vertex, Instrumentation, Rest...>::reorder(ReorderStrategy strategy)
+        -> std::vector<PersistentVertexIndex> {
+    if (journaling()) {
+        throw std::logic_error("Cannot reorder a graph while journaling.");
+    }
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::reorder);
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
+
+    // read-only access, so that copy-on-write storage is not duplicated
+    const auto &vertices = _vertices;
+    auto degree = [&vertices](PersistentVertexIndex ix) {
+        return vertices.at(ix).neighbors().size();
+    };
+    // the new order in terms of the old persistent indices
+    std::vector<PersistentVertexIndex> order;
+    order.reserve(_vertices.size());
+    std::vector<char> visited(_vertices.size_persistent(), false);
+
+    // breadth-first traversal appending to the order, optionally with the neighbors of each vertex by ascending degree
+    auto traverse = [&](PersistentVertexIndex root, bool byDegree) {
+        instrumentation().count(Counter::bfsPasses);
+        auto first = order.size();
+        visited[root.value] = true;
+        order.push_back(root);
+        for (auto next = first; next < order.size(); ++next) {
+            auto nQueued = order.size();
+            for (auto neighbor : vertices.at(order[next]).neighbors()) {
+                if (!visited[neighbor.value]) {
+                    visited[neighbor.value] = true;
+                    order.push_back(neighbor);
+                }
+            }
+            if (byDegree) {
+                std::stable_sort(order.begin() + nQueued, order.end(), [&degree](auto ix1, auto ix2) {
+                    return degree(ix1) < degree(ix2);
+                });
+            }
+        }
+        instrumentation().count(Counter::visitedVertices, order.size() - first);
+    };
+
+    switch (strategy) {
+        case ReorderStrategy::bfs: {
+            for (auto it = _vertices.begin(); it != _vertices.end(); ++it) {
+                if (!visited[it.persistent_index().value]) {
+                    traverse(it.persistent_index(), false);
+                }
+            }
+            break;
+        }
+        case ReorderStrategy::reverseCuthillMcKee: {
+            // breadth-first levels of the component of a root, which is left in traversal order in the queue
+            std::vector<std::size_t> levels(_vertices.size_persistent(), npos);
+            std::vector<PersistentVertexIndex> queue;
+            auto traverseLevels = [&](PersistentVertexIndex root) {
+                instrumentation().count(Counter::bfsPasses);
+                for (auto ix : queue) {
+                    levels[ix.value] = npos;
+                }
+                queue.clear();
+                levels[root.value] = 0;
+                queue.push_back(root);
+                for (std::size_t next = 0; next < queue.size(); ++next) {
+                    auto level = levels[queue[next].value];
+                    for (auto neighbor : vertices.at(queue[next]).neighbors()) {
+                        if (levels[neighbor.value] == npos) {
+                            levels[neighbor.value] = level + 1;
+                            queue.push_back(neighbor);
+                        }
+                    }
+                }
+                instrumentation().count(Counter::visitedVertices, queue.size());
+                return levels[queue.back().value];
+            };
+            for (auto it = _vertices.begin(); it != _vertices.end(); ++it) {
+                if (!visited[it.persistent_index().value]) {
+                    // pseudo-peripheral vertex (George-Liu): restart from a vertex of minimum degree in the last level
+                    // as long as that increases the eccentricity
+                    auto root = it.persistent_index();
+                    auto eccentricity = traverseLevels(root);
+                    while (true) {
+                        auto candidate = queue.back();
+                        for (auto ix = queue.rbegin(); ix != queue.rend() && levels[ix->value] == eccentricity; ++ix) {
+                            if (degree(*ix) < degree(candidate)) {
+                                candidate = *ix;
+                            }
+                        }
+                        auto candidateEccentricity = traverseLevels(candidate);
+                        root = candidate;
+                        if (candidateEccentricity <= eccentricity) {
+                            break;
+                        }
+                        eccentricity = candidateEccentricity;
+                    }
+                    traverse(root, true);
+                }
+            }
+            std::reverse(order.begin(), order.end());
+            break;
+        }
+        case ReorderStrategy::chain: {
+            // depth-first, continuing with the first unvisited neighbor and resuming the other branches later
+            std::vector<PersistentVertexIndex> stack;
+            auto follow = [&](PersistentVertexIndex root) {
+                instrumentation().count(Counter::bfsPasses);
+                auto first = order.size();
+                stack.push_back(root);
+                while (!stack.empty()) {
+                    auto ix = stack.back();
+                    stack.pop_back();
+                    if (!visited[ix.value]) {
+                        visited[ix.value] = true;
+                        order.push_back(ix);
+                        const auto &neighbors = vertices.at(ix).neighbors();
+                        for (auto i = neighbors.size(); i-- > 0;) {
+                            if (!visited[neighbors[i].value]) {
+                                stack.push_back(neighbors[i]);
+                            }
+                        }
+                    }
+                }
+                instrumentation().count(Counter::visitedVertices, order.size() - first);
+            };
+            // chains are entered at their ends, what is left are rings and components without ends
+            for (auto it = _vertices.begin(); it != _vertices.end(); ++it) {
+                if (!visited[it.persistent_index().value] && degree(it.persistent_index()) <= 1) {
+                    follow(it.persistent_index());
+                }
+            }
+            for (auto it = _vertices.begin(); it != _vertices.end(); ++it) {
+                if (!visited[it.persistent_index().value]) {
+                    follow(it.persistent_index());
+                }
+            }
+            break;
+        }
+    }
+
+    std::vector<PersistentVertexIndex> mapping(_vertices.size_persistent());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        mapping[order[i].value] = PersistentVertexIndex::of(i);
+    }
+    if (tracking()) {
+        for (std::size_t i = 0; i < _vertices.size_persistent(); ++i) {
+            touch(PersistentVertexIndex::of(i));
+        }
+    }
+
+    auto reordered = [this] {
+        if constexpr (std::is_constructible_v<VertexList, const allocator_type &>) {
+            return VertexList(_vertices.get_allocator());
+        } else {
+            return VertexList();
+        }
+    }();
+    reordered.set_blank_reuse(_vertices.blank_reuse());
+    reordered.reserve(order.size());
+    for (auto ix : order) {
+        // copied rather than moved, so that the neighbor lists are allocated in the new order as well
+        reordered.push_back(vertices.at(ix));
+        auto &neighbors = (reordered.end() - 1)->neighbors();
+        for (auto &neighbor : neighbors) {
+            neighbor = mapping[neighbor.value];
+        }
+        if constexpr (SortedNeighbors) {
+            std::sort(neighbors.begin(), neighbors.end());
+        }
+    }
+    _vertices = std::move(reordered);
+    for (auto &edge : _edges) {
+        edge = std::make_tuple(mapping[std::get<0>(edge).value], mapping[std::get<1>(edge).value]);
+    }
+    return mapping;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::removeNeighborsEdges(PersistentVertexIndex ix) {
+    auto &&vertex = *(_vertices.begin_persistent() + ix.value);
     std::for_each(std::begin(vertex.neighbors()), std::end(vertex.neighbors()), [this, ix](const auto neighbor) {
         removeVertexNeighbor(_vertices.at(neighbor), ix);
     });
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::size_t Graph<VertexCollection, Vertex, Rest...>::nEdges() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::checkDegree(PersistentVertexIndex ix, std::size_t degree) {
+    if (degree > MaxDegree) {
+        throw std::length_error(fmt::format("Vertex {} would exceed the maximum degree {}.", ix.value, MaxDegree));
+    }
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::size_t Graph<VertexCollection, Vertex, Instrumentation, Rest...>::nEdges() const {
     return edges().size();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Rest...>::append(const Graph &other) {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::append(const Graph &other) {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::append);
     std::vector<PersistentVertexIndex> indexMapping;
     indexMapping.resize(other.vertices().size_persistent());
+    if (!journaling() && _vertices.n_deactivated() == 0 && other._vertices.n_deactivated() == 0) {
+        // without blanks the mapping is a shift, copy the vertices in bulk and shift their neighbors and the edges
+        auto nEdges = other._edges.size();
+        auto offset = _vertices.append(other._vertices);
+        for (std::size_t ix = 0; ix < indexMapping.size(); ++ix) {
+            indexMapping[ix] = PersistentVertexIndex::of(offset + ix);
+        }
+        if (offset > 0) {
+            for (auto it = _vertices.begin_persistent() + offset; it != _vertices.end_persistent(); ++it) {
+                for (auto &neighbor : it->neighbors()) {
+                    neighbor = PersistentVertexIndex::of(neighbor.value + offset);
+                }
+            }
+        }
+        _edges.reserve(_edges.size() + nEdges);
+        for (std::size_t i = 0; i < nEdges; ++i) {
+            const auto [ix1, ix2] = other._edges[i];
+            _edges.push_back(std::make_tuple(PersistentVertexIndex::of(ix1.value + offset),
+                                             PersistentVertexIndex::of(ix2.value + offset)));
+        }
+        if (tracking()) {
+            for (auto ix : indexMapping) {
+                touch(ix);
+            }
+        }
+        return indexMapping;
+    }
     // insert vertices
     {
         std::size_t ix{0};
@@ -451,7 +982,7 @@ inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Persistent
                 auto newIndex = indexMapping.at(ix);
                 for(auto neighborIndex : it->neighbors()) {
                     // only add once since neighbors are bidirectional
-                    if(ix < neighborIndex.value) {
+                    if(ix <= neighborIndex.value) {
                         addEdge(newIndex, indexMapping.at(neighborIndex.value));
                     }
                 }
@@ -461,24 +992,24 @@ inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Persistent
     return std::move(indexMapping);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Rest...>::append(
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::append(
         const Graph &other,
         ActiveVertexIndex edgeIndexThis,
         ActiveVertexIndex edgeIndexOther) {
     return append(other, (begin() + edgeIndexThis).persistent_index(), (other.begin() + edgeIndexOther).persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Rest...>::append(
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::append(
         const Graph &other,
         iterator itThis,
         iterator itOther) {
     return append(other, itThis.persistent_index(), itOther.persistent_index());
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Rest...>::append(
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::append(
         const Graph &other,
         persistent_iterator itThis,
         persistent_iterator itOther) {
@@ -486,8 +1017,8 @@ inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Persistent
 }
 
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Rest...>::append(
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::append(
         const Graph &other,
         PersistentVertexIndex edgeIndexThis,
         PersistentVertexIndex edgeIndexOther) {
@@ -496,101 +1027,851 @@ inline std::vector<typename Graph<VertexCollection, Vertex, Rest...>::Persistent
     return std::move(mapping);
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::size_type Graph<VertexCollection, Vertex, Rest...>::nVertices() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::size_type Graph<VertexCollection, Vertex, Instrumentation, Rest...>::nVertices() const {
     return _vertices.size();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline std::string Graph<VertexCollection, Vertex, Rest...>::gexf() const {
-    std::ostringstream ss;
-    ss << R"(<?xml version="1.0" encoding="UTF-8"?>)";
-    ss << R"(<gexf xmlns="http://www.gexf.net/1.2draft" version="1.2">)";
-    ss << R"(<graph mode="static" defaultedgetype="undirected">)";
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::string Graph<VertexCollection, Vertex, Instrumentation, Rest...>::gexf() const {
+    [[maybe_unused]] auto scope = instrumentation().scope(Operation::gexf);
+    instrumentation().count(Counter::skippedBlanks, _vertices.n_deactivated());
+    fmt::memory_buffer buffer;
+    exportGraph(*this, buffer, ExportFormat::gexf);
+    return fmt::to_string(buffer);
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::write(std::ostream &os) const {
+    using Data = typename Vertex::data_type;
+    auto nSlots = _vertices.size_persistent();
+    std::size_t nNeighbors = 0;
+    for (auto it = _vertices.cbegin_persistent(); it != _vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            nNeighbors += it->neighbors().size();
+        }
+    }
+
+    BinaryWriter writer(os);
+    writer.writeBytes(detail::graphFormatMagic, sizeof(detail::graphFormatMagic));
+    writer.write(detail::graphFormatVersion);
+    writer.write(static_cast<std::uint32_t>(std::tuple_size_v<Data>));
+    detail::forEachField<Data>([&writer](auto field) {
+        writer.write(detail::fieldCode<std::tuple_element_t<field, Data>>());
+    });
+    writer.write(static_cast<std::uint64_t>(nSlots));
+    writer.write(static_cast<std::uint64_t>(_vertices.n_deactivated()));
+    writer.write(static_cast<std::uint64_t>(nNeighbors));
+    writer.write(static_cast<std::uint64_t>(_edges.size()));
+
+    for (std::size_t i = 0; i < nSlots; ++i) {
+        if ((_vertices.cbegin_persistent() + i)->deactivated()) {
+            writer.write(static_cast<std::uint64_t>(i));
+        }
+    }
+
+    typename detail::data_columns<Data>::type columns;
+    for (std::size_t first = 0; first < nSlots; first += detail::graphFormatBlockSize) {
+        auto last = std::min(nSlots, first + detail::graphFormatBlockSize);
+        detail::forEachField<Data>([&](auto field) {
+            using T = std::tuple_element_t<field, Data>;
+            if constexpr (detail::bulk_serializable_v<T>) {
+                auto &column = std::get<field>(columns);
+                column.clear();
+                for (auto it = _vertices.cbegin_persistent() + first; it != _vertices.cbegin_persistent() + last; ++it) {
+                    column.push_back(detail::dataField<field>(*it));
+                }
+                writer.writeArray(column.data(), column.size());
+            } else {
+                for (auto it = _vertices.cbegin_persistent() + first; it != _vertices.cbegin_persistent() + last; ++it) {
+                    Serializer<T>::write(writer, detail::dataField<field>(*it));
+                }
+            }
+        });
+    }
+
+    std::uint64_t offset = 0;
+    writer.write(offset);
+    for (auto it = _vertices.cbegin_persistent(); it != _vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            offset += it->neighbors().size();
+        }
+        writer.write(offset);
+    }
+    for (auto it = _vertices.cbegin_persistent(); it != _vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            detail::writeIndices(writer, it->neighbors().data(), it->neighbors().size());
+        }
+    }
+
+    // the edge list goes out in blocks of flattened index pairs
+    std::vector<PersistentVertexIndex> edgeBlock;
+    edgeBlock.reserve(2 * std::min(_edges.size(), detail::graphFormatBlockSize));
+    for (std::size_t first = 0; first < _edges.size(); first += detail::graphFormatBlockSize) {
+        auto last = std::min(_edges.size(), first + detail::graphFormatBlockSize);
+        edgeBlock.clear();
+        for (auto it = _edges.cbegin() + first; it != _edges.cbegin() + last; ++it) {
+            edgeBlock.push_back(std::get<0>(*it));
+            edgeBlock.push_back(std::get<1>(*it));
+        }
+        detail::writeIndices(writer, edgeBlock.data(), edgeBlock.size());
+    }
+    writer.flush();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::read(
+        std::istream &is, const allocator_type &allocator) {
+    using Data = typename Vertex::data_type;
+    BinaryReader reader(is);
+
+    char magic[sizeof(detail::graphFormatMagic)];
+    reader.readBytes(magic, sizeof(magic));
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(detail::graphFormatMagic))) {
+        throw std::runtime_error("Not a graph in binary format.");
+    }
+    auto version = reader.read<std::uint32_t>();
+    if (version != detail::graphFormatVersion) {
+        throw std::runtime_error(fmt::format("Unsupported graph format version {}.", version));
+    }
+    if (reader.read<std::uint32_t>() != std::tuple_size_v<Data>) {
+        throw std::runtime_error("The graph was written with another vertex data layout.");
+    }
+    detail::forEachField<Data>([&reader](auto field) {
+        if (reader.read<std::uint32_t>() != detail::fieldCode<std::tuple_element_t<field, Data>>()) {
+            throw std::runtime_error("The graph was written with another vertex data layout.");
+        }
+    });
+    auto nSlots = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    auto nBlanks = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    auto nNeighbors = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    auto nEdges = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    if (nBlanks > nSlots) {
+        throw std::runtime_error("Corrupt graph data: more blanks than vertices.");
+    }
+
+    std::vector<PersistentVertexIndex> blanks;
+    blanks.reserve(nBlanks);
+    for (std::size_t i = 0; i < nBlanks; ++i) {
+        blanks.push_back(detail::readIndex<PersistentVertexIndex>(reader, nSlots));
+        if (i > 0 && blanks[i] <= blanks[i - 1]) {
+            throw std::runtime_error("Corrupt graph data: blanks are not sorted.");
+        }
+    }
+
+    auto graph = [&allocator] {
+        if constexpr (std::is_constructible_v<EdgeList, const allocator_type &>) {
+            return Graph(allocator);
+        } else {
+            return Graph();
+        }
+    }();
+    graph._vertices.reserve(nSlots);
+    typename detail::data_columns<Data>::type columns;
+    for (std::size_t first = 0; first < nSlots; first += detail::graphFormatBlockSize) {
+        auto count = std::min(nSlots, first + detail::graphFormatBlockSize) - first;
+        detail::forEachField<Data>([&](auto field) {
+            using T = std::tuple_element_t<field, Data>;
+            auto &column = std::get<field>(columns);
+            column.resize(count);
+            if constexpr (detail::bulk_serializable_v<T>) {
+                reader.readArray(column.data(), count);
+            } else {
+                for (auto &value : column) {
+                    Serializer<T>::read(reader, value);
+                }
+            }
+        });
+        for (std::size_t i = 0; i < count; ++i) {
+            graph._vertices.emplace_back(std::apply([i](auto &... column) {
+                return Data{std::move(column[i])...};
+            }, columns));
+        }
+    }
+
+    std::vector<std::uint64_t> offsets(nSlots + 1);
+    reader.readArray(offsets.data(), offsets.size());
+    if (offsets.front() != 0 || offsets.back() != nNeighbors ||
+        !std::is_sorted(offsets.begin(), offsets.end())) {
+        throw std::runtime_error("Corrupt graph data: invalid neighbor offsets.");
+    }
+    for (std::size_t i = 0; i < nSlots; ++i) {
+        auto &neighbors = (graph._vertices.begin_persistent() + i)->neighbors();
+        neighbors.resize(offsets[i + 1] - offsets[i]);
+        detail::readIndices(reader, neighbors.data(), neighbors.size(), nSlots);
+        if constexpr (SortedNeighbors) {
+            // the data may have been written by a graph with unsorted neighbor lists
+            if (!std::is_sorted(neighbors.begin(), neighbors.end())) {
+                std::sort(neighbors.begin(), neighbors.end());
+            }
+        }
+    }
+
+    graph._edges.reserve(nEdges);
+    std::vector<PersistentVertexIndex> edgeBlock;
+    for (std::size_t first = 0; first < nEdges; first += detail::graphFormatBlockSize) {
+        edgeBlock.resize(2 * (std::min(nEdges, first + detail::graphFormatBlockSize) - first));
+        detail::readIndices(reader, edgeBlock.data(), edgeBlock.size(), nSlots);
+        for (std::size_t i = 0; i < edgeBlock.size(); i += 2) {
+            graph._edges.push_back(std::make_tuple(edgeBlock[i], edgeBlock[i + 1]));
+        }
+    }
+
+    graph._vertices.erase_persistent(blanks.begin(), blanks.end());
+    reader.release();
+    return graph;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch Graph<VertexCollection, Vertex, Instrumentation, Rest...>::batch() {
+    return Batch(*this);
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::Batch(Graph &graph)
+        : _graph(&graph), _uncaughtExceptions(std::uncaught_exceptions()) {}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::Batch(Batch &&other) noexcept
+        : _graph(other._graph), _edgeOperations(std::move(other._edgeOperations)),
+          _removedVertices(std::move(other._removedVertices)), _uncaughtExceptions(other._uncaughtExceptions) {
+    other._graph = nullptr;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::~Batch() {
+    // an exception thrown since the batch was opened may have left it half-recorded
+    if (_graph && std::uncaught_exceptions() <= _uncaughtExceptions) {
+        try {
+            commit();
+        } catch (const std::length_error &) {
+            // a vertex would have exceeded MaxDegree, commit() applied nothing
+        }
+    }
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::addVertex(typename Vertex::data_type data) {
+    return _graph->addVertex(std::move(data));
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::addEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
+    const auto &vertices = _graph->_vertices;
+    if ((vertices.begin_persistent() + ix1.value)->deactivated() ||
+        (vertices.begin_persistent() + ix2.value)->deactivated()) {
+        throw std::invalid_argument("Tried adding an edge between vertices of which at least one was deactivated.");
+    }
+    _edgeOperations.emplace_back(ix1 < ix2 ? std::make_tuple(ix1, ix2) : std::make_tuple(ix2, ix1), true);
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::addEdge(const Edge &edge) {
+    addEdge(std::get<0>(edge), std::get<1>(edge));
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::removeEdge(PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
+    const auto &vertices = _graph->_vertices;
+    if ((vertices.begin_persistent() + ix1.value)->deactivated() ||
+        (vertices.begin_persistent() + ix2.value)->deactivated()) {
+        throw std::invalid_argument("Tried removing an edge between vertices of which at least one was deactivated.");
+    }
+    _edgeOperations.emplace_back(ix1 < ix2 ? std::make_tuple(ix1, ix2) : std::make_tuple(ix2, ix1), false);
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::removeEdge(const Edge &edge) {
+    removeEdge(std::get<0>(edge), std::get<1>(edge));
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::removeVertex(PersistentVertexIndex ix) {
+    if ((_graph->_vertices.begin_persistent() + ix.value)->deactivated()) {
+        throw std::invalid_argument("Tried removing a deactivated vertex.");
+    }
+    _removedVertices.push_back(ix);
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::size_t Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::nPending() const {
+    return _edgeOperations.size() + _removedVertices.size();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::Batch::commit() {
+    if (_edgeOperations.empty() && _removedVertices.empty()) {
+        return;
+    }
+    auto &vertices = _graph->_vertices;
+
+    std::sort(_removedVertices.begin(), _removedVertices.end());
+    _removedVertices.erase(std::unique(_removedVertices.begin(), _removedVertices.end()), _removedVertices.end());
+    auto isRemoved = [this](PersistentVertexIndex ix) {
+        return std::binary_search(_removedVertices.begin(), _removedVertices.end(), ix);
+    };
+    auto isNeighbor = [&vertices](PersistentVertexIndex ix1, PersistentVertexIndex ix2) {
+        const auto &neighbors1 = vertices.at(ix1).neighbors();
+        const auto &neighbors2 = vertices.at(ix2).neighbors();
+        if constexpr (SortedNeighbors) {
+            return std::binary_search(neighbors1.begin(), neighbors1.end(), ix2);
+        }
+        if (neighbors1.size() <= neighbors2.size()) {
+            return detail::findNeighbor(neighbors1, ix2) != neighbors1.end();
+        }
+        return detail::findNeighbor(neighbors2, ix1) != neighbors2.end();
+    };
+
+    // resolve the operations per edge (the last one wins) against the current state of the graph
+    std::vector<Edge> addedEdges;
+    std::vector<Edge> removedEdges;
+    {
+        std::stable_sort(_edgeOperations.begin(), _edgeOperations.end(), [](const auto &op1, const auto &op2) {
+            return std::get<0>(op1) < std::get<0>(op2);
+        });
+        for (auto it = _edgeOperations.begin(); it != _edgeOperations.end();) {
+            auto next = std::find_if(it, _edgeOperations.end(), [it](const auto &op) {
+                return std::get<0>(op) != std::get<0>(*it);
+            });
+            const auto &[edge, add] = *std::prev(next);
+            const auto &[ix1, ix2] = edge;
+            if (!isRemoved(ix1) && !isRemoved(ix2)) {
+                auto exists = isNeighbor(ix1, ix2);
+                if (add && !exists) {
+                    addedEdges.push_back(edge);
+                } else if (!add && exists) {
+                    removedEdges.push_back(edge);
+                }
+            }
+            it = next;
+        }
+    }
+
+    if constexpr (MaxDegree > 0) {
+        // check the net degree of every affected vertex before anything is applied
+        std::vector<std::tuple<PersistentVertexIndex, int>> degreeChanges;
+        for (const auto &[ix1, ix2] : addedEdges) {
+            degreeChanges.emplace_back(ix1, 1);
+            if (ix1 != ix2) {
+                degreeChanges.emplace_back(ix2, 1);
+            }
+        }
+        for (const auto &[ix1, ix2] : removedEdges) {
+            degreeChanges.emplace_back(ix1, -1);
+            if (ix1 != ix2) {
+                degreeChanges.emplace_back(ix2, -1);
+            }
+        }
+        for (auto ix : _removedVertices) {
+            for (auto neighbor : vertices.at(ix).neighbors()) {
+                if (!isRemoved(neighbor)) {
+                    degreeChanges.emplace_back(neighbor, -1);
+                }
+            }
+        }
+        std::sort(degreeChanges.begin(), degreeChanges.end());
+        for (auto it = degreeChanges.begin(); it != degreeChanges.end();) {
+            auto ix = std::get<0>(*it);
+            auto degree = static_cast<std::ptrdiff_t>(vertices.at(ix).neighbors().size());
+            for (; it != degreeChanges.end() && std::get<0>(*it) == ix; ++it) {
+                degree += std::get<1>(*it);
+            }
+            if (degree > static_cast<std::ptrdiff_t>(MaxDegree)) {
+                _edgeOperations.clear();
+                _removedVertices.clear();
+                checkDegree(ix, static_cast<std::size_t>(degree));
+            }
+        }
+    }
+
+    if (_graph->journaling()) {
+        // apply one by one so that every mutation is journaled
+        for (const auto &edge : removedEdges) {
+            _graph->removeEdge(edge);
+        }
+        for (const auto &edge : addedEdges) {
+            _graph->addEdge(edge);
+        }
+        for (auto ix : _removedVertices) {
+            _graph->removeVertex(ix);
+        }
+        _edgeOperations.clear();
+        _removedVertices.clear();
+        return;
+    }
+
+    // one update per affected neighbor list
     {
-        ss << "<nodes>";
-        std::size_t id = 0;
-        for (const auto &v : _vertices) {
-            if(!v.deactivated()) {
-                ss << fmt::format(R"(<node id="{}" />)", id);
+        // (vertex, neighbor, add)
+        std::vector<std::tuple<PersistentVertexIndex, PersistentVertexIndex, bool>> neighborChanges;
+        for (const auto &[ix1, ix2] : addedEdges) {
+            neighborChanges.emplace_back(ix1, ix2, true);
+            if (ix1 != ix2) {
+                neighborChanges.emplace_back(ix2, ix1, true);
+            }
+        }
+        for (const auto &[ix1, ix2] : removedEdges) {
+            neighborChanges.emplace_back(ix1, ix2, false);
+            if (ix1 != ix2) {
+                neighborChanges.emplace_back(ix2, ix1, false);
+            }
+        }
+        for (auto ix : _removedVertices) {
+            for (auto neighbor : vertices.at(ix).neighbors()) {
+                if (!isRemoved(neighbor)) {
+                    neighborChanges.emplace_back(neighbor, ix, false);
+                }
+            }
+        }
+        std::sort(neighborChanges.begin(), neighborChanges.end());
+
+        std::vector<PersistentVertexIndex> addedNeighbors;
+        std::vector<PersistentVertexIndex> removedNeighbors;
+        for (auto it = neighborChanges.begin(); it != neighborChanges.end();) {
+            auto ix = std::get<0>(*it);
+            auto &neighbors = vertices.at(ix).neighbors();
+            _graph->touch(ix);
+            addedNeighbors.clear();
+            removedNeighbors.clear();
+            for (; it != neighborChanges.end() && std::get<0>(*it) == ix; ++it) {
+                (std::get<2>(*it) ? addedNeighbors : removedNeighbors).push_back(std::get<1>(*it));
+            }
+            // removals first, so that bounded neighbor lists never hold more than their final number of neighbors
+            if (!removedNeighbors.empty()) {
+                neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [&removedNeighbors](auto neighbor) {
+                    return std::binary_search(removedNeighbors.begin(), removedNeighbors.end(), neighbor);
+                }), neighbors.end());
+            }
+            auto nKept = neighbors.size();
+            for (auto neighbor : addedNeighbors) {
+                neighbors.push_back(neighbor);
+            }
+            if constexpr (SortedNeighbors) {
+                // the added neighbors are sorted already
+                std::inplace_merge(neighbors.begin(), neighbors.begin() + nKept, neighbors.end());
             }
-            ++id;
         }
-        ss << "</nodes>";
     }
+
+    // one pass over the edge list
     {
-        ss << "<edges>";
-        std::size_t id = 0;
-        for(auto [i1, i2] : _edges) {
-            ss << fmt::format(R"(<edge id="{}" source="{}" target="{}" />)", id, i1.value, i2.value);
-            ++id;
+        auto &edges = _graph->_edges;
+        if (!removedEdges.empty() || !_removedVertices.empty()) {
+            auto isRemovedEdge = [&](const Edge &edge) {
+                const auto &[ix1, ix2] = edge;
+                if (isRemoved(ix1) || isRemoved(ix2)) {
+                    return true;
+                }
+                return std::binary_search(removedEdges.begin(), removedEdges.end(),
+                                          ix1 < ix2 ? std::make_tuple(ix1, ix2) : std::make_tuple(ix2, ix1));
+            };
+            auto first = std::find_if(edges.cbegin(), edges.cend(), isRemovedEdge);
+            if (first != edges.cend()) {
+                edges.erase(std::remove_if(edges.begin() + std::distance(edges.cbegin(), first), edges.end(),
+                                           isRemovedEdge), edges.end());
+            }
         }
-        ss << "</edges>";
+        edges.insert(edges.end(), addedEdges.begin(), addedEdges.end());
     }
-    ss << "</graph>";
-    ss << "</gexf>";
-    return ss.str();
+
+    for (auto ix : _removedVertices) {
+        _graph->touch(ix);
+    }
+    vertices.erase_persistent(_removedVertices.begin(), _removedVertices.end());
+
+    _edgeOperations.clear();
+    _removedVertices.clear();
 }
 
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::persistent_iterator Graph<VertexCollection, Vertex, Rest...>::begin_persistent() {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::persistent_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::begin_persistent() {
     return _vertices.begin_persistent();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Rest...>::begin_persistent() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::begin_persistent() const {
     return _vertices.cbegin_persistent();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Rest...>::cbegin_persistent() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::cbegin_persistent() const {
     return _vertices.cbegin_persistent();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::persistent_iterator Graph<VertexCollection, Vertex, Rest...>::end_persistent() {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::persistent_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::end_persistent() {
     return _vertices.end_persistent();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Rest...>::end_persistent() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::end_persistent() const {
     return _vertices.cend_persistent();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Rest...>::cend_persistent() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::const_persistent_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::cend_persistent() const {
     return _vertices.cend_persistent();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::iterator Graph<VertexCollection, Vertex, Rest...>::begin() {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::begin() {
     return _vertices.begin();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Rest...>::begin() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::begin() const {
     return _vertices.cbegin();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Rest...>::cbegin() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::cbegin() const {
     return _vertices.cbegin();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::iterator Graph<VertexCollection, Vertex, Rest...>::end() {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::end() {
     return _vertices.end();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Rest...>::end() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::end() const {
     return _vertices.cend();
 }
 
-template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
-inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Rest...>::cend() const {
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::VertexList::const_iterator Graph<VertexCollection, Vertex, Instrumentation, Rest...>::cend() const {
     return _vertices.cend();
 }
 
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Graph<VertexCollection, Vertex, Instrumentation, Rest...> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::snapshot() const {
+    return *this;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::checkpoint() {
+    _vertices.checkpoint();
+    _checkpoints.push_back(_journal.size());
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::rollback() {
+    if (_checkpoints.empty()) {
+        throw std::logic_error("Tried rolling back without checkpoint.");
+    }
+    if (tracking()) {
+        _vertices.for_each_journaled([this](auto ix) { touch(ix); });
+        for (auto it = _journal.begin() + _checkpoints.back(); it != _journal.end(); ++it) {
+            touch(std::get<0>(it->edge));
+            touch(std::get<1>(it->edge));
+        }
+    }
+    while (_journal.size() > _checkpoints.back()) {
+        const auto &entry = _journal.back();
+        // first undo the vertex list changes which happened after this mutation
+        _vertices.rollback_to(entry.verticesJournalSize);
+
+        const auto &[ix1, ix2] = entry.edge;
+        auto &neighbors1 = (_vertices.begin_persistent() + ix1.value)->neighbors();
+        auto &neighbors2 = (_vertices.begin_persistent() + ix2.value)->neighbors();
+        if (entry.added) {
+            _edges.erase(_edges.begin() + entry.edgePosition);
+            if (entry.neighborPosition2 != npos) {
+                neighbors2.erase(neighbors2.begin() + entry.neighborPosition2);
+            }
+            if (entry.neighborPosition1 != npos) {
+                neighbors1.erase(neighbors1.begin() + entry.neighborPosition1);
+            }
+        } else {
+            _edges.insert(_edges.begin() + entry.edgePosition, entry.edge);
+            if (entry.neighborPosition1 != npos) {
+                neighbors1.insert(neighbors1.begin() + entry.neighborPosition1, ix2);
+            }
+            if (entry.neighborPosition2 != npos) {
+                neighbors2.insert(neighbors2.begin() + entry.neighborPosition2, ix1);
+            }
+        }
+        _journal.pop_back();
+    }
+    _vertices.rollback();
+    _checkpoints.pop_back();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::commit() {
+    if (_checkpoints.empty()) {
+        throw std::logic_error("Tried committing without checkpoint.");
+    }
+    _vertices.commit();
+    _checkpoints.pop_back();
+    if (_checkpoints.empty()) {
+        _journal.clear();
+    }
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::journaling() const {
+    return !_checkpoints.empty();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::mark() {
+    _marker = ChangeMarker{_vertices.size(), _edges.size()};
+    _changed.clear();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::unmark() {
+    _marker.reset();
+    _changed.clear();
+    _changed.shrink_to_fit();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline bool Graph<VertexCollection, Vertex, Instrumentation, Rest...>::tracking() const {
+    return _marker.has_value();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::touch(PersistentVertexIndex ix) {
+    if (_marker) {
+        _changed.push_back(ix);
+    }
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::setData(PersistentVertexIndex ix,
+                                                                             typename Vertex::data_type data) {
+    _vertices.at(ix).setData(std::move(data));
+    touch(ix);
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline std::vector<typename Graph<VertexCollection, Vertex, Instrumentation, Rest...>::PersistentVertexIndex> Graph<VertexCollection, Vertex, Instrumentation, Rest...>::changedVertices() const {
+    auto changed = _changed;
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::writeDelta(std::ostream &os) const {
+    using Data = typename Vertex::data_type;
+    if (!_marker) {
+        throw std::logic_error("Tried writing a delta without change marker.");
+    }
+    auto changed = changedVertices();
+
+    BinaryWriter writer(os);
+    writer.writeBytes(detail::graphDeltaMagic, sizeof(detail::graphDeltaMagic));
+    writer.write(detail::graphDeltaVersion);
+    writer.write(static_cast<std::uint32_t>(std::tuple_size_v<Data>));
+    detail::forEachField<Data>([&writer](auto field) {
+        writer.write(detail::fieldCode<std::tuple_element_t<field, Data>>());
+    });
+    writer.write(static_cast<std::uint64_t>(_marker->nVertices));
+    writer.write(static_cast<std::uint64_t>(_marker->nEdges));
+    writer.write(static_cast<std::uint64_t>(_vertices.size_persistent()));
+    writer.write(static_cast<std::uint64_t>(changed.size()));
+    for (auto ix : changed) {
+        writer.write(static_cast<std::uint64_t>(ix.value));
+        // vertices past the end were added and removed again and the blanks were released by shrinkToFit()
+        auto active = ix.value < _vertices.size_persistent() && !(_vertices.cbegin_persistent() + ix.value)->deactivated();
+        writer.write(static_cast<std::uint8_t>(active));
+        if (active) {
+            const auto &vertex = *(_vertices.cbegin_persistent() + ix.value);
+            detail::forEachField<Data>([&writer, &vertex](auto field) {
+                Serializer<std::tuple_element_t<field, Data>>::write(writer, detail::dataField<field>(vertex));
+            });
+            writer.write(static_cast<std::uint64_t>(vertex.neighbors().size()));
+            detail::writeIndices(writer, vertex.neighbors().data(), vertex.neighbors().size());
+        }
+    }
+    writer.flush();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::applyDelta(std::istream &is) {
+    using Data = typename Vertex::data_type;
+    BinaryReader reader(is);
+
+    char magic[sizeof(detail::graphDeltaMagic)];
+    reader.readBytes(magic, sizeof(magic));
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(detail::graphDeltaMagic))) {
+        throw std::runtime_error("Not a graph delta.");
+    }
+    auto version = reader.read<std::uint32_t>();
+    if (version != detail::graphDeltaVersion) {
+        throw std::runtime_error(fmt::format("Unsupported graph delta version {}.", version));
+    }
+    if (reader.read<std::uint32_t>() != std::tuple_size_v<Data>) {
+        throw std::runtime_error("The delta was written with another vertex data layout.");
+    }
+    detail::forEachField<Data>([&reader](auto field) {
+        if (reader.read<std::uint32_t>() != detail::fieldCode<std::tuple_element_t<field, Data>>()) {
+            throw std::runtime_error("The delta was written with another vertex data layout.");
+        }
+    });
+    auto nVertices = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    auto nEdges = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    if (nVertices != _vertices.size() || nEdges != _edges.size()) {
+        throw std::runtime_error(fmt::format("The delta applies to a graph with {} vertices and {} edges, not {} and {}.",
+                                             nVertices, nEdges, _vertices.size(), _edges.size()));
+    }
+    auto nSlots = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    auto nChanged = static_cast<std::size_t>(reader.read<std::uint64_t>());
+
+    struct Change {
+        PersistentVertexIndex ix;
+        std::optional<Data> data;
+        std::vector<PersistentVertexIndex> neighbors;
+    };
+    std::vector<Change> changes;
+    for (std::size_t i = 0; i < nChanged; ++i) {
+        Change change {detail::readIndex<PersistentVertexIndex>(reader, std::max(nSlots, _vertices.size_persistent())),
+                      std::nullopt, {}};
+        if (!changes.empty() && change.ix <= changes.back().ix) {
+            throw std::runtime_error("Corrupt graph delta: changed vertices are not sorted.");
+        }
+        if (reader.read<std::uint8_t>() != 0) {
+            if (change.ix.value >= nSlots) {
+                throw std::runtime_error(fmt::format("Corrupt graph delta: vertex index {} out of range.",
+                                                     change.ix.value));
+            }
+            auto &data = change.data.emplace();
+            detail::forEachField<Data>([&reader, &data](auto field) {
+                Serializer<std::tuple_element_t<field, Data>>::read(reader, std::get<field>(data));
+            });
+            change.neighbors.resize(static_cast<std::size_t>(reader.read<std::uint64_t>()));
+            detail::readIndices(reader, change.neighbors.data(), change.neighbors.size(), nSlots);
+        }
+        changes.push_back(std::move(change));
+    }
+    reader.release();
+
+    // active after the delta: changed and active in the delta, or unchanged and active now
+    auto isActive = [this, &changes](PersistentVertexIndex ix) {
+        auto it = std::lower_bound(changes.begin(), changes.end(), ix, [](const Change &change, auto ix) {
+            return change.ix < ix;
+        });
+        if (it != changes.end() && it->ix == ix) {
+            return it->data.has_value();
+        }
+        return ix.value < _vertices.size_persistent() && !(_vertices.cbegin_persistent() + ix.value)->deactivated();
+    };
+    for (const auto &change : changes) {
+        for (auto neighbor : change.neighbors) {
+            if (!isActive(neighbor)) {
+                throw std::runtime_error(fmt::format("Corrupt graph delta: edge to inactive vertex {}.",
+                                                     neighbor.value));
+            }
+        }
+    }
+
+    // vertices which become active are placed first so that edges to them can be added
+    for (auto &change : changes) {
+        if (change.data) {
+            if (change.ix.value < _vertices.size_persistent() &&
+                !(_vertices.cbegin_persistent() + change.ix.value)->deactivated()) {
+                _vertices.at(change.ix).setData(std::move(*change.data));
+            } else {
+                _vertices.emplace_persistent(change.ix, std::move(*change.data));
+            }
+            touch(change.ix);
+        }
+    }
+
+    auto batch = this->batch();
+    std::vector<PersistentVertexIndex> previous;
+    for (auto &[ix, data, neighbors] : changes) {
+        if (ix.value >= _vertices.size_persistent() || (_vertices.cbegin_persistent() + ix.value)->deactivated()) {
+            continue;
+        }
+        if (!data) {
+            batch.removeVertex(ix);
+            continue;
+        }
+        const auto &current = (_vertices.cbegin_persistent() + ix.value)->neighbors();
+        previous.assign(current.begin(), current.end());
+        std::sort(previous.begin(), previous.end());
+        std::sort(neighbors.begin(), neighbors.end());
+        auto itPrevious = previous.begin();
+        auto itNeighbors = neighbors.begin();
+        while (itPrevious != previous.end() || itNeighbors != neighbors.end()) {
+            if (itNeighbors == neighbors.end() || (itPrevious != previous.end() && *itPrevious < *itNeighbors)) {
+                batch.removeEdge(ix, *itPrevious++);
+            } else if (itPrevious == previous.end() || *itNeighbors < *itPrevious) {
+                batch.addEdge(ix, *itNeighbors++);
+            } else {
+                ++itPrevious;
+                ++itNeighbors;
+            }
+        }
+    }
+    batch.commit();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline MemoryUsage Graph<VertexCollection, Vertex, Instrumentation, Rest...>::memoryUsage() const {
+    using Neighbor = typename std::decay_t<decltype(std::declval<const Vertex &>().neighbors())>::value_type;
+    MemoryUsage usage;
+    usage.vertices = _vertices.capacity_persistent() * sizeof(Vertex);
+    usage.edges = _edges.capacity() * sizeof(Edge);
+    usage.blanks = _vertices.memory_deactivated();
+    usage.deactivatedSlack = _vertices.n_deactivated() * sizeof(Vertex);
+    usage.wastedCapacity = (_vertices.capacity_persistent() - _vertices.size_persistent()) * sizeof(Vertex) +
+                           (_edges.capacity() - _edges.size()) * sizeof(Edge) +
+                           _vertices.unused_memory_deactivated();
+    // inline neighbor lists of bounded vertices are part of the vertex slots
+    for (auto it = _vertices.cbegin_persistent(); MaxDegree == 0 && it != _vertices.cend_persistent(); ++it) {
+        const auto &neighbors = it->neighbors();
+        auto bytes = neighbors.capacity() * sizeof(Neighbor);
+        usage.neighbors += bytes;
+        if (it->deactivated()) {
+            usage.deactivatedSlack += bytes;
+        } else {
+            usage.wastedCapacity += (neighbors.capacity() - neighbors.size()) * sizeof(Neighbor);
+        }
+    }
+    if (!_vertices.empty_persistent()) {
+        usage.blankRatio = static_cast<double>(_vertices.n_deactivated()) /
+                           static_cast<double>(_vertices.size_persistent());
+    }
+    return usage;
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::shrinkToFit() {
+    if (journaling()) {
+        throw std::logic_error("Cannot shrink a graph while journaling.");
+    }
+    _vertices.shrink_to_fit();
+    for (std::size_t i = 0; MaxDegree == 0 && i < _vertices.size_persistent(); ++i) {
+        // only touch vertices which have something to release, so that copy-on-write storage stays shared otherwise
+        const auto &vertex = *(_vertices.cbegin_persistent() + i);
+        auto deactivated = vertex.deactivated();
+        if (deactivated ? vertex.neighbors().capacity() > 0
+                        : vertex.neighbors().capacity() > vertex.neighbors().size()) {
+            auto &neighbors = (_vertices.begin_persistent() + i)->neighbors();
+            if (deactivated) {
+                // not swapped with an empty list, which would use the default allocator instead of the vertex's one
+                neighbors.clear();
+            }
+            neighbors.shrink_to_fit();
+        }
+    }
+    _edges.shrink_to_fit();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline Stats Graph<VertexCollection, Vertex, Instrumentation, Rest...>::stats() const {
+    return instrumentation().stats();
+}
+
+template<template<typename...> class VertexCollection, typename Vertex, typename Instrumentation, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Instrumentation, Rest...>::resetStats() {
+    Instrumentation::reset();
+}
+
 }
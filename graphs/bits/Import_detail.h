@@ -0,0 +1,327 @@
+/**
+ * @file Import_detail.h
+ * @brief Definitions for the graph importers
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../Import.h"
+#include "../IndexPersistentVector.h"
+#include "../MappedFile.h"
+
+namespace graphs::io {
+
+namespace detail {
+
+// normalized edge between vertex ids, smaller id first
+using IdEdge = std::pair<std::uint64_t, std::uint64_t>;
+
+// calls task(i) for i = 0, ..., n - 1, either on a thread pool or on the calling thread
+using Runner = std::function<void(std::size_t, const std::function<void(std::size_t)> &)>;
+
+inline Runner poolRunner(ThreadPool &pool) {
+    return [&pool](std::size_t n, const std::function<void(std::size_t)> &task) {
+        std::vector<std::size_t> order(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            order[i] = i;
+        }
+        pool.run(order, task);
+    };
+}
+
+inline Runner serialRunner() {
+    return [](std::size_t n, const std::function<void(std::size_t)> &task) {
+        for (std::size_t i = 0; i < n; ++i) {
+            task(i);
+        }
+    };
+}
+
+/**
+ * The exclusive upper bound of vertex ids, ids from it on would overflow the number of slots.
+ */
+template<typename Graph>
+constexpr std::uint64_t maxVertexId() {
+    using Value = typename Graph::PersistentVertexIndex::value_type;
+    return static_cast<std::uint64_t>(std::min<std::uintmax_t>(std::numeric_limits<Value>::max(),
+                                                               std::numeric_limits<std::size_t>::max()));
+}
+
+inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+/**
+ * Parses the lines in [first, last) and appends the normalized edges.
+ * @param maxId the exclusive upper bound of vertex ids, so that one plus the largest id fits the index type
+ * @return one plus the largest vertex id, zero if there is none
+ */
+inline std::uint64_t parseEdgeListChunk(const char *text, const char *first, const char *last,
+                                        std::vector<IdEdge> &edges, std::uint64_t maxId) {
+    auto fail = [text](const char *where) {
+        throw std::runtime_error(fmt::format("Invalid edge list at byte {}.", where - text));
+    };
+    auto parseId = [&](const char *&p) {
+        std::uint64_t id;
+        auto [next, error] = std::from_chars(p, last, id);
+        if (error != std::errc() || id >= maxId) {
+            fail(p);
+        }
+        if (next != last && !isSeparator(*next) && *next != '\n') {
+            fail(next);
+        }
+        p = next;
+        return id;
+    };
+    std::uint64_t nVertices = 0;
+    auto p = first;
+    while (p < last) {
+        while (p < last && isSeparator(*p)) {
+            ++p;
+        }
+        if (p == last) {
+            break;
+        }
+        if (*p == '\n') {
+            ++p;
+            continue;
+        }
+        if (*p == '#' || *p == '%') {
+            p = std::find(p, last, '\n');
+            continue;
+        }
+        auto id1 = parseId(p);
+        while (p < last && isSeparator(*p)) {
+            ++p;
+        }
+        auto id2 = parseId(p);
+        p = std::find(p, last, '\n');
+        nVertices = std::max(nVertices, std::max(id1, id2) + 1);
+        if (id1 != id2) {
+            edges.emplace_back(std::min(id1, id2), std::max(id1, id2));
+        }
+    }
+    return nVertices;
+}
+
+/**
+ * Sorts and deduplicates edges which consist of segments given by their begin offsets. The segments are sorted in
+ * parallel and merged pairwise.
+ */
+inline void sortUnique(std::vector<IdEdge> &edges, std::vector<std::size_t> segments, const Runner &run) {
+    segments.push_back(edges.size());
+    run(segments.size() - 1, [&](std::size_t i) {
+        std::sort(edges.begin() + segments[i], edges.begin() + segments[i + 1]);
+    });
+    while (segments.size() > 2) {
+        std::vector<std::size_t> merged;
+        for (std::size_t i = 0; i < segments.size() - 1; i += 2) {
+            merged.push_back(segments[i]);
+        }
+        merged.push_back(edges.size());
+        run((segments.size() - 1) / 2, [&](std::size_t i) {
+            std::inplace_merge(edges.begin() + segments[2 * i], edges.begin() + segments[2 * i + 1],
+                               edges.begin() + segments[2 * i + 2]);
+        });
+        segments = std::move(merged);
+    }
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+/**
+ * Constructs a graph from sorted, unique and normalized edges. Neighbor lists are reserved to their degree.
+ * @param nSlots the number of vertex slots
+ * @param blanks the sorted ids of the slots which are blanks
+ * @param edges the edges
+ */
+template<typename Graph>
+Graph buildGraph(std::size_t nSlots, const std::vector<typename Graph::PersistentVertexIndex> &blanks,
+                 const std::vector<IdEdge> &edges) {
+    using VertexList = typename Graph::VertexList;
+    using Index = typename Graph::PersistentVertexIndex;
+    using Vertex = typename VertexList::value_type;
+    std::vector<std::size_t> degrees(nSlots, 0);
+    for (const auto &[id1, id2] : edges) {
+        ++degrees[id1];
+        ++degrees[id2];
+    }
+    VertexList vertices;
+    vertices.reserve(nSlots);
+    for (std::size_t i = 0; i < nSlots; ++i) {
+        vertices.emplace_back(typename Vertex::data_type{});
+        (vertices.begin_persistent() + i)->neighbors().reserve(degrees[i]);
+    }
+    for (const auto &[id1, id2] : edges) {
+        (vertices.begin_persistent() + id1)->neighbors().push_back(Index::of(id2));
+        (vertices.begin_persistent() + id2)->neighbors().push_back(Index::of(id1));
+    }
+    vertices.erase_persistent(blanks.begin(), blanks.end());
+    return Graph(std::move(vertices));
+}
+
+template<typename Graph>
+Graph parseEdgeList(std::string_view text, std::size_t nChunks, const Runner &run) {
+    // chunk boundaries at the beginning of lines
+    std::vector<const char *> boundaries {text.data()};
+    for (std::size_t i = 1; i < nChunks; ++i) {
+        auto boundary = std::max(boundaries.back(), text.data() + i * text.size() / nChunks);
+        boundary = std::find(boundary, text.data() + text.size(), '\n');
+        boundaries.push_back(boundary == text.data() + text.size() ? boundary : boundary + 1);
+    }
+    boundaries.push_back(text.data() + text.size());
+
+    std::vector<std::vector<IdEdge>> chunkEdges(nChunks);
+    std::vector<std::uint64_t> chunkVertices(nChunks, 0);
+    auto maxId = maxVertexId<Graph>();
+    run(nChunks, [&](std::size_t i) {
+        chunkVertices[i] = parseEdgeListChunk(text.data(), boundaries[i], boundaries[i + 1], chunkEdges[i], maxId);
+    });
+
+    std::vector<IdEdge> edges;
+    std::vector<std::size_t> segments;
+    {
+        std::size_t nEdges = 0;
+        for (const auto &chunk : chunkEdges) {
+            nEdges += chunk.size();
+        }
+        edges.reserve(nEdges);
+    }
+    for (auto &chunk : chunkEdges) {
+        segments.push_back(edges.size());
+        edges.insert(edges.end(), chunk.begin(), chunk.end());
+        std::vector<IdEdge>().swap(chunk);
+    }
+    sortUnique(edges, std::move(segments), run);
+    auto nSlots = *std::max_element(chunkVertices.begin(), chunkVertices.end());
+    return buildGraph<Graph>(static_cast<std::size_t>(nSlots), {}, edges);
+}
+
+/**
+ * Finds the value of an integer attribute within a tag.
+ * @return whether the attribute was found
+ */
+inline bool gexfAttribute(std::string_view tag, std::string_view name, std::uint64_t &value) {
+    for (auto pos = tag.find(name); pos != std::string_view::npos; pos = tag.find(name, pos + 1)) {
+        auto quote = pos + name.size() + 1;
+        if (pos > 0 && (tag[pos - 1] == ' ' || tag[pos - 1] == '\t' || tag[pos - 1] == '\n' || tag[pos - 1] == '\r')
+            && quote < tag.size() && tag[pos + name.size()] == '=' && (tag[quote] == '"' || tag[quote] == '\'')) {
+            auto first = tag.data() + quote + 1;
+            auto [next, error] = std::from_chars(first, tag.data() + tag.size(), value);
+            if (error != std::errc() || next == tag.data() + tag.size() || *next != tag[quote]) {
+                throw std::runtime_error(fmt::format("Unsupported GEXF: non-integer {} in {}.", name, tag));
+            }
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+template<typename Graph>
+inline Graph parseEdgeList(ThreadPool &pool, std::string_view text) {
+    // a few chunks per thread so that idle threads can steal
+    auto nChunks = std::max<std::size_t>(1, std::min(4 * pool.nThreads(), text.size() / (1 << 16)));
+    return detail::parseEdgeList<Graph>(text, nChunks, detail::poolRunner(pool));
+}
+
+template<typename Graph>
+inline Graph parseEdgeList(std::string_view text) {
+    return detail::parseEdgeList<Graph>(text, 1, detail::serialRunner());
+}
+
+template<typename Graph>
+inline Graph readEdgeList(ThreadPool &pool, const std::string &path) {
+    MappedFile file(path);
+    return parseEdgeList<Graph>(pool, {reinterpret_cast<const char *>(file.data()), file.size()});
+}
+
+template<typename Graph>
+inline Graph readEdgeList(const std::string &path) {
+    MappedFile file(path);
+    return parseEdgeList<Graph>({reinterpret_cast<const char *>(file.data()), file.size()});
+}
+
+template<typename Graph>
+inline Graph parseGexf(std::string_view text) {
+    std::vector<std::uint64_t> nodes;
+    std::vector<detail::IdEdge> edges;
+    bool inGraph = false;
+    for (auto pos = text.find('<'); pos != std::string_view::npos; pos = text.find('<', pos + 1)) {
+        auto end = text.find('>', pos);
+        if (end == std::string_view::npos) {
+            throw std::runtime_error("Malformed GEXF: unterminated tag.");
+        }
+        auto tag = text.substr(pos, end - pos);
+        auto nameEnd = tag.find_first_of(" \t\r\n/", 1);
+        auto name = tag.substr(1, nameEnd == std::string_view::npos ? std::string_view::npos : nameEnd - 1);
+        if (name == "graph") {
+            inGraph = true;
+        } else if (name == "/graph") {
+            inGraph = false;
+        } else if (inGraph && name == "node") {
+            std::uint64_t id;
+            if (!detail::gexfAttribute(tag, "id", id)) {
+                throw std::runtime_error("Malformed GEXF: node without id.");
+            }
+            nodes.push_back(id);
+        } else if (inGraph && name == "edge") {
+            std::uint64_t source;
+            std::uint64_t target;
+            if (!detail::gexfAttribute(tag, "source", source) || !detail::gexfAttribute(tag, "target", target)) {
+                throw std::runtime_error("Malformed GEXF: edge without source or target.");
+            }
+            if (source != target) {
+                edges.emplace_back(std::min(source, target), std::max(source, target));
+            }
+        }
+        pos = end;
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    if (std::adjacent_find(nodes.begin(), nodes.end()) != nodes.end()) {
+        throw std::runtime_error("Malformed GEXF: duplicate node id.");
+    }
+    if (!nodes.empty() && nodes.back() >= detail::maxVertexId<Graph>()) {
+        throw std::runtime_error(fmt::format("Unsupported GEXF: node id {} is too large.", nodes.back()));
+    }
+    auto nSlots = nodes.empty() ? std::size_t{0} : static_cast<std::size_t>(nodes.back() + 1);
+    std::vector<typename Graph::PersistentVertexIndex> blanks;
+    {
+        auto node = nodes.begin();
+        for (std::size_t id = 0; id < nSlots; ++id) {
+            if (*node == id) {
+                ++node;
+            } else {
+                blanks.push_back(Graph::PersistentVertexIndex::of(id));
+            }
+        }
+    }
+    detail::sortUnique(edges, {0}, detail::serialRunner());
+    for (const auto &[id1, id2] : edges) {
+        if (!std::binary_search(nodes.begin(), nodes.end(), id1) ||
+            !std::binary_search(nodes.begin(), nodes.end(), id2)) {
+            throw std::runtime_error(fmt::format("Malformed GEXF: edge {} - {} refers to an undeclared node.", id1,
+                                                 id2));
+        }
+    }
+    return detail::buildGraph<Graph>(nSlots, blanks, edges);
+}
+
+template<typename Graph>
+inline Graph readGexf(const std::string &path) {
+    MappedFile file(path);
+    return parseGexf<Graph>({reinterpret_cast<const char *>(file.data()), file.size()});
+}
+
+}
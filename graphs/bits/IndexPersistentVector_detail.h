@@ -5,21 +5,72 @@
 #pragma once
 
 #include <vector>
+#include <bitset>
 #include <stack>
+#include <optional>
 #include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <fmt/format.h>
 
+#include "../NeighborSearch.h"
+
 namespace graphs {
 
-struct PersistentIndex {
-    std::size_t value;
+/**
+ * Index into an IndexPersistentContainer which stays valid until the element it refers to is erased.
+ * @tparam T the unsigned integer type of the value, a narrower type halves neighbor lists and edges
+ */
+template<typename T>
+struct BasicPersistentIndex {
+    static_assert(std::is_unsigned_v<T>, "Persistent indices are unsigned integers");
+
+    using value_type = T;
+
+    T value;
+
+    /**
+     * Creates an index from any integer, e.g., a std::size_t position, converting it to value_type.
+     * @param value the value
+     * @return the index
+     */
+    template<typename U>
+    static constexpr BasicPersistentIndex of(U value) {
+        return {static_cast<T>(value)};
+    }
+
+    bool operator==(const BasicPersistentIndex& rvi) const { return value == rvi.value; }
+    bool operator!=(const BasicPersistentIndex& rvi) const { return !(*this == rvi);}
+    bool operator<(const BasicPersistentIndex& rvi) const { return value < rvi.value; }
+    bool operator >=(const BasicPersistentIndex& rvi) const { return !(*this < rvi); }
+    bool operator >(const BasicPersistentIndex& rvi) const { return value > rvi.value; }
+    bool operator <= (const BasicPersistentIndex& rvi) const { return !(*this > rvi); }
+};
 
-    bool operator==(const PersistentIndex& rvi) const { return value == rvi.value; }
-    bool operator!=(const PersistentIndex& rvi) const { return !(*this == rvi);}
-    bool operator<(const PersistentIndex& rvi) const { return value < rvi.value; }
-    bool operator >=(const PersistentIndex& rvi) const { return !(*this < rvi); }
-    bool operator >(const PersistentIndex& rvi) const { return value > rvi.value; }
-    bool operator <= (const PersistentIndex& rvi) const { return !(*this > rvi); }
+using PersistentIndex = BasicPersistentIndex<std::size_t>;
+
+/**
+ * 32-bit persistent index for containers with less than 2^32 slots.
+ */
+using PersistentIndex32 = BasicPersistentIndex<std::uint32_t>;
+
+/**
+ * Which blank an IndexPersistentContainer refills when an element is inserted.
+ */
+enum class BlankReuse {
+    // the blank with the largest index
+    largestFirst,
+    // the blank with the lowest index; erasing the last element drops the blanks in front of it as well, so that the
+    // backing vector shrinks once the elements at its end are gone
+    lowestFirst,
+    // the blank closest to a hint, by default the index of the previously inserted element
+    nearest,
+    // the blank which was erased first
+    fifo
 };
 
 namespace detail {
@@ -43,6 +94,79 @@ template<typename T>
 struct can_query_active<T, std::void_t<decltype(std::declval<T>().deactivated())>> : std::true_type {
 };
 
+/**
+ * Whether a vertex type (or the traits of a BasicVertex) keeps its neighbor list sorted by index.
+ */
+template<typename T, typename = void>
+struct sorted_neighbors : std::false_type {
+};
+template<typename T>
+struct sorted_neighbors<T, std::void_t<decltype(T::sorted_neighbors)>> : std::bool_constant<T::sorted_neighbors> {
+};
+template<typename T>
+inline constexpr bool sorted_neighbors_v = sorted_neighbors<T>::value;
+
+/**
+ * Adds an index to a neighbor list unless it is contained already. Sorted lists are searched by bisection and the
+ * index is inserted at its position, otherwise the list is scanned (see NeighborSearch.h) and the index is appended.
+ * @return whether the index was added
+ */
+template<bool Sorted, typename NeighborList, typename Index>
+bool insertNeighbor(NeighborList &neighbors, Index neighbor) {
+    if constexpr (Sorted) {
+        auto it = std::lower_bound(neighbors.begin(), neighbors.end(), neighbor);
+        if (it == neighbors.end() || *it != neighbor) {
+            neighbors.insert(it, neighbor);
+            return true;
+        }
+    } else {
+        if (findNeighbor(neighbors, neighbor) == neighbors.end()) {
+            neighbors.push_back(neighbor);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Removes an index from a neighbor list if it is contained, preserving the order of the others.
+ * @return whether the index was removed
+ */
+template<bool Sorted, typename NeighborList, typename Index>
+bool eraseNeighbor(NeighborList &neighbors, Index neighbor) {
+    auto it = Sorted ? std::lower_bound(neighbors.cbegin(), neighbors.cend(), neighbor)
+                     : findNeighbor(neighbors, neighbor);
+    if (it != neighbors.cend() && *it == neighbor) {
+        neighbors.erase(it);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * operator-> of an iterator, which may be a plain pointer
+ */
+template<typename Iterator>
+auto arrow(const Iterator &it) {
+    if constexpr (std::is_pointer_v<Iterator>) {
+        return it;
+    } else {
+        return it.operator->();
+    }
+}
+
+/**
+ * the persistent index type of a container of T: T::index_type if it is declared, PersistentIndex otherwise
+ */
+template<typename T, typename = void>
+struct persistent_index_of {
+    using type = PersistentIndex;
+};
+template<typename T>
+struct persistent_index_of<T, std::void_t<typename T::index_type>> {
+    using type = typename T::index_type;
+};
+
 template<typename IteratorL, typename IteratorR, typename std::enable_if<has_to_persistent<IteratorL>{} && has_to_persistent<IteratorR>{}, bool>::type = true>
 bool operator==(const IteratorL &lhs, const IteratorR &rhs) { return lhs.to_persistent() == rhs.to_persistent(); }
 
@@ -61,6 +185,232 @@ bool operator<=(const IteratorL &lhs, const IteratorR &rhs) { return lhs.to_pers
 template<typename IteratorL, typename IteratorR, typename std::enable_if<has_to_persistent<IteratorL>{} && has_to_persistent<IteratorR>{}, bool>::type = true>
 bool operator>=(const IteratorL &lhs, const IteratorR &rhs) { return lhs.to_persistent() >= rhs.to_persistent(); }
 
+/**
+ * Set of the blanks of an IndexPersistentContainer: a bitmap over the slots together with a Fenwick tree over the
+ * number of blanks per 64 slots, i.e., about two bits per slot. Inserting and erasing a blank, counting the blanks in
+ * front of a slot and selecting the k-th blank or the k-th active slot are O(log #slots), checking a slot is O(1).
+ * Both arrays are stored in the same kind of vector as the elements.
+ * @tparam BackingVector the vector template of the container
+ * @tparam Index the persistent index type
+ */
+template<template<typename...> class BackingVector, typename Index>
+class BlankSet {
+    using Word = std::uint64_t;
+    static constexpr std::size_t wordBits = 64;
+public:
+    using value_type = Index;
+    using size_type = std::size_t;
+
+    BlankSet() = default;
+
+    template<typename Allocator>
+    explicit BlankSet(const Allocator &allocator) : _bits(allocator), _tree(allocator) {}
+
+    template<typename Allocator>
+    BlankSet(const BlankSet &other, const Allocator &allocator)
+            : _bits(other._bits, allocator), _tree(other._tree, allocator), _size(other._size) {}
+
+    [[nodiscard]] size_type size() const {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _size == 0;
+    }
+
+    [[nodiscard]] bool contains(std::size_t slot) const {
+        return slot / wordBits < _bits.size() && (_bits[slot / wordBits] >> (slot % wordBits) & 1u) != 0;
+    }
+
+    /**
+     * @param index a slot which is not a blank
+     */
+    void insert(Index index) {
+        auto word = index.value / wordBits;
+        while (_bits.size() <= word) {
+            appendWord();
+        }
+        _bits[word] |= Word{1} << (index.value % wordBits);
+        add(word, 1);
+        ++_size;
+    }
+
+    /**
+     * @param index a blank
+     */
+    void erase(Index index) {
+        auto word = index.value / wordBits;
+        _bits[word] &= ~(Word{1} << (index.value % wordBits));
+        add(word, static_cast<Word>(-1));
+        --_size;
+    }
+
+    /**
+     * @param slot a slot
+     * @return the number of blanks in front of it
+     */
+    [[nodiscard]] size_type rank(std::size_t slot) const {
+        auto word = slot / wordBits;
+        if (word >= _bits.size()) {
+            return _size;
+        }
+        auto below = (Word{1} << (slot % wordBits)) - 1;
+        return prefix(word) + popcount(_bits[word] & below);
+    }
+
+    /**
+     * @param k the rank, smaller than size()
+     * @return the k-th blank in ascending order
+     */
+    [[nodiscard]] Index select(size_type k) const {
+        auto [word, remainder] = descend(k, [this](std::size_t node, std::size_t) { return _tree[node]; });
+        return Index::of(word * wordBits + nthSetBit(_bits[word], remainder));
+    }
+
+    /**
+     * @param k the rank
+     * @return the k-th slot which is not a blank, slots beyond the last blank count as active
+     */
+    [[nodiscard]] std::size_t selectActive(size_type k) const {
+        auto [word, remainder] = descend(k, [this](std::size_t node, std::size_t nWords) {
+            return nWords * wordBits - _tree[node];
+        });
+        if (word >= _bits.size()) {
+            return word * wordBits + remainder;
+        }
+        return word * wordBits + nthSetBit(~_bits[word], remainder);
+    }
+
+    /**
+     * Calls f with every blank in ascending order.
+     */
+    template<typename F>
+    void forEach(F &&f) const {
+        for (std::size_t word = 0; word < _bits.size(); ++word) {
+            for (auto bits = _bits[word]; bits != 0; bits &= bits - 1) {
+                f(Index::of(word * wordBits + lowestSetBit(bits)));
+            }
+        }
+    }
+
+    void clear() {
+        _bits.clear();
+        _tree.clear();
+        _size = 0;
+    }
+
+    /**
+     * Drops the words behind the last blank and releases unused capacity.
+     */
+    void shrink_to_fit() {
+        while (!_bits.empty() && _bits.back() == 0) {
+            _bits.pop_back();
+            _tree.pop_back();
+        }
+        _bits.shrink_to_fit();
+        _tree.shrink_to_fit();
+    }
+
+    /**
+     * @return the number of bytes reserved by the bitmap and the tree
+     */
+    [[nodiscard]] std::size_t memory() const {
+        return (_bits.capacity() + _tree.capacity()) * sizeof(Word);
+    }
+
+    /**
+     * @return the number of reserved bytes which are not in use
+     */
+    [[nodiscard]] std::size_t unusedMemory() const {
+        return (_bits.capacity() - _bits.size() + _tree.capacity() - _tree.size()) * sizeof(Word);
+    }
+
+private:
+    static std::size_t lowbit(std::size_t i) {
+        return i & (~i + 1);
+    }
+
+    static std::size_t popcount(Word bits) {
+        return std::bitset<wordBits>(bits).count();
+    }
+
+    static std::size_t lowestSetBit(Word bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+        std::size_t bit = 0;
+        for (; (bits & 1u) == 0; bits >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static std::size_t nthSetBit(Word bits, std::size_t n) {
+        for (; n > 0; --n) {
+            bits &= bits - 1;
+        }
+        return lowestSetBit(bits);
+    }
+
+    /**
+     * @return the number of blanks in the words [0, word)
+     */
+    [[nodiscard]] size_type prefix(std::size_t word) const {
+        size_type sum = 0;
+        for (auto i = word; i > 0; i -= lowbit(i)) {
+            sum += _tree[i - 1];
+        }
+        return sum;
+    }
+
+    void add(std::size_t word, Word delta) {
+        for (auto i = word + 1; i <= _tree.size(); i += lowbit(i)) {
+            _tree[i - 1] += delta;
+        }
+    }
+
+    void appendWord() {
+        // a node covers the words (i - lowbit(i), i], the new word is empty
+        auto i = _tree.size() + 1;
+        auto covered = prefix(i - 1) - prefix(i - lowbit(i));
+        _bits.push_back(0);
+        _tree.push_back(covered);
+    }
+
+    /**
+     * Finds the word in which the count of the nodes reaches k.
+     * @param k the rank
+     * @param count the count of a node given its position in the tree and the number of words it covers
+     * @return the word and the rank within the word, words beyond the tree continue with full words of active slots
+     */
+    template<typename Count>
+    [[nodiscard]] std::pair<std::size_t, std::size_t> descend(size_type k, Count &&count) const {
+        std::size_t word = 0;
+        std::size_t step = 1;
+        while (2 * step <= _tree.size()) {
+            step *= 2;
+        }
+        for (; step > 0 && !_tree.empty(); step /= 2) {
+            if (word + step <= _tree.size()) {
+                auto nodeCount = count(word + step - 1, step);
+                if (nodeCount <= k) {
+                    word += step;
+                    k -= nodeCount;
+                }
+            }
+        }
+        if (word == _tree.size()) {
+            return {word + k / wordBits, k % wordBits};
+        }
+        return {word, k};
+    }
+
+    BackingVector<Word> _bits {};
+    BackingVector<Word> _tree {};
+    size_type _size {0};
+};
+
 template<template<typename...> class BackingVector, typename T, typename... Rest>
 class IndexPersistentContainer {
     static_assert(detail::can_be_deactivated<T>::value && detail::can_query_active<T>::value,
@@ -71,12 +421,21 @@ public:
      */
     using size_type = typename BackingVector<T, Rest...>::size_type;
 
-    using persistent_index_t = PersistentIndex;
+    /**
+     * the persistent index type, see persistent_index_of
+     */
+    using persistent_index_t = typename persistent_index_of<T>::type;
 
     /**
-     * stack of blanks (indices) type
+     * set of blanks (indices) type, stored in the same kind of vector as the elements
      */
-    using BlanksList = std::vector<persistent_index_t>;
+    using BlanksList = BlankSet<BackingVector, persistent_index_t>;
+
+    /**
+     * the backing vector template, e.g., for storing data which belongs to the elements in the same kind of vector
+     */
+    template<typename U>
+    using backing_vector_t = BackingVector<U>;
 
     /**
      * the difference type of this, inherited from the backing vector
@@ -90,6 +449,14 @@ public:
      * the value type of this, inherited from the backing vector
      */
     using value_type = typename BackingVector<T, Rest...>::value_type;
+    /**
+     * the reference type of this, inherited from the backing vector, may be a proxy
+     */
+    using reference = typename BackingVector<T, Rest...>::reference;
+    /**
+     * the const reference type of this, inherited from the backing vector, may be a proxy
+     */
+    using const_reference = typename BackingVector<T, Rest...>::const_reference;
 
     /**
      * the iterator type, same as backing vector's iterator
@@ -102,11 +469,11 @@ public:
 
     class const_active_iterator {
     public:
-        using difference_type = typename const_persistent_iterator::difference_type;
-        using value_type = typename const_persistent_iterator::value_type;
-        using reference = typename const_persistent_iterator::reference;
-        using pointer = typename const_persistent_iterator::pointer;
-        using iterator_category = typename const_persistent_iterator::iterator_category;
+        using difference_type = typename std::iterator_traits<const_persistent_iterator>::difference_type;
+        using value_type = typename std::iterator_traits<const_persistent_iterator>::value_type;
+        using reference = typename std::iterator_traits<const_persistent_iterator>::reference;
+        using pointer = typename std::iterator_traits<const_persistent_iterator>::pointer;
+        using iterator_category = typename std::iterator_traits<const_persistent_iterator>::iterator_category;
 
         const_active_iterator() : parent(), begin(), end(), blanksPtr() {}
 
@@ -167,14 +534,8 @@ public:
         }
 
         const_active_iterator &operator+=(size_type n) {
-            auto pos = std::distance(begin, parent);
-            auto targetPos = pos + n;
-            auto it = std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{static_cast<std::size_t>(pos)});
-            while (it != blanksPtr->end() && it->value <= targetPos) {
-                ++targetPos;
-                ++it;
-            }
-            parent += targetPos - pos;
+            auto pos = static_cast<std::size_t>(std::distance(begin, parent));
+            parent += blanksPtr->selectActive(pos - blanksPtr->rank(pos) + n) - pos;
             return *this;
         }
 
@@ -189,14 +550,8 @@ public:
         }
 
         const_active_iterator &operator-=(size_type n) {
-            auto pos = std::distance(begin, parent);
-            auto targetPos = pos - n;
-            auto it = std::lower_bound(blanksPtr->rbegin(), blanksPtr->rend(), persistent_index_t{static_cast<std::size_t>(pos)}, std::greater<>());
-            while (it != blanksPtr->rend() && it->value >= targetPos) {
-                --targetPos;
-                ++it;
-            }
-            parent -= pos - targetPos;
+            auto pos = static_cast<std::size_t>(std::distance(begin, parent));
+            parent -= pos - blanksPtr->selectActive(pos - blanksPtr->rank(pos) - n);
             return *this;
         }
 
@@ -211,12 +566,8 @@ public:
             // find number of blanks in that range
             auto pos = std::distance(begin, parent);
             auto rhsPos = std::distance(begin, rhs.parent);
-            auto nBlanksThis = std::distance(blanksPtr->begin(),
-                                             std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{
-                                                     static_cast<std::size_t>(pos)}));
-            auto nBlanksThat = std::distance(blanksPtr->begin(),
-                                             std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{
-                                                     static_cast<std::size_t>(rhsPos)}));
+            auto nBlanksThis = static_cast<difference_type>(blanksPtr->rank(static_cast<std::size_t>(pos)));
+            auto nBlanksThat = static_cast<difference_type>(blanksPtr->rank(static_cast<std::size_t>(rhsPos)));
             return dist - (nBlanksThis - nBlanksThat);
         }
 
@@ -225,7 +576,7 @@ public:
         }
 
         pointer operator->() const {
-            return parent.operator->();
+            return arrow(parent);
         }
 
         reference operator[](size_type n) const {
@@ -233,7 +584,7 @@ public:
         }
 
         [[nodiscard]] persistent_index_t persistent_index() const {
-            return persistent_index_t{static_cast<std::size_t>(std::distance(begin, parent))};
+            return persistent_index_t::of(std::distance(begin, parent));
         }
 
         const_persistent_iterator to_persistent() const {
@@ -242,12 +593,10 @@ public:
 
     private:
         void skipBlanks() {
-            auto pos = std::distance(begin, parent);
-            auto it = std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{static_cast<std::size_t>(pos)});
-            while (it != blanksPtr->end() && parent != end && pos == it->value) {
+            auto pos = static_cast<std::size_t>(std::distance(begin, parent));
+            while (parent != end && blanksPtr->contains(pos)) {
                 ++parent;
                 ++pos;
-                ++it;
             }
         }
 
@@ -259,11 +608,11 @@ public:
 
     class active_iterator {
     public:
-        using difference_type = typename persistent_iterator::difference_type;
-        using value_type = typename persistent_iterator::value_type;
-        using reference = typename persistent_iterator::reference;
-        using pointer = typename persistent_iterator::pointer;
-        using iterator_category = typename persistent_iterator::iterator_category;
+        using difference_type = typename std::iterator_traits<persistent_iterator>::difference_type;
+        using value_type = typename std::iterator_traits<persistent_iterator>::value_type;
+        using reference = typename std::iterator_traits<persistent_iterator>::reference;
+        using pointer = typename std::iterator_traits<persistent_iterator>::pointer;
+        using iterator_category = typename std::iterator_traits<persistent_iterator>::iterator_category;
 
         active_iterator() : parent(), begin(), end(), blanksPtr() {}
 
@@ -274,7 +623,7 @@ public:
 
         reference operator*() const { return *parent; }
 
-        pointer operator->() const { return parent.operator->(); }
+        pointer operator->() const { return arrow(parent); }
 
         reference operator[](size_type i) const {
             return *(operator+(i));
@@ -309,14 +658,8 @@ public:
         }
 
         active_iterator &operator+=(size_type n) {
-            auto pos = std::distance(begin, parent);
-            auto targetPos = pos + n;
-            auto it = std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{static_cast<std::size_t>(pos)});
-            while (it != blanksPtr->end() && it->value <= targetPos) {
-                ++targetPos;
-                ++it;
-            }
-            parent += targetPos - pos;
+            auto pos = static_cast<std::size_t>(std::distance(begin, parent));
+            parent += blanksPtr->selectActive(pos - blanksPtr->rank(pos) + n) - pos;
             return *this;
         }
 
@@ -331,14 +674,8 @@ public:
         }
 
         active_iterator &operator-=(size_type n) {
-            auto pos = std::distance(begin, parent);
-            auto targetPos = pos - n;
-            auto it = std::lower_bound(blanksPtr->rbegin(), blanksPtr->rend(), persistent_index_t{static_cast<std::size_t>(pos)}, std::greater<>());
-            while (it != blanksPtr->rend() && it->value >= targetPos) {
-                --targetPos;
-                ++it;
-            }
-            parent -= pos - targetPos;
+            auto pos = static_cast<std::size_t>(std::distance(begin, parent));
+            parent -= pos - blanksPtr->selectActive(pos - blanksPtr->rank(pos) - n);
             return *this;
         }
 
@@ -353,12 +690,8 @@ public:
             // find number of blanks in that range
             auto pos = std::distance(begin, parent);
             auto rhsPos = std::distance(begin, rhs.parent);
-            auto nBlanksThis = std::distance(blanksPtr->begin(),
-                                             std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{
-                                                     static_cast<std::size_t>(pos)}));
-            auto nBlanksThat = std::distance(blanksPtr->begin(),
-                                             std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{
-                                                     static_cast<std::size_t>(rhsPos)}));
+            auto nBlanksThis = static_cast<difference_type>(blanksPtr->rank(static_cast<std::size_t>(pos)));
+            auto nBlanksThat = static_cast<difference_type>(blanksPtr->rank(static_cast<std::size_t>(rhsPos)));
             return dist - (nBlanksThis - nBlanksThat);
         }
 
@@ -367,7 +700,7 @@ public:
         }
 
         [[nodiscard]] persistent_index_t persistent_index() const {
-            return persistent_index_t{static_cast<size_type>(std::distance(begin, parent))};
+            return persistent_index_t::of(std::distance(begin, parent));
         }
 
         operator const_active_iterator() const {
@@ -376,12 +709,10 @@ public:
 
     private:
         void skipBlanks() {
-            auto pos = std::distance(begin, parent);
-            auto it = std::lower_bound(blanksPtr->begin(), blanksPtr->end(), persistent_index_t{static_cast<std::size_t>(pos)});
-            while (it != blanksPtr->end() && parent != end && pos == it->value) {
+            auto pos = static_cast<std::size_t>(std::distance(begin, parent));
+            while (parent != end && blanksPtr->contains(pos)) {
                 ++parent;
                 ++pos;
-                ++it;
             }
         }
 
@@ -394,6 +725,37 @@ public:
     using iterator = active_iterator;
     using const_iterator = const_active_iterator;
 
+    IndexPersistentContainer() = default;
+
+    /**
+     * Creates an empty container whose backing vector and blanks use the given allocator. Only available if the
+     * backing vector can be constructed from an allocator, so that std::is_constructible reports it.
+     * @param allocator the allocator
+     */
+    template<typename Allocator = allocator_type,
+             typename = std::enable_if_t<std::is_constructible_v<BackingVector<T, Rest...>, const Allocator &>>>
+    explicit IndexPersistentContainer(const allocator_type &allocator)
+            : _blanks(allocator), _backingVector(allocator) {}
+
+    /**
+     * Copies a container into storage obtained from the given allocator. With std::pmr this moves a copy into
+     * another memory resource, whereas the copy constructor uses the default resource.
+     * @param other the container to copy
+     * @param allocator the allocator
+     */
+    IndexPersistentContainer(const IndexPersistentContainer &other, const allocator_type &allocator)
+            : _blanks(other._blanks, allocator), _backingVector(other._backingVector, allocator),
+              _journal(other._journal), _checkpoints(other._checkpoints), _reuse(other._reuse),
+              _erasedBlanks(other._erasedBlanks), _erasedFront(other._erasedFront), _nQueued(other._nQueued),
+              _hint(other._hint) {}
+
+    /**
+     * @return the allocator of the backing vector
+     */
+    allocator_type get_allocator() const {
+        return _backingVector.get_allocator();
+    }
+
     /**
      * gives access to the backing vector
      * @return a reference to the backing vector
@@ -430,28 +792,86 @@ public:
         return _backingVector.size() == _blanks.size();
     }
 
+    /**
+     * the capacity of the backing vector, including blanks
+     * @return the capacity
+     */
+    [[nodiscard]] size_type capacity_persistent() const {
+        return _backingVector.capacity();
+    }
+
+    /**
+     * reserves capacity in the backing vector
+     * @param n the number of elements, including blanks
+     */
+    void reserve(size_type n) {
+        _backingVector.reserve(n);
+    }
+
+    /**
+     * the memory reserved for bookkeeping of the blanks
+     * @return the number of bytes
+     */
+    [[nodiscard]] std::size_t memory_deactivated() const {
+        return _blanks.memory();
+    }
+
+    /**
+     * the memory reserved for bookkeeping of the blanks which is not in use
+     * @return the number of bytes
+     */
+    [[nodiscard]] std::size_t unused_memory_deactivated() const {
+        return _blanks.unusedMemory();
+    }
+
+    /**
+     * Drops the blanks at the end of the backing vector and releases unused capacity of the backing vector and the
+     * blanks. Persistent indices of active elements stay valid.
+     */
+    void shrink_to_fit() {
+        if (journaling()) {
+            throw std::logic_error("Cannot shrink an IndexPersistentContainer while journaling.");
+        }
+        while (!_backingVector.empty() && _blanks.contains(_backingVector.size() - 1)) {
+            _blanks.erase(persistent_index_t::of(_backingVector.size() - 1));
+            _backingVector.pop_back();
+        }
+        _backingVector.shrink_to_fit();
+        _blanks.shrink_to_fit();
+    }
+
     /**
      * clears this container
      */
     void clear() {
+        if (journaling()) {
+            throw std::logic_error("Cannot clear an IndexPersistentContainer while journaling.");
+        }
         _backingVector.clear();
         _blanks.clear();
+        _erasedBlanks.clear();
+        _erasedFront = 0;
+        _nQueued.clear();
     }
 
     /**
      * Performs a push_back. If the blanks stack is empty, the element is simply pushed back to the backing vector,
-     * otherwise it is inserted at the index the stack's first element is pointing to, which then is erased.
+     * otherwise it is inserted at a blank selected by the policy (see set_blank_reuse()), which then is erased.
      * @param val the value to insert
      * @return an iterator pointing to the inserted element
      */
     iterator push_back(T &&val) {
         if (_blanks.empty()) {
+            checkIndexCapacity(_backingVector.size());
             _backingVector.push_back(std::forward<T>(val));
+            _hint = persistent_index_t::of(_backingVector.size() - 1);
+            record(JournalEntry::Type::appended, _hint);
             return iterator(std::prev(_backingVector.end()), _backingVector.begin(), _backingVector.end(), &_blanks);
         } else {
-            const auto idx = _blanks.back();
-            _blanks.pop_back();
+            const auto idx = takeBlank(_hint);
+            record(JournalEntry::Type::reusedBlank, idx);
             _backingVector.at(idx.value) = std::move(val);
+            _hint = idx;
             return {_backingVector.begin() + idx.value, std::begin(_backingVector), std::end(_backingVector),
                     &_blanks};
         }
@@ -464,12 +884,16 @@ public:
      */
     iterator push_back(const T &val) {
         if (_blanks.empty()) {
+            checkIndexCapacity(_backingVector.size());
             _backingVector.push_back(val);
+            _hint = persistent_index_t::of(_backingVector.size() - 1);
+            record(JournalEntry::Type::appended, _hint);
             return {std::prev(_backingVector.end()), _backingVector.begin(), _backingVector.end(), &_blanks};
         } else {
-            const auto idx = _blanks.back();
-            _blanks.pop_back();
+            const auto idx = takeBlank(_hint);
+            record(JournalEntry::Type::reusedBlank, idx);
             _backingVector.at(idx.value) = val;
+            _hint = idx;
             return {_backingVector.begin() + idx.value, _backingVector.begin(), _backingVector.end(), &_blanks};
         }
     }
@@ -481,28 +905,73 @@ public:
      * @return an iterator pointed to the emplaced element
      */
     template<typename... Args>
-    PersistentIndex emplace_back(Args &&... args) {
+    persistent_index_t emplace_back(Args &&... args) {
+        return emplace_near(_hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Performs an emplace_back with an explicit hint for the nearest policy, e.g., the index of an element which the
+     * new one is related to. The other policies ignore the hint.
+     * @tparam Args argument types
+     * @param hint the persistent index close to which a blank is reused
+     * @param args arguments
+     * @return the persistent index of the emplaced element
+     */
+    template<typename... Args>
+    persistent_index_t emplace_near(persistent_index_t hint, Args &&... args) {
         if (_blanks.empty()) {
+            checkIndexCapacity(_backingVector.size());
             _backingVector.emplace_back(std::forward<Args>(args)...);
-            return {_backingVector.size() - 1};
+            _hint = persistent_index_t::of(_backingVector.size() - 1);
+            record(JournalEntry::Type::appended, _hint);
         } else {
-            const auto idx = _blanks.back();
-            _blanks.pop_back();
-            auto alloc = _backingVector.get_allocator();
-            std::allocator_traits<decltype(alloc)>::construct(
-                    alloc, &*_backingVector.begin() + idx.value, std::forward<Args>(args)...);
-            return {idx};
+            T value(std::forward<Args>(args)...);
+            _hint = takeBlank(hint);
+            record(JournalEntry::Type::reusedBlank, _hint);
+            *(_backingVector.begin() + _hint.value) = std::move(value);
         }
+        return _hint;
+    }
+
+    /**
+     * Selects which blank is refilled by insertions, see BlankReuse. Switching to lowestFirst drops the blanks at the
+     * end of the backing vector unless journaling.
+     * @param policy the policy
+     */
+    void set_blank_reuse(BlankReuse policy) {
+        _reuse = policy;
+        _erasedBlanks.clear();
+        _erasedFront = 0;
+        _nQueued.clear();
+        if (policy == BlankReuse::fifo) {
+            // the order of earlier erasures is unknown, the existing blanks are queued by index
+            _blanks.forEach([this](persistent_index_t blank) {
+                queueBlank(blank);
+            });
+        }
+        trimBlanks();
+    }
+
+    /**
+     * @return the policy for refilling blanks
+     */
+    [[nodiscard]] BlankReuse blank_reuse() const {
+        return _reuse;
     }
 
     void erase(iterator pos) {
+        recordErase(pos.persistent_index());
         deactivate(pos);
         insertBlank(pos.persistent_index());
+        trimBlanks();
     }
 
     void erase(persistent_iterator pos) {
+        auto idx = persistent_index_t::of(std::distance(_backingVector.begin(), pos));
+        recordErase(idx);
         pos->deactivate();
-        insertBlank(persistent_index_t{static_cast<std::size_t>(std::distance(_backingVector.begin(), pos))});
+        insertBlank(idx);
+        trimBlanks();
     }
 
     /**
@@ -511,18 +980,108 @@ public:
      * @param end end of the range, exclusive
      */
     void erase(persistent_iterator start, const_persistent_iterator end) {
-        auto offset = std::distance(_backingVector.begin(), start);
+        auto offset = static_cast<std::size_t>(std::distance(_backingVector.begin(), start));
         for (auto it = start; it != end; ++it, ++offset) {
-            deactivate(it);
-            insertBlank(offset);
+            recordErase(persistent_index_t::of(offset));
+            it->deactivate();
+            insertBlank(persistent_index_t::of(offset));
         }
+        trimBlanks();
     }
 
     void erase(iterator start, const_iterator end) {
         for (auto it = start; it != end; ++it) {
+            recordErase(it.persistent_index());
             deactivate(it);
             insertBlank(it.persistent_index());
         }
+        trimBlanks();
+    }
+
+    /**
+     * Erases all elements referred to by a range of persistent indices. The range has to be free of duplicates.
+     * @param first begin of the index range
+     * @param last end of the index range
+     */
+    template<typename InputIt>
+    void erase_persistent(InputIt first, InputIt last) {
+        for (auto it = first; it != last; ++it) {
+            recordErase(*it);
+            (_backingVector.begin() + it->value)->deactivate();
+            insertBlank(*it);
+        }
+        trimBlanks();
+    }
+
+    /**
+     * Constructs an element at a given persistent index, which has to refer to a blank or lie beyond the end. In the
+     * latter case the slots in between become blanks. Used to reproduce the layout of another container.
+     * @tparam Args argument types
+     * @param index the persistent index
+     * @param args arguments
+     * @throws std::invalid_argument if the index refers to an active element
+     */
+    template<typename... Args>
+    void emplace_persistent(persistent_index_t index, Args &&... args) {
+        T value(std::forward<Args>(args)...);
+        if (index.value < _backingVector.size()) {
+            if (!_blanks.contains(index.value)) {
+                throw std::invalid_argument(fmt::format("Tried emplacing at active element {}.", index));
+            }
+            _blanks.erase(index);
+            record(JournalEntry::Type::reusedBlank, index);
+            *(_backingVector.begin() + index.value) = std::move(value);
+            return;
+        }
+        while (_backingVector.size() < index.value) {
+            // journaled as appended and erased so that a rollback pops the padding again
+            _backingVector.push_back(value);
+            auto padding = persistent_index_t::of(_backingVector.size() - 1);
+            record(JournalEntry::Type::appended, padding);
+            recordErase(padding);
+            std::prev(_backingVector.end())->deactivate();
+            insertBlank(padding);
+        }
+        _backingVector.push_back(std::move(value));
+        record(JournalEntry::Type::appended, index);
+    }
+
+    /**
+     * Appends all slots of another container, including its blanks, behind the slots of this one. Blanks of this
+     * container are not reused, so that the element at persistent index i of other ends up at index offset + i. For
+     * trivially copyable elements the slots are copied with a single range insertion.
+     * @param other the container to append, may be this container
+     * @return the offset, i.e., the former size_persistent() of this container
+     */
+    std::size_t append(const IndexPersistentContainer &other) {
+        if (this == &other) {
+            auto copy = other;
+            return append(copy);
+        }
+        auto offset = _backingVector.size();
+        if (other._backingVector.empty()) {
+            return offset;
+        }
+        checkIndexCapacity(offset + other._backingVector.size() - 1);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            _backingVector.insert(_backingVector.end(), other._backingVector.begin(), other._backingVector.end());
+        } else {
+            _backingVector.reserve(offset + other._backingVector.size());
+            for (const auto &element : other._backingVector) {
+                _backingVector.push_back(element);
+            }
+        }
+        if (journaling()) {
+            for (std::size_t i = offset; i < _backingVector.size(); ++i) {
+                record(JournalEntry::Type::appended, persistent_index_t::of(i));
+            }
+        }
+        other._blanks.forEach([this, offset](persistent_index_t blank) {
+            auto index = persistent_index_t::of(offset + blank.value);
+            recordErase(index);
+            insertBlank(index);
+        });
+        return offset;
     }
 
     /**
@@ -547,7 +1106,7 @@ public:
      * @param index the index
      * @return a reference to the element
      */
-    T &at(size_type index) {
+    reference at(size_type index) {
         return at((begin() + index).persistent_index());
     }
 
@@ -556,20 +1115,20 @@ public:
      * @param index the index
      * @return a const reference to the element
      */
-    const T &at(size_type index) const {
+    const_reference at(size_type index) const {
         return at((begin() + index).persistent_index());
     }
 
-    T &at(PersistentIndex index) {
-        auto &x = *(begin_persistent() + index.value);
+    reference at(persistent_index_t index) {
+        auto &&x = *(begin_persistent() + index.value);
         if (x.deactivated()) {
             throw std::invalid_argument(fmt::format("Requested deactivated element {}", index));
         }
         return x;
     }
 
-    const T &at(PersistentIndex index) const {
-        const auto &x = *(begin_persistent() + index.value);
+    const_reference at(persistent_index_t index) const {
+        auto &&x = *(begin_persistent() + index.value);
         if (x.deactivated()) {
             throw std::invalid_argument(fmt::format("Requested deactivated element {}", index));
         }
@@ -667,38 +1226,292 @@ public:
     [[nodiscard]] persistent_index_t persistentIndex(const_persistent_iterator it) const {
         auto d = std::distance(std::begin(_backingVector), it);
         if (d >= 0) {
-            return {static_cast<std::size_t>(d)};
+            return persistent_index_t::of(d);
         } else {
             throw std::logic_error("Distance between begin and it was negative: d = " + std::to_string(d));
         }
     }
 
+    /**
+     * Yields the column of the I-th data field of all elements including blanks, only available if the backing vector
+     * stores its elements in columns (see SoaVector).
+     * @tparam I the data field
+     * @return a span over the column
+     */
+    template<std::size_t I, typename Backing = BackingVector<T, Rest...>>
+    auto column() -> decltype(std::declval<Backing &>().template column<I>()) {
+        return _backingVector.template column<I>();
+    }
+
+    template<std::size_t I, typename Backing = BackingVector<T, Rest...>>
+    auto column() const -> decltype(std::declval<const Backing &>().template column<I>()) {
+        return _backingVector.template column<I>();
+    }
+
+    /**
+     * Yields the neighbor lists of all elements including blanks, only available with a columnar backing vector.
+     * @return a span over the column
+     */
+    template<typename Backing = BackingVector<T, Rest...>>
+    auto adjacency() -> decltype(std::declval<Backing &>().adjacency()) {
+        return _backingVector.adjacency();
+    }
+
+    template<typename Backing = BackingVector<T, Rest...>>
+    auto adjacency() const -> decltype(std::declval<const Backing &>().adjacency()) {
+        return _backingVector.adjacency();
+    }
+
+    /**
+     * Yields the bitmap of active elements, only available with a columnar backing vector.
+     * @return a span over the words of the bitmap
+     */
+    template<typename Backing = BackingVector<T, Rest...>>
+    auto activeBitmap() const -> decltype(std::declval<const Backing &>().activeBitmap()) {
+        return _backingVector.activeBitmap();
+    }
+
+    /**
+     * Opens a checkpoint. While at least one checkpoint is open, all insertions and erasures are recorded in a
+     * journal (erased elements are copied) so that they can be undone with rollback(). Modifications of the elements
+     * themselves are not recorded. Checkpoints can be nested.
+     */
+    void checkpoint() {
+        static_assert(std::is_copy_constructible_v<T>, "Journaling requires copy constructible elements");
+        _checkpoints.push_back(_journal.size());
+    }
+
+    /**
+     * Undoes all insertions and erasures since the last checkpoint in O(#changes) and closes it.
+     */
+    void rollback() {
+        if (_checkpoints.empty()) {
+            throw std::logic_error("Tried rolling back without checkpoint.");
+        }
+        rollback_to(_checkpoints.back());
+        _checkpoints.pop_back();
+        trimBlanks();
+    }
+
+    /**
+     * Keeps all changes since the last checkpoint and closes it. Once no checkpoint is open anymore, the journal is
+     * discarded.
+     */
+    void commit() {
+        if (_checkpoints.empty()) {
+            throw std::logic_error("Tried committing without checkpoint.");
+        }
+        _checkpoints.pop_back();
+        if (_checkpoints.empty()) {
+            _journal.clear();
+        }
+        trimBlanks();
+    }
+
+    /**
+     * @return whether insertions and erasures are currently recorded
+     */
+    [[nodiscard]] bool journaling() const {
+        return !_checkpoints.empty();
+    }
+
+    /**
+     * @return the number of recorded journal entries
+     */
+    [[nodiscard]] std::size_t journal_size() const {
+        return _journal.size();
+    }
+
+    /**
+     * Calls f with the index of every insertion and erasure recorded since the last checkpoint, e.g., to find the
+     * elements which a rollback() is about to restore or erase.
+     * @param f the callback
+     */
+    template<typename F>
+    void for_each_journaled(F &&f) const {
+        if (!_checkpoints.empty()) {
+            for (auto it = _journal.begin() + _checkpoints.back(); it != _journal.end(); ++it) {
+                f(it->index);
+            }
+        }
+    }
+
+    /**
+     * Undoes recorded journal entries in reverse order until the journal has the requested size. Used by owners of
+     * this container to interleave the rollback with their own journal.
+     * @param size the target journal size
+     */
+    void rollback_to(std::size_t size) {
+        while (_journal.size() > size) {
+            auto &entry = _journal.back();
+            switch (entry.type) {
+                case JournalEntry::Type::appended: {
+                    _backingVector.pop_back();
+                    break;
+                }
+                case JournalEntry::Type::reusedBlank: {
+                    (_backingVector.begin() + entry.index.value)->deactivate();
+                    insertBlank(entry.index);
+                    break;
+                }
+                case JournalEntry::Type::erased: {
+                    *(_backingVector.begin() + entry.index.value) = std::move(*entry.element);
+                    _blanks.erase(entry.index);
+                    break;
+                }
+            }
+            _journal.pop_back();
+        }
+    }
+
 private:
 
+    struct JournalEntry {
+        enum class Type {
+            appended, reusedBlank, erased
+        };
+        Type type;
+        persistent_index_t index;
+        // copy of the element before it was erased
+        std::optional<T> element {};
+    };
+
+    /**
+     * Makes sure that a new element at the given position is addressable by persistent_index_t.
+     * @param position the position of the new element
+     * @throws std::length_error if the position exceeds the range of the index type
+     */
+    static void checkIndexCapacity([[maybe_unused]] std::size_t position) {
+        using index_value_t = typename persistent_index_t::value_type;
+        if constexpr (sizeof(index_value_t) < sizeof(std::size_t)) {
+            if (position > std::numeric_limits<index_value_t>::max()) {
+                throw std::length_error(fmt::format("Position {} exceeds the range of {}-bit persistent indices.",
+                                                    position, 8 * sizeof(index_value_t)));
+            }
+        }
+    }
+
+    void record(typename JournalEntry::Type type, persistent_index_t index) {
+        if (journaling()) {
+            _journal.push_back({type, index});
+        }
+    }
+
+    void recordErase(persistent_index_t index) {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            if (journaling()) {
+                _journal.push_back({JournalEntry::Type::erased, index, *(_backingVector.begin() + index.value)});
+            }
+        }
+    }
+
     void deactivate(iterator it) {
         it->deactivate();
     }
 
     void insertBlank(typename BlanksList::value_type val) {
-        auto it = std::lower_bound(_blanks.begin(), _blanks.end(), val, std::less<>());
-        _blanks.insert(it, val);
+        _blanks.insert(val);
+        queueBlank(val);
+    }
+
+    void queueBlank(persistent_index_t index) {
+        if (_reuse == BlankReuse::fifo) {
+            _erasedBlanks.push_back(index);
+            if (_nQueued.size() <= index.value) {
+                _nQueued.resize(index.value + 1);
+            }
+            ++_nQueued[index.value];
+        }
+    }
+
+    /**
+     * Removes the blank to be refilled next from the blanks according to the policy, in O(log #slots).
+     * @param hint the index close to which a blank is selected with the nearest policy
+     * @return the blank
+     */
+    persistent_index_t takeBlank(persistent_index_t hint) {
+        auto index = _blanks.select(_blanks.size() - 1);
+        switch (_reuse) {
+            case BlankReuse::largestFirst: {
+                break;
+            }
+            case BlankReuse::lowestFirst: {
+                index = _blanks.select(0);
+                break;
+            }
+            case BlankReuse::nearest: {
+                auto rank = _blanks.rank(hint.value);
+                if (rank == _blanks.size()) {
+                    break;
+                }
+                index = _blanks.select(rank);
+                if (rank > 0) {
+                    auto previous = _blanks.select(rank - 1);
+                    if (hint.value - previous.value < index.value - hint.value) {
+                        index = previous;
+                    }
+                }
+                break;
+            }
+            case BlankReuse::fifo: {
+                // an index is queued once per erasure, only its last entry counts if it is still a blank; the others
+                // belong to erasures which were undone or refilled in the meantime
+                while (_erasedFront < _erasedBlanks.size()) {
+                    auto queued = _erasedBlanks[_erasedFront++];
+                    if (2 * _erasedFront > _erasedBlanks.size()) {
+                        _erasedBlanks.erase(_erasedBlanks.begin(), _erasedBlanks.begin() + _erasedFront);
+                        _erasedFront = 0;
+                    }
+                    if (--_nQueued[queued.value] == 0 && _blanks.contains(queued.value)) {
+                        index = queued;
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+        _blanks.erase(index);
+        return index;
+    }
+
+    /**
+     * With the lowestFirst policy, drops the blanks at the end of the backing vector, unless journaling.
+     */
+    void trimBlanks() {
+        if (_reuse == BlankReuse::lowestFirst && !journaling()) {
+            while (!_backingVector.empty() && _blanks.contains(_backingVector.size() - 1)) {
+                _blanks.erase(persistent_index_t::of(_backingVector.size() - 1));
+                _backingVector.pop_back();
+            }
+        }
     }
 
     BlanksList _blanks {};
     BackingVector<T, Rest...> _backingVector {};
+    std::vector<JournalEntry> _journal {};
+    std::vector<std::size_t> _checkpoints {};
+    BlankReuse _reuse {BlankReuse::largestFirst};
+    // blanks in the order of their erasure, only maintained with the fifo policy
+    std::vector<persistent_index_t> _erasedBlanks {};
+    // position of the head of the queue in _erasedBlanks, the consumed part is dropped once it is the larger one
+    std::size_t _erasedFront {0};
+    // number of entries of every index in the queue
+    std::vector<std::uint32_t> _nQueued {};
+    // the most recently inserted index, the default hint of the nearest policy
+    persistent_index_t _hint {};
 };
 
 }
 }
 
 namespace fmt {
-template<>
-struct formatter<graphs::PersistentIndex> {
+template<typename T>
+struct formatter<graphs::BasicPersistentIndex<T>> {
     template <typename ParseContext>
     constexpr auto parse(ParseContext &ctx) { return ctx.begin(); }
 
     template <typename FormatContext>
-    auto format(const graphs::PersistentIndex &v, FormatContext &ctx) {
+    auto format(const graphs::BasicPersistentIndex<T> &v, FormatContext &ctx) {
         return format_to(ctx.out(), "PersistentIndex[{}]", v.value);
     }
 };
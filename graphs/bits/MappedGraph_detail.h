@@ -0,0 +1,335 @@
+/**
+ * @file MappedGraph_detail.h
+ * @brief Definitions for the MappedGraph
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../Graph.h"
+#include "../MappedGraph.h"
+
+namespace graphs {
+
+namespace detail {
+inline constexpr char mappedGraphMagic[4] {'G', 'R', 'P', 'M'};
+inline constexpr std::uint32_t mappedGraphVersion = 1;
+inline constexpr std::size_t mappedGraphAlignment = 64;
+
+/**
+ * Header of the mappable layout, a sequence of little-endian 64 bit words. The fixed part is followed by (offset,
+ * size in bytes) of every vertex data column.
+ */
+struct MappedGraphHeader {
+    enum Word : std::size_t {
+        magicAndVersion, nFields, nSlots, nVertices, nNeighbors, nEdges, offsets, neighbors, active, activeIndices,
+        nFixedWords
+    };
+
+    static constexpr std::size_t size(std::size_t nFields) {
+        return (nFixedWords + 2 * nFields) * sizeof(std::uint64_t);
+    }
+};
+
+inline constexpr std::size_t alignSection(std::size_t position) {
+    return (position + mappedGraphAlignment - 1) / mappedGraphAlignment * mappedGraphAlignment;
+}
+}
+
+template<typename Graph>
+inline void MappedGraph<Graph>::write(const Graph &graph, std::ostream &os) {
+    using Header = detail::MappedGraphHeader;
+    constexpr auto nFields = std::tuple_size_v<Fields>;
+    const auto &vertices = graph.vertices();
+    auto nSlots = vertices.size_persistent();
+    std::size_t nNeighbors = 0;
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            nNeighbors += it->neighbors().size();
+        }
+    }
+
+    std::vector<std::uint64_t> header(Header::size(nFields) / sizeof(std::uint64_t));
+    {
+        std::uint64_t magicAndVersion = detail::mappedGraphVersion;
+        magicAndVersion <<= 32;
+        for (std::size_t i = 0; i < sizeof(detail::mappedGraphMagic); ++i) {
+            magicAndVersion |= static_cast<std::uint64_t>(static_cast<unsigned char>(detail::mappedGraphMagic[i]))
+                    << (8 * i);
+        }
+        header[Header::magicAndVersion] = magicAndVersion;
+    }
+    header[Header::nFields] = nFields;
+    header[Header::nSlots] = nSlots;
+    header[Header::nVertices] = vertices.size();
+    header[Header::nNeighbors] = nNeighbors;
+    header[Header::nEdges] = graph.nEdges();
+    auto position = detail::alignSection(Header::size(nFields));
+    auto section = [&position](std::size_t bytes) {
+        auto offset = position;
+        position = detail::alignSection(position + bytes);
+        return offset;
+    };
+    header[Header::offsets] = section((nSlots + 1) * sizeof(std::uint64_t));
+    header[Header::neighbors] = section(nNeighbors * sizeof(std::uint64_t));
+    header[Header::active] = section(nSlots);
+    header[Header::activeIndices] = section(vertices.size() * sizeof(std::uint64_t));
+    detail::forEachField<Fields>([&](auto field) {
+        auto bytes = nSlots * sizeof(std::tuple_element_t<field, Fields>);
+        header[Header::nFixedWords + 2 * field] = section(bytes);
+        header[Header::nFixedWords + 2 * field + 1] = bytes;
+    });
+
+    BinaryWriter writer(os);
+    std::size_t written = 0;
+    auto pad = [&writer, &written](std::size_t offset) {
+        static constexpr char zeros[detail::mappedGraphAlignment] {};
+        writer.writeBytes(zeros, offset - written);
+        written = offset;
+    };
+    writer.writeArray(header.data(), header.size());
+    written = Header::size(nFields);
+
+    pad(header[Header::offsets]);
+    std::uint64_t offset = 0;
+    writer.write(offset);
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            offset += it->neighbors().size();
+        }
+        writer.write(offset);
+    }
+    written += (nSlots + 1) * sizeof(std::uint64_t);
+
+    pad(header[Header::neighbors]);
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it) {
+        if (!it->deactivated()) {
+            detail::writeIndices(writer, it->neighbors().data(), it->neighbors().size());
+        }
+    }
+    written += nNeighbors * sizeof(std::uint64_t);
+
+    pad(header[Header::active]);
+    for (auto it = vertices.cbegin_persistent(); it != vertices.cend_persistent(); ++it) {
+        writer.write(static_cast<std::uint8_t>(!it->deactivated()));
+    }
+    written += nSlots;
+
+    pad(header[Header::activeIndices]);
+    for (auto it = vertices.cbegin(); it != vertices.cend(); ++it) {
+        writer.write(static_cast<std::uint64_t>(it.persistent_index().value));
+    }
+    written += vertices.size() * sizeof(std::uint64_t);
+
+    detail::forEachField<Fields>([&](auto field) {
+        using T = std::tuple_element_t<field, Fields>;
+        pad(header[Header::nFixedWords + 2 * field]);
+        std::vector<T> column;
+        column.reserve(std::min(nSlots, detail::graphFormatBlockSize));
+        for (std::size_t first = 0; first < nSlots; first += detail::graphFormatBlockSize) {
+            auto last = std::min(nSlots, first + detail::graphFormatBlockSize);
+            column.clear();
+            for (auto it = vertices.cbegin_persistent() + first; it != vertices.cbegin_persistent() + last; ++it) {
+                column.push_back(detail::dataField<field>(*it));
+            }
+            writer.writeArray(column.data(), column.size());
+        }
+        written += nSlots * sizeof(T);
+    });
+    writer.flush();
+}
+
+template<typename Graph>
+inline MappedGraph<Graph>::MappedGraph(const std::string &path) : _file(path) {
+    if (_file.size() == 0) {
+        throw std::runtime_error("Not a mapped graph: " + path + " is empty.");
+    }
+    attach(_file.data(), _file.size());
+}
+
+template<typename Graph>
+inline MappedGraph<Graph>::MappedGraph(const void *data, std::size_t size) {
+    attach(data, size);
+}
+
+template<typename Graph>
+inline void MappedGraph<Graph>::attach(const void *data, std::size_t size) {
+    using Header = detail::MappedGraphHeader;
+    constexpr auto nFields = std::tuple_size_v<Fields>;
+    if (!detail::littleEndianHost()) {
+        throw std::runtime_error("Mapped graphs require a little-endian host.");
+    }
+    auto bytes = static_cast<const unsigned char *>(data);
+    if (size < Header::size(0)) {
+        throw std::runtime_error("Not a mapped graph: too small.");
+    }
+    auto word = [bytes](std::size_t i) {
+        std::uint64_t value;
+        std::memcpy(&value, bytes + i * sizeof(std::uint64_t), sizeof(value));
+        return value;
+    };
+    if (!std::equal(bytes, bytes + sizeof(detail::mappedGraphMagic), std::begin(detail::mappedGraphMagic))) {
+        throw std::runtime_error("Not a mapped graph.");
+    }
+    if ((word(Header::magicAndVersion) >> 32) != detail::mappedGraphVersion) {
+        throw std::runtime_error("Unsupported mapped graph version.");
+    }
+    if (word(Header::nFields) != nFields || size < Header::size(nFields)) {
+        throw std::runtime_error("The mapped graph was written with another vertex data layout.");
+    }
+    _nSlots = word(Header::nSlots);
+    _nVertices = word(Header::nVertices);
+    _nEdges = word(Header::nEdges);
+    _nNeighbors = word(Header::nNeighbors);
+    // compares element counts instead of byte sizes, so that corrupt counts cannot overflow
+    auto checkSection = [size](std::uint64_t offset, std::uint64_t count, std::size_t elementSize,
+                               std::size_t alignment) {
+        if (offset % alignment != 0 || offset > size || count > (size - offset) / elementSize) {
+            throw std::runtime_error("Corrupt mapped graph: section out of bounds.");
+        }
+    };
+    checkSection(word(Header::active), _nSlots, 1, 1);
+    if (_nVertices > _nSlots) {
+        throw std::runtime_error("Corrupt mapped graph: more vertices than slots.");
+    }
+    checkSection(word(Header::offsets), _nSlots + 1, sizeof(std::uint64_t), alignof(std::uint64_t));
+    checkSection(word(Header::neighbors), _nNeighbors, sizeof(PersistentVertexIndex), alignof(PersistentVertexIndex));
+    checkSection(word(Header::activeIndices), _nVertices, sizeof(PersistentVertexIndex),
+                 alignof(PersistentVertexIndex));
+    _offsets = reinterpret_cast<const std::uint64_t *>(bytes + word(Header::offsets));
+    _neighbors = reinterpret_cast<const PersistentVertexIndex *>(bytes + word(Header::neighbors));
+    _active = bytes + word(Header::active);
+    _activeIndices = reinterpret_cast<const PersistentVertexIndex *>(bytes + word(Header::activeIndices));
+    if (_offsets[_nSlots] != _nNeighbors) {
+        throw std::runtime_error("Corrupt mapped graph: invalid neighbor offsets.");
+    }
+    _columns.clear();
+    detail::forEachField<Fields>([&](auto field) {
+        using T = std::tuple_element_t<field, Fields>;
+        auto offset = word(Header::nFixedWords + 2 * field);
+        checkSection(offset, _nSlots, sizeof(T), alignof(T));
+        if (word(Header::nFixedWords + 2 * field + 1) != _nSlots * sizeof(T)) {
+            throw std::runtime_error("The mapped graph was written with another vertex data layout.");
+        }
+        _columns.push_back(bytes + offset);
+    });
+}
+
+template<typename Graph>
+template<std::size_t I>
+inline const std::tuple_element_t<I, typename MappedGraph<Graph>::Fields> *MappedGraph<Graph>::column() const {
+    return reinterpret_cast<const std::tuple_element_t<I, Fields> *>(_columns[I]);
+}
+
+template<typename Graph>
+inline std::size_t MappedGraph<Graph>::size_persistent() const {
+    return _nSlots;
+}
+
+template<typename Graph>
+inline std::size_t MappedGraph<Graph>::nVertices() const {
+    return _nVertices;
+}
+
+template<typename Graph>
+inline std::size_t MappedGraph<Graph>::nEdges() const {
+    return _nEdges;
+}
+
+template<typename Graph>
+inline bool MappedGraph<Graph>::active(PersistentVertexIndex ix) const {
+    return ix.value < _nSlots && _active[ix.value] != 0;
+}
+
+template<typename Graph>
+inline typename MappedGraph<Graph>::PersistentVertexIndex MappedGraph<Graph>::persistentIndex(std::size_t activeIndex) const {
+    if (activeIndex >= _nVertices) {
+        throw std::out_of_range("Active vertex index out of range.");
+    }
+    return checked(_activeIndices[activeIndex]);
+}
+
+template<typename Graph>
+inline typename MappedGraph<Graph>::PersistentVertexIndex MappedGraph<Graph>::checked(PersistentVertexIndex ix) const {
+    if (ix.value >= _nSlots) {
+        throw std::runtime_error("Corrupt mapped graph: vertex index out of range.");
+    }
+    return ix;
+}
+
+template<typename Graph>
+inline typename MappedGraph<Graph>::NeighborRange MappedGraph<Graph>::neighbors(PersistentVertexIndex ix) const {
+    if (ix.value >= _nSlots) {
+        throw std::out_of_range("Vertex index out of range.");
+    }
+    auto first = _offsets[ix.value];
+    auto last = _offsets[ix.value + 1];
+    if (first > last || last > _nNeighbors) {
+        throw std::runtime_error("Corrupt mapped graph: invalid neighbor offsets.");
+    }
+    return {_neighbors + first, _neighbors + last};
+}
+
+template<typename Graph>
+inline decltype(auto) MappedGraph<Graph>::data(PersistentVertexIndex ix) const {
+    if constexpr (std::tuple_size_v<Fields> == 1) {
+        return static_cast<const data_type &>(column<0>()[ix.value]);
+    } else {
+        return std::apply([this, ix](auto... field) {
+            return Fields{column<decltype(field)::value>()[ix.value]...};
+        }, detail::fieldIndices<Fields>());
+    }
+}
+
+template<typename Graph>
+inline std::int32_t MappedGraph<Graph>::graphDistance(PersistentVertexIndex source, PersistentVertexIndex target) const {
+    if (!active(source) || !active(target)) {
+        throw std::out_of_range("Graph distance between inactive vertices.");
+    }
+    std::vector<std::int32_t> distances(_nSlots, -1);
+    std::vector<PersistentVertexIndex> queue;
+    distances[source.value] = 0;
+    queue.push_back(source);
+    for (std::size_t head = 0; head < queue.size() && distances[target.value] < 0; ++head) {
+        auto ix = queue[head];
+        for (auto neighbor : neighbors(ix)) {
+            if (distances[checked(neighbor).value] < 0) {
+                distances[neighbor.value] = distances[ix.value] + 1;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+    return distances[target.value];
+}
+
+template<typename Graph>
+inline std::vector<std::size_t> MappedGraph<Graph>::componentLabels() const {
+    std::vector<std::size_t> labels(_nSlots, npos);
+    std::vector<PersistentVertexIndex> unvisited;
+    std::size_t label = 0;
+    for (std::size_t i = 0; i < _nVertices; ++i) {
+        auto start = checked(_activeIndices[i]);
+        if (labels[start.value] != npos) {
+            continue;
+        }
+        unvisited.push_back(start);
+        labels[start.value] = label;
+        while (!unvisited.empty()) {
+            auto current = unvisited.back();
+            unvisited.pop_back();
+            for (auto neighbor : neighbors(current)) {
+                if (labels[checked(neighbor).value] == npos) {
+                    labels[neighbor.value] = label;
+                    unvisited.push_back(neighbor);
+                }
+            }
+        }
+        ++label;
+    }
+    return labels;
+}
+
+}
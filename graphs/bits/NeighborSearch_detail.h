@@ -0,0 +1,404 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if !defined(GRAPHS_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GRAPHS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#include "../NeighborSearch.h"
+
+namespace graphs {
+
+namespace detail::simd {
+
+#ifdef GRAPHS_SIMD_X86
+
+/*
+ * The kernels return the position of the first match or n. The main loops compare four vectors at once and only
+ * locate the match within them once one was found. Pair kernels search pairs of words (a, b) or (b, a): words equal to
+ * a are and-ed with the words equal to b of the swapped pair, a pair matches if any of its lanes is set.
+ */
+
+inline std::size_t firstSet(unsigned int mask) {
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+}
+
+inline __m128i load(const void *p) {
+    return _mm_loadu_si128(static_cast<const __m128i *>(p));
+}
+
+inline __m128i cmpeq64Sse2(__m128i x, __m128i y) {
+    auto eq = _mm_cmpeq_epi32(x, y);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+template<typename T>
+std::size_t findScalar(const T *data, std::size_t i, std::size_t n, T value) {
+    for (; i < n; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template<typename T>
+std::size_t findPairScalar(const T *words, std::size_t i, std::size_t nPairs, T a, T b) {
+    for (; i < nPairs; ++i) {
+        auto w0 = words[2 * i];
+        auto w1 = words[2 * i + 1];
+        if ((w0 == a && w1 == b) || (w0 == b && w1 == a)) {
+            return i;
+        }
+    }
+    return nPairs;
+}
+
+inline std::size_t find32Sse2(const std::uint32_t *data, std::size_t n, std::uint32_t value) {
+    const auto needle = _mm_set1_epi32(static_cast<int>(value));
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(load(data + i), needle),
+                                            _mm_cmpeq_epi32(load(data + i + 4), needle)),
+                               _mm_or_si128(_mm_cmpeq_epi32(load(data + i + 8), needle),
+                                            _mm_cmpeq_epi32(load(data + i + 12), needle)));
+        if (_mm_movemask_epi8(eq) != 0) {
+            break;
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        auto mask = _mm_movemask_epi8(_mm_cmpeq_epi32(load(data + i), needle));
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 4;
+        }
+    }
+    return findScalar(data, i, n, value);
+}
+
+inline std::size_t find64Sse2(const std::uint64_t *data, std::size_t n, std::uint64_t value) {
+    const auto needle = _mm_set1_epi64x(static_cast<long long>(value));
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        auto eq = _mm_or_si128(_mm_or_si128(cmpeq64Sse2(load(data + i), needle),
+                                            cmpeq64Sse2(load(data + i + 2), needle)),
+                               _mm_or_si128(cmpeq64Sse2(load(data + i + 4), needle),
+                                            cmpeq64Sse2(load(data + i + 6), needle)));
+        if (_mm_movemask_epi8(eq) != 0) {
+            break;
+        }
+    }
+    for (; i + 2 <= n; i += 2) {
+        auto mask = _mm_movemask_epi8(cmpeq64Sse2(load(data + i), needle));
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 8;
+        }
+    }
+    return findScalar(data, i, n, value);
+}
+
+inline std::size_t findPair32Sse2(const std::uint32_t *words, std::size_t nPairs, std::uint32_t a, std::uint32_t b) {
+    const auto needleA = _mm_set1_epi32(static_cast<int>(a));
+    const auto needleB = _mm_set1_epi32(static_cast<int>(b));
+    auto match = [&](const std::uint32_t *p) {
+        auto x = load(p);
+        auto eqB = _mm_cmpeq_epi32(x, needleB);
+        return _mm_and_si128(_mm_cmpeq_epi32(x, needleA), _mm_shuffle_epi32(eqB, _MM_SHUFFLE(2, 3, 0, 1)));
+    };
+    std::size_t i = 0;
+    for (; i + 2 <= nPairs; i += 2) {
+        auto mask = _mm_movemask_epi8(match(words + 2 * i));
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 8;
+        }
+    }
+    return findPairScalar(words, i, nPairs, a, b);
+}
+
+inline std::size_t findPair64Sse2(const std::uint64_t *words, std::size_t nPairs, std::uint64_t a, std::uint64_t b) {
+    const auto needleA = _mm_set1_epi64x(static_cast<long long>(a));
+    const auto needleB = _mm_set1_epi64x(static_cast<long long>(b));
+    for (std::size_t i = 0; i < nPairs; ++i) {
+        auto x = load(words + 2 * i);
+        auto eqB = cmpeq64Sse2(x, needleB);
+        auto eq = _mm_and_si128(cmpeq64Sse2(x, needleA), _mm_shuffle_epi32(eqB, _MM_SHUFFLE(1, 0, 3, 2)));
+        if (_mm_movemask_epi8(eq) != 0) {
+            return i;
+        }
+    }
+    return nPairs;
+}
+
+__attribute__((target("avx2")))
+inline __m256i load256(const void *p) {
+    return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find32Avx2(const std::uint32_t *data, std::size_t n, std::uint32_t value) {
+    const auto needle = _mm256_set1_epi32(static_cast<int>(value));
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        auto eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi32(load256(data + i), needle),
+                                                  _mm256_cmpeq_epi32(load256(data + i + 8), needle)),
+                                  _mm256_or_si256(_mm256_cmpeq_epi32(load256(data + i + 16), needle),
+                                                  _mm256_cmpeq_epi32(load256(data + i + 24), needle)));
+        if (!_mm256_testz_si256(eq, eq)) {
+            break;
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        auto mask = _mm256_movemask_epi8(_mm256_cmpeq_epi32(load256(data + i), needle));
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 4;
+        }
+    }
+    return i + find32Sse2(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find64Avx2(const std::uint64_t *data, std::size_t n, std::uint64_t value) {
+    const auto needle = _mm256_set1_epi64x(static_cast<long long>(value));
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi64(load256(data + i), needle),
+                                                  _mm256_cmpeq_epi64(load256(data + i + 4), needle)),
+                                  _mm256_or_si256(_mm256_cmpeq_epi64(load256(data + i + 8), needle),
+                                                  _mm256_cmpeq_epi64(load256(data + i + 12), needle)));
+        if (!_mm256_testz_si256(eq, eq)) {
+            break;
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        auto mask = _mm256_movemask_epi8(_mm256_cmpeq_epi64(load256(data + i), needle));
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 8;
+        }
+    }
+    return i + find64Sse2(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t findPair32Avx2(const std::uint32_t *words, std::size_t nPairs, std::uint32_t a, std::uint32_t b) {
+    const auto needleA = _mm256_set1_epi32(static_cast<int>(a));
+    const auto needleB = _mm256_set1_epi32(static_cast<int>(b));
+    std::size_t i = 0;
+    for (; i + 4 <= nPairs; i += 4) {
+        auto x = load256(words + 2 * i);
+        auto eqB = _mm256_cmpeq_epi32(x, needleB);
+        auto eq = _mm256_and_si256(_mm256_cmpeq_epi32(x, needleA),
+                                   _mm256_shuffle_epi32(eqB, _MM_SHUFFLE(2, 3, 0, 1)));
+        auto mask = _mm256_movemask_epi8(eq);
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 8;
+        }
+    }
+    return i + findPair32Sse2(words + 2 * i, nPairs - i, a, b);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t findPair64Avx2(const std::uint64_t *words, std::size_t nPairs, std::uint64_t a, std::uint64_t b) {
+    const auto needleA = _mm256_set1_epi64x(static_cast<long long>(a));
+    const auto needleB = _mm256_set1_epi64x(static_cast<long long>(b));
+    std::size_t i = 0;
+    for (; i + 2 <= nPairs; i += 2) {
+        auto x = load256(words + 2 * i);
+        auto eqB = _mm256_cmpeq_epi64(x, needleB);
+        auto eq = _mm256_and_si256(_mm256_cmpeq_epi64(x, needleA),
+                                   _mm256_shuffle_epi32(eqB, _MM_SHUFFLE(1, 0, 3, 2)));
+        auto mask = _mm256_movemask_epi8(eq);
+        if (mask != 0) {
+            return i + firstSet(static_cast<unsigned int>(mask)) / 16;
+        }
+    }
+    return i + findPair64Sse2(words + 2 * i, nPairs - i, a, b);
+}
+
+template<typename T>
+std::size_t find(const T *data, std::size_t n, T value, SimdLevel level) {
+    if constexpr (sizeof(T) == sizeof(std::uint32_t)) {
+        return level == SimdLevel::avx2 ? find32Avx2(data, n, value) : find32Sse2(data, n, value);
+    } else {
+        return level == SimdLevel::avx2 ? find64Avx2(data, n, value) : find64Sse2(data, n, value);
+    }
+}
+
+template<typename T>
+std::size_t findPair(const T *words, std::size_t nPairs, T a, T b, SimdLevel level) {
+    if constexpr (sizeof(T) == sizeof(std::uint32_t)) {
+        return level == SimdLevel::avx2 ? findPair32Avx2(words, nPairs, a, b) : findPair32Sse2(words, nPairs, a, b);
+    } else {
+        return level == SimdLevel::avx2 ? findPair64Avx2(words, nPairs, a, b) : findPair64Sse2(words, nPairs, a, b);
+    }
+}
+
+#endif
+
+/**
+ * Below this number of elements a scalar search, which stops at the first match, is faster than the kernels.
+ */
+inline constexpr std::size_t minLength = 64;
+
+/**
+ * Whether the kernels apply to an index type: an unsigned integer of 32 or 64 bits without padding.
+ */
+template<typename Index>
+inline constexpr bool vectorizable_v = sizeof(Index) == sizeof(typename Index::value_type) &&
+                                       (sizeof(Index) == sizeof(std::uint32_t) ||
+                                        sizeof(Index) == sizeof(std::uint64_t));
+
+/**
+ * The fixed-width word the kernels read an index as, e.g., std::uint64_t for a std::size_t index.
+ */
+template<typename Index>
+using word_t = std::conditional_t<sizeof(Index) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+
+/**
+ * Whether the words of a range of edges can be searched as pairs of indices.
+ */
+template<typename Edge, typename Index>
+inline constexpr bool vectorizable_edge_v = vectorizable_v<Index> && sizeof(Edge) == 2 * sizeof(Index) &&
+                                            std::is_same_v<Edge, std::tuple<Index, Index>>;
+
+}
+
+inline SimdLevel simdLevel() {
+    static const SimdLevel level = [] {
+#ifdef GRAPHS_SIMD_X86
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::avx2 : SimdLevel::sse2;
+#else
+        return SimdLevel::scalar;
+#endif
+    }();
+    return level;
+}
+
+inline bool simdSupported(SimdLevel level) {
+    return level <= simdLevel();
+}
+
+template<typename Index>
+inline const Index *findIndex(const Index *first, const Index *last, Index value, [[maybe_unused]] SimdLevel level) {
+#ifdef GRAPHS_SIMD_X86
+    if constexpr (detail::simd::vectorizable_v<Index>) {
+        if (level != SimdLevel::scalar) {
+            using T = detail::simd::word_t<Index>;
+            return first + detail::simd::find(reinterpret_cast<const T *>(first), static_cast<std::size_t>(last - first),
+                                              static_cast<T>(value.value), level);
+        }
+    }
+#endif
+    return std::find(first, last, value);
+}
+
+template<typename Edge, typename Index>
+inline const Edge *findEdge(const Edge *first, const Edge *last, Index ix1, Index ix2,
+                            [[maybe_unused]] SimdLevel level) {
+#ifdef GRAPHS_SIMD_X86
+    if constexpr (detail::simd::vectorizable_edge_v<Edge, Index>) {
+        if (level != SimdLevel::scalar) {
+            using T = detail::simd::word_t<Index>;
+            // the layout of std::tuple is unspecified, but both orientations are searched
+            return first + detail::simd::findPair(reinterpret_cast<const T *>(first), static_cast<std::size_t>(last - first),
+                                                  static_cast<T>(ix1.value), static_cast<T>(ix2.value), level);
+        }
+    }
+#endif
+    return std::find_if(first, last, [ix1, ix2](const Edge &edge) {
+        const auto &[e1, e2] = edge;
+        return (e1 == ix1 && e2 == ix2) || (e1 == ix2 && e2 == ix1);
+    });
+}
+
+template<typename Edge, typename Index>
+inline const Edge *findIncidentEdge(const Edge *first, const Edge *last, Index ix, [[maybe_unused]] SimdLevel level) {
+#ifdef GRAPHS_SIMD_X86
+    if constexpr (detail::simd::vectorizable_edge_v<Edge, Index>) {
+        if (level != SimdLevel::scalar) {
+            using T = detail::simd::word_t<Index>;
+            auto nWords = 2 * static_cast<std::size_t>(last - first);
+            return first + detail::simd::find(reinterpret_cast<const T *>(first), nWords, static_cast<T>(ix.value),
+                                              level) / 2;
+        }
+    }
+#endif
+    return std::find_if(first, last, [ix](const Edge &edge) {
+        return std::get<0>(edge) == ix || std::get<1>(edge) == ix;
+    });
+}
+
+namespace detail {
+
+template<typename List, typename = void>
+struct is_contiguous : std::false_type {
+};
+template<typename List>
+struct is_contiguous<List, std::void_t<decltype(std::declval<const List &>().data())>>
+        : std::is_same<decltype(std::declval<const List &>().data()), const typename List::value_type *> {
+};
+
+/**
+ * std::find of an index in a neighbor list, vectorized if the list is contiguous and long enough.
+ */
+template<typename NeighborList, typename Index>
+auto findNeighbor(const NeighborList &neighbors, Index neighbor) {
+    if constexpr (is_contiguous<NeighborList>::value && std::is_same_v<typename NeighborList::value_type, Index>) {
+        if (neighbors.size() < simd::minLength) {
+            return std::find(neighbors.begin(), neighbors.end(), neighbor);
+        }
+        const auto *data = neighbors.data();
+        return neighbors.begin() + (graphs::findIndex(data, data + neighbors.size(), neighbor) - data);
+    } else {
+        return std::find(neighbors.begin(), neighbors.end(), neighbor);
+    }
+}
+
+/**
+ * First edge (ix1, ix2) or (ix2, ix1) in an edge list, vectorized if the list is contiguous and long enough.
+ */
+template<typename EdgeList, typename Index>
+typename EdgeList::const_iterator findEdge(const EdgeList &edges, Index ix1, Index ix2) {
+    if constexpr (is_contiguous<EdgeList>::value) {
+        const auto *data = edges.data();
+        return edges.cbegin() + (graphs::findEdge(data, data + edges.size(), ix1, ix2,
+                                                  edges.size() < simd::minLength ? SimdLevel::scalar : simdLevel()) -
+                                 data);
+    } else {
+        return std::find_if(edges.cbegin(), edges.cend(), [ix1, ix2](const auto &edge) {
+            const auto &[e1, e2] = edge;
+            return (e1 == ix1 && e2 == ix2) || (e1 == ix2 && e2 == ix1);
+        });
+    }
+}
+
+/**
+ * First edge incident to ix in an edge list, vectorized if the list is contiguous and long enough.
+ */
+template<typename EdgeList, typename Index>
+typename EdgeList::const_iterator findIncidentEdge(const EdgeList &edges, Index ix) {
+    if constexpr (is_contiguous<EdgeList>::value) {
+        const auto *data = edges.data();
+        return edges.cbegin() + (graphs::findIncidentEdge(data, data + edges.size(), ix,
+                                                          edges.size() < simd::minLength ? SimdLevel::scalar
+                                                                                         : simdLevel()) - data);
+    } else {
+        return std::find_if(edges.cbegin(), edges.cend(), [ix](const auto &edge) {
+            return std::get<0>(edge) == ix || std::get<1>(edge) == ix;
+        });
+    }
+}
+
+}
+
+}
@@ -0,0 +1,355 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../PackedVertex.h"
+
+namespace graphs {
+
+namespace detail {
+
+/**
+ * Vector of neighbor indices with 32-bit size and capacity. The top bit of the capacity is a flag owned by the
+ * vertex (its deactivated state), it is neither copied nor moved along with the elements.
+ * @tparam Index the persistent index type
+ */
+template<typename Index>
+class PackedNeighborList {
+    static_assert(std::is_trivially_copyable_v<Index>);
+    static constexpr std::uint32_t flagBit = std::uint32_t{1} << 31;
+public:
+    using value_type = Index;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = std::allocator<Index>;
+    using reference = Index &;
+    using const_reference = const Index &;
+    using iterator = Index *;
+    using const_iterator = const Index *;
+
+    PackedNeighborList() noexcept = default;
+
+    PackedNeighborList(const PackedNeighborList &other) {
+        assign(other.begin(), other.end());
+    }
+
+    PackedNeighborList(PackedNeighborList &&other) noexcept {
+        steal(other);
+    }
+
+    PackedNeighborList &operator=(const PackedNeighborList &rhs) {
+        if (this != &rhs) {
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    PackedNeighborList &operator=(PackedNeighborList &&rhs) noexcept {
+        if (this != &rhs) {
+            release();
+            steal(rhs);
+        }
+        return *this;
+    }
+
+    ~PackedNeighborList() {
+        release();
+    }
+
+    /**
+     * Swaps the elements, the flags stay with their lists.
+     */
+    void swap(PackedNeighborList &other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        auto capacity = _capacity & ~flagBit;
+        _capacity = (_capacity & flagBit) | (other._capacity & ~flagBit);
+        other._capacity = (other._capacity & flagBit) | capacity;
+    }
+
+    iterator begin() noexcept { return _data; }
+
+    iterator end() noexcept { return _data + _size; }
+
+    const_iterator begin() const noexcept { return _data; }
+
+    const_iterator end() const noexcept { return _data + _size; }
+
+    const_iterator cbegin() const noexcept { return _data; }
+
+    const_iterator cend() const noexcept { return _data + _size; }
+
+    [[nodiscard]] size_type size() const noexcept { return _size; }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+    [[nodiscard]] size_type capacity() const noexcept { return _capacity & ~flagBit; }
+
+    [[nodiscard]] static constexpr size_type max_size() noexcept { return flagBit - 1; }
+
+    Index *data() noexcept { return _data; }
+
+    const Index *data() const noexcept { return _data; }
+
+    allocator_type get_allocator() const { return {}; }
+
+    Index &operator[](size_type index) { return _data[index]; }
+
+    const Index &operator[](size_type index) const { return _data[index]; }
+
+    Index &front() { return _data[0]; }
+
+    const Index &front() const { return _data[0]; }
+
+    Index &back() { return _data[_size - 1]; }
+
+    const Index &back() const { return _data[_size - 1]; }
+
+    void reserve(size_type n) {
+        if (n > capacity()) {
+            reallocate(n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (capacity() > _size) {
+            reallocate(_size);
+        }
+    }
+
+    void resize(size_type n, Index value = {}) {
+        reserve(n);
+        if (n > _size) {
+            std::uninitialized_fill(end(), _data + n, value);
+        }
+        _size = static_cast<std::uint32_t>(n);
+    }
+
+    void clear() noexcept {
+        _size = 0;
+    }
+
+    void push_back(Index value) {
+        if (_size == capacity()) {
+            reallocate(grownCapacity());
+        }
+        _data[_size++] = value;
+    }
+
+    Index &emplace_back(Index value) {
+        push_back(value);
+        return back();
+    }
+
+    void pop_back() {
+        --_size;
+    }
+
+    iterator insert(const_iterator pos, Index value) {
+        auto offset = pos - _data;
+        push_back(value);
+        std::rotate(_data + offset, end() - 1, end());
+        return _data + offset;
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        auto offset = first - _data;
+        auto it = std::copy(_data + (last - _data), end(), _data + offset);
+        _size = static_cast<std::uint32_t>(it - _data);
+        return _data + offset;
+    }
+
+    bool operator==(const PackedNeighborList &rhs) const {
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    bool operator!=(const PackedNeighborList &rhs) const {
+        return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool flagged() const noexcept {
+        return (_capacity & flagBit) != 0;
+    }
+
+    void setFlag(bool flag) noexcept {
+        _capacity = flag ? (_capacity | flagBit) : (_capacity & ~flagBit);
+    }
+
+private:
+    size_type grownCapacity() const {
+        if (capacity() == max_size()) {
+            throw std::length_error("PackedNeighborList exceeds its maximum size");
+        }
+        return std::clamp<size_type>(2 * capacity(), 1, max_size());
+    }
+
+    template<typename It>
+    void assign(It first, It last) {
+        auto n = static_cast<size_type>(std::distance(first, last));
+        if (n > capacity()) {
+            // the old elements are overwritten anyway, there is nothing to carry over
+            _size = 0;
+            reallocate(n);
+        }
+        std::copy(first, last, _data);
+        _size = static_cast<std::uint32_t>(n);
+    }
+
+    void reallocate(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("PackedNeighborList exceeds its maximum size");
+        }
+        Index *storage = n > 0 ? allocator_type().allocate(n) : nullptr;
+        if (_size > 0) {
+            std::uninitialized_copy(begin(), end(), storage);
+        }
+        auto flag = flagged();
+        release();
+        _data = storage;
+        _capacity = static_cast<std::uint32_t>(n);
+        setFlag(flag);
+    }
+
+    void release() noexcept {
+        if (_data) {
+            allocator_type().deallocate(_data, capacity());
+            _data = nullptr;
+        }
+        _capacity &= flagBit;
+    }
+
+    void steal(PackedNeighborList &other) noexcept {
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _capacity = (_capacity & flagBit) | (other._capacity & ~flagBit);
+        other._capacity &= flagBit;
+    }
+
+    Index *_data {nullptr};
+    std::uint32_t _size {0};
+    std::uint32_t _capacity {0};
+};
+
+/**
+ * A packed vertex owns its neighbors through a plain pointer, it can be relocated by copying its bytes if its data can.
+ */
+template<typename Index, typename... T>
+struct is_trivially_relocatable<BasicPackedVertex<Index, T...>>
+        : std::bool_constant<(std::is_trivially_copyable_v<T> && ...)> {
+};
+
+}
+
+template<typename Index, typename... T>
+inline BasicPackedVertex<Index, T...>::BasicPackedVertex(T&&... data) : _data(std::tuple<T...>(std::forward<T>(data)...)) {}
+
+template<typename Index, typename... T>
+inline BasicPackedVertex<Index, T...>::BasicPackedVertex(data_type data) : _data(std::move(data)) {}
+
+template<typename Index, typename... T>
+inline BasicPackedVertex<Index, T...>::BasicPackedVertex(const BasicPackedVertex &other)
+        : _neighbors(other._neighbors), _data(other._data) {
+    _neighbors.setFlag(other._neighbors.flagged());
+}
+
+template<typename Index, typename... T>
+inline BasicPackedVertex<Index, T...> &BasicPackedVertex<Index, T...>::operator=(const BasicPackedVertex &rhs) {
+    _neighbors = rhs._neighbors;
+    _neighbors.setFlag(rhs._neighbors.flagged());
+    _data = rhs._data;
+    return *this;
+}
+
+template<typename Index, typename... T>
+inline BasicPackedVertex<Index, T...>::BasicPackedVertex(BasicPackedVertex &&other) noexcept
+        : _neighbors(std::move(other._neighbors)), _data(std::move(other._data)) {
+    _neighbors.setFlag(other._neighbors.flagged());
+}
+
+template<typename Index, typename... T>
+inline BasicPackedVertex<Index, T...> &BasicPackedVertex<Index, T...>::operator=(BasicPackedVertex &&rhs) noexcept {
+    _neighbors = std::move(rhs._neighbors);
+    _neighbors.setFlag(rhs._neighbors.flagged());
+    _data = std::move(rhs._data);
+    return *this;
+}
+
+template<typename Index, typename... T>
+inline const typename BasicPackedVertex<Index, T...>::NeighborList &BasicPackedVertex<Index, T...>::neighbors() const {
+    return _neighbors;
+}
+
+template<typename Index, typename... T>
+inline typename BasicPackedVertex<Index, T...>::NeighborList &BasicPackedVertex<Index, T...>::neighbors() {
+    return _neighbors;
+}
+
+template<typename Index, typename... T>
+inline void BasicPackedVertex<Index, T...>::addNeighbor(Index neighbor) {
+    detail::insertNeighbor<false>(_neighbors, neighbor);
+}
+
+template<typename Index, typename... T>
+inline void BasicPackedVertex<Index, T...>::removeNeighbor(Index neighbor) {
+    detail::eraseNeighbor<false>(_neighbors, neighbor);
+}
+
+template<typename Index, typename... T>
+inline const auto &BasicPackedVertex<Index, T...>::data() const {
+    if constexpr (std::tuple_size_v<data_type> == 1) {
+        return std::get<0>(_data);
+    } else {
+        return _data;
+    }
+}
+
+template<typename Index, typename... T>
+inline void BasicPackedVertex<Index, T...>::setData(data_type data) {
+    _data = std::move(data);
+}
+
+template<typename Index, typename... T>
+inline void BasicPackedVertex<Index, T...>::deactivate() {
+    _neighbors.setFlag(true);
+}
+
+template<typename Index, typename... T>
+inline bool BasicPackedVertex<Index, T...>::deactivated() const {
+    return _neighbors.flagged();
+}
+
+}
+
+namespace fmt {
+template<typename Index, typename... T>
+struct formatter<graphs::BasicPackedVertex<Index, T...>> {
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext &ctx) { return ctx.begin(); }
+
+    template <typename FormatContext>
+    auto format(const graphs::BasicPackedVertex<Index, T...> &v, FormatContext &ctx) {
+        std::stringstream ss;
+        bool first {true};
+        for (const auto neighbor : v.neighbors()) {
+            if(!first) {
+                ss << ",";
+            }
+            ss << neighbor.value;
+            first = false;
+        }
+        return format_to(ctx.out(), "Vertex[{}, neighbors=[{}]]", v.data(), ss.str());
+    }
+};
+}
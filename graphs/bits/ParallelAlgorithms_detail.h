@@ -0,0 +1,75 @@
+/**
+ * @file ParallelAlgorithms_detail.h
+ * @brief Definitions for the parallel batch algorithms
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <optional>
+
+#include "../ParallelAlgorithms.h"
+
+namespace graphs::parallel {
+
+namespace detail {
+/**
+ * Orders the graphs of a range by decreasing size, ties are broken by position.
+ */
+template<typename RandomIt>
+std::vector<std::size_t> largestFirst(RandomIt first, RandomIt last) {
+    std::vector<std::size_t> sizes;
+    sizes.reserve(static_cast<std::size_t>(std::distance(first, last)));
+    for (auto it = first; it != last; ++it) {
+        sizes.push_back(it->nVertices() + it->nEdges());
+    }
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](auto i, auto j) { return sizes[i] > sizes[j]; });
+    return order;
+}
+}
+
+template<typename RandomIt, typename Function>
+inline auto transform(ThreadPool &pool, RandomIt first, RandomIt last, const Function &function) {
+    using Result = std::decay_t<decltype(function(*first))>;
+    auto order = detail::largestFirst(first, last);
+    // optional so that results need not be default constructible, every task writes its own slot
+    std::vector<std::optional<Result>> slots(order.size());
+    pool.run(order, [&](std::size_t i) {
+        slots[i].emplace(function(first[i]));
+    });
+    std::vector<Result> results;
+    results.reserve(slots.size());
+    for (auto &slot : slots) {
+        results.push_back(std::move(*slot));
+    }
+    return results;
+}
+
+template<typename RandomIt>
+inline std::vector<bool> isConnected(ThreadPool &pool, RandomIt first, RandomIt last) {
+    // char instead of bool, concurrent writes to distinct elements of a std::vector<bool> would race
+    auto connected = transform(pool, first, last, [](const auto &graph) {
+        return static_cast<char>(graph.isConnected());
+    });
+    return {connected.begin(), connected.end()};
+}
+
+template<typename RandomIt>
+inline auto connectedComponents(ThreadPool &pool, RandomIt first, RandomIt last) {
+    return transform(pool, first, last, [](const auto &graph) {
+        return graph.connectedComponents();
+    });
+}
+
+template<typename RandomIt>
+inline auto findNTuples(ThreadPool &pool, RandomIt first, RandomIt last) {
+    return transform(pool, first, last, [](const auto &graph) {
+        return graph.findNTuples();
+    });
+}
+
+}
@@ -0,0 +1,141 @@
+/**
+ * @file PublishedGraph_detail.h
+ * @brief Definitions for the PublishedGraph
+ */
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <algorithm>
+
+#include "../PublishedGraph.h"
+
+namespace graphs {
+
+template<typename Graph>
+inline PublishedGraph<Graph>::ReadHandle::ReadHandle(ReaderSlot *slot, const Version *version)
+        : _slot(slot), _version(version) {}
+
+template<typename Graph>
+inline PublishedGraph<Graph>::ReadHandle::ReadHandle(ReadHandle &&other) noexcept
+        : _slot(other._slot), _version(other._version) {
+    other._slot = nullptr;
+    other._version = nullptr;
+}
+
+template<typename Graph>
+inline typename PublishedGraph<Graph>::ReadHandle &PublishedGraph<Graph>::ReadHandle::operator=(ReadHandle &&rhs) noexcept {
+    if (this != &rhs) {
+        release();
+        _slot = rhs._slot;
+        _version = rhs._version;
+        rhs._slot = nullptr;
+        rhs._version = nullptr;
+    }
+    return *this;
+}
+
+template<typename Graph>
+inline PublishedGraph<Graph>::ReadHandle::~ReadHandle() {
+    release();
+}
+
+template<typename Graph>
+inline void PublishedGraph<Graph>::ReadHandle::release() {
+    if (_slot) {
+        _slot->epoch.store(0, std::memory_order_release);
+        _slot = nullptr;
+        _version = nullptr;
+    }
+}
+
+template<typename Graph>
+inline const Graph &PublishedGraph<Graph>::ReadHandle::operator*() const {
+    return _version->graph;
+}
+
+template<typename Graph>
+inline const Graph *PublishedGraph<Graph>::ReadHandle::operator->() const {
+    return &_version->graph;
+}
+
+template<typename Graph>
+inline std::uint64_t PublishedGraph<Graph>::ReadHandle::version() const {
+    return _version->number;
+}
+
+template<typename Graph>
+inline std::size_t PublishedGraph<Graph>::defaultReaderSlots() {
+    return std::max<std::size_t>(64, 2 * std::thread::hardware_concurrency());
+}
+
+template<typename Graph>
+inline PublishedGraph<Graph>::PublishedGraph(Graph graph, std::size_t nReaderSlots)
+        : _writer(std::move(graph)), _current(nullptr), _nSlots(std::max<std::size_t>(1, nReaderSlots)),
+          _slots(new ReaderSlot[_nSlots]) {
+    _current.store(new Version{_writer.snapshot(), 0});
+}
+
+template<typename Graph>
+inline PublishedGraph<Graph>::~PublishedGraph() {
+    delete _current.load();
+}
+
+template<typename Graph>
+inline typename PublishedGraph<Graph>::ReadHandle PublishedGraph<Graph>::read() const {
+    // start at a thread dependent slot so that readers do not contend for the same cache line
+    auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (std::size_t i = 0;; ++i) {
+        auto &slot = _slots[(start + i) % _nSlots];
+        if (slot.epoch.load(std::memory_order_relaxed) == 0) {
+            std::uint64_t expected = 0;
+            // announce the epoch before loading the version: a version retired in an epoch >= the announced one
+            // is not freed until this slot is released
+            if (slot.epoch.compare_exchange_strong(expected, _epoch.load())) {
+                return ReadHandle(&slot, _current.load());
+            }
+        }
+        if (i % _nSlots == _nSlots - 1) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template<typename Graph>
+inline Graph &PublishedGraph<Graph>::writer() {
+    return _writer;
+}
+
+template<typename Graph>
+inline std::uint64_t PublishedGraph<Graph>::publish() {
+    auto number = _current.load(std::memory_order_relaxed)->number + 1;
+    auto previous = _current.exchange(new Version{_writer.snapshot(), number});
+    auto retiredEpoch = _epoch.fetch_add(1);
+    _retired.emplace_back(std::unique_ptr<const Version>(previous), retiredEpoch);
+    reclaim();
+    return number;
+}
+
+template<typename Graph>
+inline std::size_t PublishedGraph<Graph>::reclaim() {
+    auto minEpoch = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t i = 0; i < _nSlots; ++i) {
+        auto epoch = _slots[i].epoch.load();
+        if (epoch != 0) {
+            minEpoch = std::min(minEpoch, epoch);
+        }
+    }
+    // readers which announced an epoch > retiredEpoch loaded the version after it was unpublished
+    _retired.erase(std::remove_if(_retired.begin(), _retired.end(), [minEpoch](const auto &retired) {
+        return std::get<1>(retired) < minEpoch;
+    }), _retired.end());
+    return _retired.size();
+}
+
+template<typename Graph>
+inline std::size_t PublishedGraph<Graph>::nRetired() const {
+    return _retired.size();
+}
+
+}
@@ -0,0 +1,261 @@
+/**
+ * This file contains a vector for trivially relocatable element types. When it grows or shrinks, the elements are
+ * moved to the new storage with memcpy instead of being move constructed and destroyed one by one.
+ *
+ * @file RelocatingVector_detail.h
+ * @brief Definitions for the trivially relocating vector
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace graphs::detail {
+
+/**
+ * Whether objects of type T can be moved to another address by copying their bytes, without calling the move
+ * constructor and the destructor. True for trivially copyable types, types which own memory through plain pointers
+ * can opt in by specialization.
+ */
+template<typename T, typename = void>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {
+};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * Contiguous vector of trivially relocatable elements. Reallocation copies the bytes of the elements, so that
+ * growing a vector of, e.g., vertices owning their neighbor lists costs one memcpy.
+ * @tparam T the element type
+ */
+template<typename T>
+class TriviallyRelocatingVector {
+    static_assert(is_trivially_relocatable_v<T>, "The element type has to be trivially relocatable");
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = std::allocator<T>;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    TriviallyRelocatingVector() = default;
+
+    explicit TriviallyRelocatingVector(const allocator_type &) {}
+
+    TriviallyRelocatingVector(const TriviallyRelocatingVector &other) {
+        reserve(other._size);
+        try {
+            std::uninitialized_copy(other.begin(), other.end(), _data);
+        } catch (...) {
+            allocator_type().deallocate(_data, _capacity);
+            throw;
+        }
+        _size = other._size;
+    }
+
+    TriviallyRelocatingVector(const TriviallyRelocatingVector &other, const allocator_type &)
+            : TriviallyRelocatingVector(other) {}
+
+    TriviallyRelocatingVector(TriviallyRelocatingVector &&other) noexcept
+            : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)),
+              _capacity(std::exchange(other._capacity, 0)) {}
+
+    TriviallyRelocatingVector &operator=(const TriviallyRelocatingVector &rhs) {
+        if (this != &rhs) {
+            TriviallyRelocatingVector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    TriviallyRelocatingVector &operator=(TriviallyRelocatingVector &&rhs) noexcept {
+        TriviallyRelocatingVector moved(std::move(rhs));
+        swap(moved);
+        return *this;
+    }
+
+    ~TriviallyRelocatingVector() {
+        clear();
+        if (_data) {
+            allocator_type().deallocate(_data, _capacity);
+        }
+    }
+
+    void swap(TriviallyRelocatingVector &other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    iterator begin() noexcept { return _data; }
+
+    iterator end() noexcept { return _data + _size; }
+
+    const_iterator begin() const noexcept { return _data; }
+
+    const_iterator end() const noexcept { return _data + _size; }
+
+    const_iterator cbegin() const noexcept { return _data; }
+
+    const_iterator cend() const noexcept { return _data + _size; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] size_type size() const noexcept { return _size; }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+    [[nodiscard]] size_type capacity() const noexcept { return _capacity; }
+
+    T *data() noexcept { return _data; }
+
+    const T *data() const noexcept { return _data; }
+
+    allocator_type get_allocator() const { return {}; }
+
+    T &operator[](size_type index) { return _data[index]; }
+
+    const T &operator[](size_type index) const { return _data[index]; }
+
+    T &at(size_type index) {
+        checkIndex(index);
+        return _data[index];
+    }
+
+    const T &at(size_type index) const {
+        checkIndex(index);
+        return _data[index];
+    }
+
+    T &front() { return _data[0]; }
+
+    const T &front() const { return _data[0]; }
+
+    T &back() { return _data[_size - 1]; }
+
+    const T &back() const { return _data[_size - 1]; }
+
+    void reserve(size_type n) {
+        if (n > _capacity) {
+            relocate(n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (_capacity > _size) {
+            relocate(_size);
+        }
+    }
+
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        _size = 0;
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * Constructs an element at the end. If the storage is full, the element is constructed in the new storage
+     * before the others are relocated, so that the arguments may refer to elements of this vector.
+     * @param args constructor arguments
+     * @return reference to the new element
+     */
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        if (_size == _capacity) {
+            auto newCapacity = std::max<size_type>(2 * _capacity, 1);
+            T *storage = allocator_type().allocate(newCapacity);
+            try {
+                ::new(static_cast<void *>(storage + _size)) T(std::forward<Args>(args)...);
+            } catch (...) {
+                allocator_type().deallocate(storage, newCapacity);
+                throw;
+            }
+            adopt(storage, newCapacity);
+        } else {
+            ::new(static_cast<void *>(_data + _size)) T(std::forward<Args>(args)...);
+        }
+        return _data[_size++];
+    }
+
+    void pop_back() {
+        std::destroy_at(_data + --_size);
+    }
+
+    bool operator==(const TriviallyRelocatingVector &rhs) const {
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    bool operator!=(const TriviallyRelocatingVector &rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    void checkIndex(size_type index) const {
+        if (index >= _size) {
+            throw std::out_of_range("TriviallyRelocatingVector index out of range");
+        }
+    }
+
+    void relocate(size_type newCapacity) {
+        adopt(newCapacity > 0 ? allocator_type().allocate(newCapacity) : nullptr, newCapacity);
+    }
+
+    /**
+     * Copies the bytes of all elements into the given storage and releases the old storage without destroying
+     * the elements, which now live in the new storage.
+     */
+    void adopt(T *storage, size_type newCapacity) {
+        if (_size > 0) {
+            std::memcpy(static_cast<void *>(storage), static_cast<const void *>(_data), _size * sizeof(T));
+        }
+        if (_data) {
+            allocator_type().deallocate(_data, _capacity);
+        }
+        _data = storage;
+        _capacity = newCapacity;
+    }
+
+    T *_data {nullptr};
+    size_type _size {0};
+    size_type _capacity {0};
+};
+
+/**
+ * Selects the relocating vector for types which are trivially relocatable but not trivially copyable, std::vector
+ * already relocates trivially copyable types with memmove.
+ */
+template<typename T>
+struct relocating_vector {
+    using type = std::conditional_t<is_trivially_relocatable_v<T> && !std::is_trivially_copyable_v<T>,
+            TriviallyRelocatingVector<T>, std::vector<T>>;
+};
+
+}
@@ -0,0 +1,521 @@
+/**
+ * This file contains the columnar vertex storage. Instead of one array of vertices, every data field, the neighbor
+ * lists and the active flags are kept in separate columns. Elements are accessed through proxies which provide the
+ * interface of the vertex.
+ *
+ * @file SoaVector_detail.h
+ * @brief Definitions for the columnar vertex storage
+ */
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace graphs::detail {
+
+/**
+ * Non-owning view of a contiguous range of elements.
+ * @tparam T the element type, const for read-only views
+ */
+template<typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using iterator = T *;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T *data, size_type size) noexcept : _data(data), _size(size) {}
+
+    [[nodiscard]] constexpr T *data() const noexcept { return _data; }
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return _size; }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+
+    constexpr T &operator[](size_type index) const { return _data[index]; }
+
+    constexpr iterator begin() const noexcept { return _data; }
+
+    constexpr iterator end() const noexcept { return _data + _size; }
+
+private:
+    T *_data {nullptr};
+    size_type _size {0};
+};
+
+template<typename Vertex, typename Data = typename Vertex::data_type>
+class VertexColumns;
+
+/**
+ * Vector of vertices stored as columns: one std::vector per data field, one for the neighbor lists and a bitmap of
+ * active vertices. Can be used as backing vector of the IndexPersistentContainer. References and iterators yield
+ * proxies to the columns, which materialize into a vertex when converted.
+ * @tparam Vertex the vertex type
+ * @tparam T the data types of the vertex
+ */
+template<typename Vertex, typename... T>
+class VertexColumns<Vertex, std::tuple<T...>> {
+    static_assert((!std::is_same_v<T, bool> && ...),
+                  "Columns of bool are bit-packed and cannot be viewed as spans, use char instead");
+    static constexpr std::size_t bitsPerWord = 64;
+public:
+    using value_type = Vertex;
+    using data_type = std::tuple<T...>;
+    using NeighborList = typename Vertex::NeighborList;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = std::allocator<Vertex>;
+
+    /**
+     * Proxy to one vertex in the columns, providing the interface of the vertex.
+     * @tparam Const whether the vertex is read-only
+     */
+    template<bool Const>
+    class basic_reference {
+    public:
+        using container_pointer = std::conditional_t<Const, const VertexColumns *, VertexColumns *>;
+        using data_type = std::tuple<T...>;
+        using NeighborList = typename Vertex::NeighborList;
+        using index_type = typename NeighborList::value_type;
+        using allocator_type = typename NeighborList::allocator_type;
+
+        basic_reference(container_pointer container, size_type index) : _container(container), _index(index) {}
+
+        basic_reference(const basic_reference &) = default;
+
+        /**
+         * Assigns the value of another element, the proxy keeps referring to its own slot.
+         */
+        basic_reference &operator=(const basic_reference &rhs) {
+            return *this = static_cast<Vertex>(rhs);
+        }
+
+        basic_reference &operator=(const Vertex &vertex) {
+            static_assert(!Const, "Cannot assign through a const reference");
+            _container->assign(_index, Vertex(vertex));
+            return *this;
+        }
+
+        basic_reference &operator=(Vertex &&vertex) {
+            static_assert(!Const, "Cannot assign through a const reference");
+            _container->assign(_index, std::move(vertex));
+            return *this;
+        }
+
+        template<bool C = Const, typename = std::enable_if_t<!C>>
+        operator basic_reference<true>() const {
+            return {_container, _index};
+        }
+
+        /**
+         * Copies the referred-to element out of the columns.
+         */
+        operator Vertex() const {
+            Vertex vertex(data_type(fields(std::index_sequence_for<T...>{})));
+            vertex.neighbors() = neighbors();
+            if (deactivated()) {
+                vertex.deactivate();
+            }
+            return vertex;
+        }
+
+        auto &neighbors() const {
+            return _container->_neighbors[_index];
+        }
+
+        void addNeighbor(index_type neighbor) const {
+            insertNeighbor<sorted_neighbors_v<Vertex>>(neighbors(), neighbor);
+        }
+
+        void removeNeighbor(index_type neighbor) const {
+            eraseNeighbor<sorted_neighbors_v<Vertex>>(neighbors(), neighbor);
+        }
+
+        /**
+         * The data of the vertex, a reference to the field if there is one field, otherwise a tuple of references.
+         */
+        decltype(auto) data() const {
+            if constexpr (sizeof...(T) == 1) {
+                return static_cast<const std::tuple_element_t<0, data_type> &>(std::get<0>(_container->_columns)[_index]);
+            } else {
+                return fields(std::index_sequence_for<T...>{});
+            }
+        }
+
+        void setData(data_type data) const {
+            _container->setData(_index, std::move(data));
+        }
+
+        void deactivate() const {
+            static_assert(!Const, "Cannot deactivate through a const reference");
+            _container->_active[_index / bitsPerWord] &= ~(std::uint64_t{1} << (_index % bitsPerWord));
+        }
+
+        [[nodiscard]] bool deactivated() const {
+            return !_container->active(_index);
+        }
+
+        allocator_type get_allocator() const {
+            return neighbors().get_allocator();
+        }
+
+        auto operator->() const {
+            return &std::get<0>(_container->_columns)[_index];
+        }
+
+    private:
+        template<std::size_t... I>
+        std::tuple<const T &...> fields(std::index_sequence<I...>) const {
+            return {std::get<I>(_container->_columns)[_index]...};
+        }
+
+        container_pointer _container;
+        size_type _index;
+    };
+
+    using reference = basic_reference<false>;
+    using const_reference = basic_reference<true>;
+
+    /**
+     * Random access iterator over the slots, dereferencing yields a proxy.
+     * @tparam Const whether this is a const iterator
+     */
+    template<bool Const>
+    class basic_iterator {
+    public:
+        /**
+         * Result of operator->, owns the proxy so that it->neighbors() works like for a plain vertex.
+         */
+        struct pointer {
+            basic_reference<Const> ref;
+
+            const basic_reference<Const> *operator->() const { return &ref; }
+        };
+
+        using difference_type = std::ptrdiff_t;
+        using value_type = Vertex;
+        using reference = basic_reference<Const>;
+        using iterator_category = std::random_access_iterator_tag;
+        using container_pointer = std::conditional_t<Const, const VertexColumns *, VertexColumns *>;
+
+        basic_iterator() = default;
+
+        basic_iterator(container_pointer container, size_type index) : _container(container), _index(index) {}
+
+        template<bool C = Const, typename = std::enable_if_t<!C>>
+        operator basic_iterator<true>() const { return {_container, _index}; }
+
+        reference operator*() const { return {_container, _index}; }
+
+        pointer operator->() const { return {{_container, _index}}; }
+
+        reference operator[](difference_type n) const { return {_container, _index + n}; }
+
+        basic_iterator &operator++() {
+            ++_index;
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            auto copy = *this;
+            ++_index;
+            return copy;
+        }
+
+        basic_iterator &operator--() {
+            --_index;
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            auto copy = *this;
+            --_index;
+            return copy;
+        }
+
+        basic_iterator &operator+=(difference_type n) {
+            _index += n;
+            return *this;
+        }
+
+        basic_iterator &operator-=(difference_type n) {
+            _index -= n;
+            return *this;
+        }
+
+        basic_iterator operator+(difference_type n) const { return {_container, _index + n}; }
+
+        friend basic_iterator operator+(difference_type n, const basic_iterator &it) { return it + n; }
+
+        basic_iterator operator-(difference_type n) const { return {_container, _index - n}; }
+
+        template<bool C>
+        difference_type operator-(const basic_iterator<C> &rhs) const {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(rhs._index);
+        }
+
+        template<bool C>
+        bool operator==(const basic_iterator<C> &rhs) const { return _index == rhs._index; }
+
+        template<bool C>
+        bool operator!=(const basic_iterator<C> &rhs) const { return _index != rhs._index; }
+
+        template<bool C>
+        bool operator<(const basic_iterator<C> &rhs) const { return _index < rhs._index; }
+
+        template<bool C>
+        bool operator>(const basic_iterator<C> &rhs) const { return _index > rhs._index; }
+
+        template<bool C>
+        bool operator<=(const basic_iterator<C> &rhs) const { return _index <= rhs._index; }
+
+        template<bool C>
+        bool operator>=(const basic_iterator<C> &rhs) const { return _index >= rhs._index; }
+
+    private:
+        friend class VertexColumns;
+
+        template<bool>
+        friend class basic_iterator;
+
+        container_pointer _container {nullptr};
+        size_type _index {0};
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    VertexColumns() = default;
+
+    explicit VertexColumns(const allocator_type &) {}
+
+    VertexColumns(const VertexColumns &other, const allocator_type &) : VertexColumns(other) {}
+
+    iterator begin() noexcept { return {this, 0}; }
+
+    iterator end() noexcept { return {this, size()}; }
+
+    const_iterator begin() const noexcept { return cbegin(); }
+
+    const_iterator end() const noexcept { return cend(); }
+
+    const_iterator cbegin() const noexcept { return {this, 0}; }
+
+    const_iterator cend() const noexcept { return {this, size()}; }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return _neighbors.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return _neighbors.empty();
+    }
+
+    /**
+     * @return the number of slots for which all columns have capacity
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return capacity(std::index_sequence_for<T...>{});
+    }
+
+    void reserve(size_type n) {
+        std::apply([n](auto &... column) { (column.reserve(n), ...); }, _columns);
+        _neighbors.reserve(n);
+        _active.reserve((n + bitsPerWord - 1) / bitsPerWord);
+    }
+
+    void shrink_to_fit() {
+        std::apply([](auto &... column) { (column.shrink_to_fit(), ...); }, _columns);
+        _neighbors.shrink_to_fit();
+        _active.shrink_to_fit();
+    }
+
+    void clear() {
+        std::apply([](auto &... column) { (column.clear(), ...); }, _columns);
+        _neighbors.clear();
+        _active.clear();
+    }
+
+    allocator_type get_allocator() const {
+        return {};
+    }
+
+    reference operator[](size_type index) { return {this, index}; }
+
+    const_reference operator[](size_type index) const { return {this, index}; }
+
+    reference at(size_type index) {
+        checkIndex(index);
+        return {this, index};
+    }
+
+    const_reference at(size_type index) const {
+        checkIndex(index);
+        return {this, index};
+    }
+
+    reference back() { return {this, size() - 1}; }
+
+    const_reference back() const { return {this, size() - 1}; }
+
+    void push_back(const Vertex &vertex) {
+        push_back(Vertex(vertex));
+    }
+
+    void push_back(Vertex &&vertex) {
+        auto index = size();
+        std::apply([](auto &... column) { (column.emplace_back(), ...); }, _columns);
+        _neighbors.emplace_back();
+        if (index % bitsPerWord == 0) {
+            _active.push_back(0);
+        }
+        assign(index, std::move(vertex));
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args &&... args) {
+        push_back(Vertex(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() {
+        std::apply([](auto &... column) { (column.pop_back(), ...); }, _columns);
+        _neighbors.pop_back();
+        if (size() % bitsPerWord == 0) {
+            _active.pop_back();
+        } else {
+            _active.back() &= ~(std::uint64_t{1} << (size() % bitsPerWord));
+        }
+    }
+
+    /**
+     * Yields the column of the I-th data field.
+     * @tparam I the field
+     * @return the column, one value per slot
+     */
+    template<std::size_t I>
+    Span<std::tuple_element_t<I, data_type>> column() {
+        auto &c = std::get<I>(_columns);
+        return {c.data(), c.size()};
+    }
+
+    template<std::size_t I>
+    Span<const std::tuple_element_t<I, data_type>> column() const {
+        const auto &c = std::get<I>(_columns);
+        return {c.data(), c.size()};
+    }
+
+    /**
+     * Yields the column of neighbor lists.
+     * @return the column, one list per slot
+     */
+    Span<NeighborList> adjacency() {
+        return {_neighbors.data(), _neighbors.size()};
+    }
+
+    Span<const NeighborList> adjacency() const {
+        return {_neighbors.data(), _neighbors.size()};
+    }
+
+    /**
+     * Yields the bitmap of active slots, bit i % 64 of word i / 64 is set if slot i is active.
+     * @return the words of the bitmap
+     */
+    Span<const std::uint64_t> activeBitmap() const {
+        return {_active.data(), _active.size()};
+    }
+
+    /**
+     * @param index the slot
+     * @return whether the slot is active
+     */
+    [[nodiscard]] bool active(size_type index) const {
+        return (_active[index / bitsPerWord] >> (index % bitsPerWord)) & 1u;
+    }
+
+private:
+    template<std::size_t... I>
+    size_type capacity(std::index_sequence<I...>) const noexcept {
+        return std::min({_neighbors.capacity(), std::get<I>(_columns).capacity()...});
+    }
+
+    void checkIndex(size_type index) const {
+        if (index >= size()) {
+            throw std::out_of_range("VertexColumns index out of range");
+        }
+    }
+
+    template<std::size_t I>
+    static const auto &field(const Vertex &vertex) {
+        if constexpr (sizeof...(T) == 1) {
+            return vertex.data();
+        } else {
+            return std::get<I>(vertex.data());
+        }
+    }
+
+    void assign(size_type index, Vertex &&vertex) {
+        assignData(index, vertex, std::index_sequence_for<T...>{});
+        _neighbors[index] = std::move(vertex.neighbors());
+        setActive(index, !vertex.deactivated());
+    }
+
+    template<std::size_t... I>
+    void assignData(size_type index, const Vertex &vertex, std::index_sequence<I...>) {
+        ((std::get<I>(_columns)[index] = field<I>(vertex)), ...);
+    }
+
+    void setData(size_type index, data_type data) {
+        setData(index, std::move(data), std::index_sequence_for<T...>{});
+    }
+
+    template<std::size_t... I>
+    void setData(size_type index, data_type &&data, std::index_sequence<I...>) {
+        ((std::get<I>(_columns)[index] = std::move(std::get<I>(data))), ...);
+    }
+
+    void setActive(size_type index, bool active) {
+        auto mask = std::uint64_t{1} << (index % bitsPerWord);
+        if (active) {
+            _active[index / bitsPerWord] |= mask;
+        } else {
+            _active[index / bitsPerWord] &= ~mask;
+        }
+    }
+
+    std::tuple<std::vector<T>...> _columns {};
+    std::vector<NeighborList> _neighbors {};
+    std::vector<std::uint64_t> _active {};
+};
+
+template<typename T, typename = void>
+struct is_columnar_vertex : std::false_type {
+};
+template<typename T>
+struct is_columnar_vertex<T, std::void_t<typename T::data_type, typename T::NeighborList,
+        decltype(std::declval<T &>().deactivate())>> : std::true_type {
+};
+
+/**
+ * Selects the columnar storage for vertices and a std::vector for everything else, e.g., the blanks.
+ */
+template<typename T, bool = is_columnar_vertex<T>::value>
+struct soa_vector {
+    using type = std::vector<T>;
+};
+template<typename T>
+struct soa_vector<T, true> {
+    using type = VertexColumns<T>;
+};
+
+}
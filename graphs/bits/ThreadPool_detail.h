@@ -0,0 +1,126 @@
+/**
+ * @file ThreadPool_detail.h
+ * @brief Definitions for the ThreadPool
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include "../ThreadPool.h"
+
+namespace graphs {
+
+inline std::size_t ThreadPool::defaultThreads() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+inline ThreadPool::ThreadPool(std::size_t nThreads) {
+    nThreads = std::max<std::size_t>(1, nThreads);
+    for (std::size_t i = 0; i < nThreads; ++i) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    // the last queue belongs to the thread calling run()
+    for (std::size_t i = 0; i + 1 < nThreads; ++i) {
+        _workers.emplace_back([this, i]() {
+            std::uint64_t generation = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wake.wait(lock, [&]() { return _stop || _generation != generation; });
+                    if (_stop) {
+                        return;
+                    }
+                    generation = _generation;
+                }
+                work(i);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    --_nBusy;
+                }
+                _done.notify_all();
+            }
+        });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+inline std::size_t ThreadPool::nThreads() const {
+    return _queues.size();
+}
+
+inline void ThreadPool::run(const std::vector<std::size_t> &order, const std::function<void(std::size_t)> &task) {
+    std::lock_guard<std::mutex> runLock(_runMutex);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        auto &queue = *_queues[i % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(order[i]);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _error = nullptr;
+        _nBusy = _workers.size();
+        ++_generation;
+    }
+    _wake.notify_all();
+    work(_queues.size() - 1);
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _nBusy == 0; });
+        _task = nullptr;
+        error = _error;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+inline bool ThreadPool::pop(std::size_t self, std::size_t &item) {
+    {
+        auto &queue = *_queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.items.empty()) {
+            item = queue.items.front();
+            queue.items.pop_front();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < _queues.size(); ++i) {
+        auto &victim = *_queues[(self + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty()) {
+            item = victim.items.back();
+            victim.items.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void ThreadPool::work(std::size_t self) {
+    std::size_t item;
+    while (pop(self, item)) {
+        try {
+            (*_task)(item);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_error) {
+                _error = std::current_exception();
+            }
+        }
+    }
+}
+
+}
@@ -8,30 +8,49 @@
 
 namespace graphs {
 
-template<typename... T>
-inline Vertex<T...>::Vertex(T&&... data) : _data(std::tuple<T...>(std::forward<T>(data)...)) {}
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(T&&... data) : _data(std::tuple<T...>(std::forward<T>(data)...)) {}
 
-template<typename... T>
-inline Vertex<T...>::Vertex(Vertex::data_type data) : _data(std::move(data)) {}
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(data_type data) : _data(std::move(data)) {}
 
-template<typename... T>
-inline std::ostream &operator<<(std::ostream &os, const Vertex<T...> &vertex) {
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(std::allocator_arg_t, const allocator_type &allocator)
+        : _neighbors(allocator), _data() {}
+
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(std::allocator_arg_t, const allocator_type &allocator, data_type data)
+        : _neighbors(allocator), _data(std::move(data)) {}
+
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(std::allocator_arg_t, const allocator_type &allocator,
+                                              const BasicVertex &other)
+        : _neighbors(other._neighbors, allocator), _data(other._data), _deactivated(other._deactivated) {}
+
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(std::allocator_arg_t, const allocator_type &allocator,
+                                              BasicVertex &&other)
+        : _neighbors(std::move(other._neighbors), allocator), _data(std::move(other._data)),
+          _deactivated(other._deactivated) {}
+
+template<typename Traits, typename... T>
+inline std::ostream &operator<<(std::ostream &os, const BasicVertex<Traits, T...> &vertex) {
     os << fmt::format("{}", vertex);
     return os;
 }
 
-template<typename... T>
-inline const typename Vertex<T...>::NeighborList &Vertex<T...>::neighbors() const {
+template<typename Traits, typename... T>
+inline const typename BasicVertex<Traits, T...>::NeighborList &BasicVertex<Traits, T...>::neighbors() const {
     return _neighbors;
 }
 
-template<typename... T>
-inline typename Vertex<T...>::NeighborList &Vertex<T...>::neighbors() {
+template<typename Traits, typename... T>
+inline typename BasicVertex<Traits, T...>::NeighborList &BasicVertex<Traits, T...>::neighbors() {
     return _neighbors;
 }
 
-template<typename... T>
-inline const auto &Vertex<T...>::data() const {
+template<typename Traits, typename... T>
+inline const auto &BasicVertex<Traits, T...>::data() const {
     if constexpr (std::tuple_size_v<data_type> == 1) {
         return std::get<0>(_data);
     } else {
@@ -39,63 +58,61 @@ inline const auto &Vertex<T...>::data() const {
     }
 }
 
-template<typename... T>
-inline void Vertex<T...>::setData(data_type data) {
+template<typename Traits, typename... T>
+inline void BasicVertex<Traits, T...>::setData(data_type data) {
     _data = std::move(data);
 }
 
-template<typename... T>
-inline void Vertex<T...>::addNeighbor(NeighborList::value_type neighbor) {
-    auto neighborIt = std::find(_neighbors.begin(), _neighbors.end(), neighbor);
-    auto newNeighbor = neighborIt == _neighbors.end();
-    if(newNeighbor) {
-        _neighbors.push_back(neighbor);
-    }
+template<typename Traits, typename... T>
+inline void BasicVertex<Traits, T...>::addNeighbor(typename NeighborList::value_type neighbor) {
+    detail::insertNeighbor<sorted_neighbors>(_neighbors, neighbor);
 }
 
-template<typename... T>
-inline void Vertex<T...>::removeNeighbor(NeighborList::value_type neighbor) {
-    auto it = std::find(_neighbors.begin(), _neighbors.end(), neighbor);
-    if (it != _neighbors.end()) {
-        _neighbors.erase(it);
-    }
+template<typename Traits, typename... T>
+inline void BasicVertex<Traits, T...>::removeNeighbor(typename NeighborList::value_type neighbor) {
+    detail::eraseNeighbor<sorted_neighbors>(_neighbors, neighbor);
 }
 
-template<typename... T>
-inline void Vertex<T...>::deactivate() {
+template<typename Traits, typename... T>
+inline void BasicVertex<Traits, T...>::deactivate() {
     _deactivated = true;
 }
 
-template<typename... T>
-inline bool Vertex<T...>::deactivated() const {
+template<typename Traits, typename... T>
+inline bool BasicVertex<Traits, T...>::deactivated() const {
     return _deactivated;
 }
 
-template<typename... T>
-inline Vertex<T...>::~Vertex() = default;
+template<typename Traits, typename... T>
+inline typename BasicVertex<Traits, T...>::allocator_type BasicVertex<Traits, T...>::get_allocator() const {
+    return _neighbors.get_allocator();
+}
 
-template<typename... T>
-inline Vertex< T...> &Vertex<T...>::operator=(Vertex &&rhs) noexcept = default;
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::~BasicVertex() = default;
 
-template<typename... T>
-inline Vertex<T...>::Vertex(Vertex &&other) noexcept = default;
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...> &BasicVertex<Traits, T...>::operator=(BasicVertex &&rhs) noexcept = default;
 
-template<typename... T>
-inline Vertex<T...>::Vertex(const graphs::Vertex<T...> &) = default;
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(BasicVertex &&other) noexcept = default;
 
-template<typename... T>
-inline Vertex<T...>& Vertex<T...>::operator=(const Vertex&) = default;
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...>::BasicVertex(const BasicVertex &) = default;
+
+template<typename Traits, typename... T>
+inline BasicVertex<Traits, T...> &BasicVertex<Traits, T...>::operator=(const BasicVertex &) = default;
 
 }
 
 namespace fmt {
-template<typename... T>
-struct formatter<graphs::Vertex<T...>> {
+template<typename Traits, typename... T>
+struct formatter<graphs::BasicVertex<Traits, T...>> {
     template <typename ParseContext>
     constexpr auto parse(ParseContext &ctx) { return ctx.begin(); }
 
     template <typename FormatContext>
-    auto format(const graphs::Vertex<T...> &v, FormatContext &ctx) {
+    auto format(const graphs::BasicVertex<Traits, T...> &v, FormatContext &ctx) {
         std::stringstream ss;
         bool first {true};
         for (const auto neighbor : v.neighbors()) {
@@ -108,4 +125,8 @@ struct formatter<graphs::Vertex<T...>> {
         return format_to(ctx.out(), "Vertex[{}, neighbors=[{}]]", v.data(), ss.str());
     }
 };
+
+template<typename... T>
+struct formatter<graphs::Vertex<T...>> : formatter<graphs::BasicVertex<graphs::DefaultVertexTraits, T...>> {
+};
 }
@@ -5,9 +5,19 @@
 #pragma once
 
 #include "Vertex.h"
+#include "PackedVertex.h"
+#include "BoundedVertex.h"
 #include "Graph.h"
 
 namespace graphs{
     using DefaultVertex = Vertex<std::size_t>;
     using DefaultGraph = graphs::Graph<graphs::IndexPersistentVector, DefaultVertex>;
+    using CowGraph = graphs::Graph<graphs::CowIndexPersistentVector, DefaultVertex>;
+    using PmrGraph = graphs::Graph<graphs::PmrIndexPersistentVector, PmrVertex<std::size_t>>;
+    using Graph32 = graphs::Graph<graphs::IndexPersistentVector, Vertex32<std::size_t>>;
+    using SortedGraph = graphs::Graph<graphs::IndexPersistentVector, SortedVertex<std::size_t>>;
+    using SoaGraph = graphs::Graph<graphs::SoaIndexPersistentVector, DefaultVertex>;
+    using PackedGraph = graphs::Graph<graphs::PackedIndexPersistentVector, PackedVertex<std::size_t>>;
+    template<std::size_t MaxDegree>
+    using BoundedGraph = graphs::Graph<graphs::PackedIndexPersistentVector, BoundedVertex<MaxDegree, std::size_t>>;
 }
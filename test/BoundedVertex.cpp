@@ -0,0 +1,145 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <sstream>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+#include "GraphComparison.h"
+
+namespace {
+using Bounded = graphs::BoundedVertex<4, std::size_t>;
+using Graph4 = graphs::BoundedGraph<4>;
+}
+
+SCENARIO("Vertices with bounded degree", "[bounded]") {
+    static_assert(!std::is_polymorphic_v<Bounded>);
+    static_assert(sizeof(graphs::detail::InlineNeighborList<graphs::PersistentIndex, 4>) ==
+                  5 * sizeof(graphs::PersistentIndex));
+    static_assert(graphs::detail::is_trivially_relocatable_v<Bounded>);
+    static_assert(Graph4::MaxDegree == 4 && graphs::DefaultGraph::MaxDegree == 0);
+    GIVEN("A vertex with four neighbors") {
+        Bounded v {7};
+        for (std::size_t i = 0; i < 4; ++i) {
+            v.addNeighbor(graphs::PersistentIndex{i});
+        }
+        THEN("it is full") {
+            REQUIRE(v.data() == 7);
+            REQUIRE(v.neighbors().full());
+            REQUIRE_NOTHROW(v.addNeighbor(graphs::PersistentIndex{2}));
+            REQUIRE_THROWS_AS(v.addNeighbor(graphs::PersistentIndex{4}), std::length_error);
+            REQUIRE_THROWS_AS(v.neighbors().resize(5), std::length_error);
+            REQUIRE(v.neighbors().size() == 4);
+        }
+        WHEN("removing and inserting neighbors") {
+            v.removeNeighbor(graphs::PersistentIndex{1});
+            v.neighbors().insert(v.neighbors().begin(), graphs::PersistentIndex{9});
+            THEN("the order is kept") {
+                std::vector<graphs::PersistentIndex> expected {{9}, {0}, {2}, {3}};
+                REQUIRE(std::equal(v.neighbors().begin(), v.neighbors().end(), expected.begin(), expected.end()));
+            }
+        }
+        WHEN("deactivating it") {
+            v.deactivate();
+            THEN("copies carry the flag, neighbor list swaps and assignments do not") {
+                auto copy = v;
+                REQUIRE(copy.deactivated());
+                Bounded other {1};
+                other.neighbors() = v.neighbors();
+                REQUIRE(!other.deactivated());
+                REQUIRE(other.neighbors() == v.neighbors());
+                other.neighbors().clear();
+                other.neighbors().swap(v.neighbors());
+                REQUIRE(v.deactivated());
+                REQUIRE(v.neighbors().empty());
+                REQUIRE(other.neighbors().size() == 4);
+            }
+        }
+    }
+}
+
+SCENARIO("Graphs with bounded degree", "[bounded]") {
+    GIVEN("A 2d lattice with blanks as bounded and as default graph") {
+        graphs::DefaultGraph reference;
+        Graph4 graph;
+        constexpr std::size_t width = 8;
+        for (std::size_t i = 0; i < width * width; ++i) {
+            reference.addVertex(i);
+            graph.addVertex(i);
+        }
+        for (std::size_t i = 0; i < width * width; ++i) {
+            for (auto j : {i + 1, i + width}) {
+                if (j < width * width && (j == i + width || j % width != 0)) {
+                    reference.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{j});
+                    graph.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{j});
+                }
+            }
+        }
+        for (std::size_t i : {5, 27, 63}) {
+            reference.removeVertex(graphs::PersistentIndex{i});
+            graph.removeVertex(graphs::PersistentIndex{i});
+        }
+
+        THEN("both have the same vertices, edges, algorithm results, rollbacks and binary format") {
+            test::requireSameGraph(graph, reference);
+            test::requireSameResults(graph, reference, graphs::PersistentIndex{0}, graphs::PersistentIndex{62});
+            test::requireRollbackRestores(graph, reference);
+            test::requireSameAfterReading<Graph4>(graph, reference);
+            REQUIRE(graph.memoryUsage().neighbors == 0);
+        }
+        WHEN("adding an edge to a vertex of full valence") {
+            auto nEdges = graph.nEdges();
+            THEN("the graph is left unchanged") {
+                REQUIRE_THROWS_AS(graph.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0}),
+                                  std::length_error);
+                REQUIRE(graph.nEdges() == nEdges);
+                REQUIRE(graph.vertices().at(graphs::PersistentIndex{0}).neighbors().size() == 2);
+                // an existing neighbor does not count against the bound
+                REQUIRE_NOTHROW(graph.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{10}));
+                REQUIRE(graph.vertices().at(graphs::PersistentIndex{9}).neighbors().size() == 4);
+            }
+        }
+        WHEN("exceeding the valence in a batch") {
+            auto batch = graph.batch();
+            batch.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0});
+            batch.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{2});
+            THEN("nothing is applied") {
+                REQUIRE_THROWS_AS(batch.commit(), std::length_error);
+                REQUIRE(batch.nPending() == 0);
+                test::requireSameGraph(graph, reference);
+            }
+        }
+        WHEN("exceeding the valence in a batch which is committed on scope exit") {
+            {
+                auto batch = graph.batch();
+                batch.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0});
+                batch.addEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{2});
+            }
+            THEN("the batch is discarded instead of throwing from its destructor") {
+                test::requireSameGraph(graph, reference);
+            }
+        }
+        WHEN("swapping a neighbor of a full vertex in a batch") {
+            {
+                auto batch = graph.batch();
+                batch.removeEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{10});
+                batch.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0});
+            }
+            THEN("the net degree stays within the bound") {
+                REQUIRE(graph.containsEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0}));
+                REQUIRE(!graph.containsEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{10}));
+                REQUIRE(graph.vertices().at(graphs::PersistentIndex{9}).neighbors().size() == 4);
+            }
+        }
+        WHEN("reading a graph whose degree is too high") {
+            reference.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0});
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            reference.write(ss);
+            THEN("it is refused") {
+                REQUIRE_THROWS_AS(Graph4::read(ss), std::length_error);
+            }
+        }
+    }
+}
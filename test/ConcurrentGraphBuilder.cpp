@@ -0,0 +1,192 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <random>
+#include <thread>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+#include <graphs/ConcurrentGraphBuilder.h>
+
+#include "GraphComparison.h"
+
+namespace {
+
+/**
+ * Builds the same random edges, with duplicates and edges already in the graph, once through a batch and once
+ * through a builder finalized on a thread pool.
+ */
+template<typename Graph>
+void requireSameAsBatch(std::size_t nVertices, std::size_t nEdges) {
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<std::size_t> vertex(0, nVertices - 1);
+    Graph reference;
+    for (std::size_t i = 0; i < nVertices; ++i) {
+        reference.addVertex(i);
+    }
+    for (std::size_t i = 0; i + 1 < nVertices; i += 2) {
+        reference.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{i + 1});
+    }
+    std::vector<typename Graph::Edge> edges;
+    for (std::size_t i = 0; i < nEdges; ++i) {
+        edges.emplace_back(graphs::PersistentIndex{vertex(rng)}, graphs::PersistentIndex{vertex(rng)});
+    }
+    edges.emplace_back(graphs::PersistentIndex{1}, graphs::PersistentIndex{0});
+    edges.emplace_back(graphs::PersistentIndex{3}, graphs::PersistentIndex{3});
+
+    graphs::ConcurrentGraphBuilder<Graph> builder(reference, nEdges / 2);
+    builder.addEdges(edges.begin(), edges.end());
+    {
+        auto batch = reference.batch();
+        for (const auto &edge : edges) {
+            batch.addEdge(edge);
+        }
+        batch.commit();
+    }
+    graphs::ThreadPool pool(4);
+    auto graph = builder.finalize(pool);
+    test::requireSameGraph(graph, reference);
+    REQUIRE(builder.nRecordedEdges() == 0);
+}
+
+}
+
+SCENARIO("Concurrent graph construction", "[builder]") {
+    GIVEN("A builder with a small edge pool") {
+        graphs::ConcurrentGraphBuilder<graphs::DefaultGraph> builder({}, 100);
+        constexpr std::size_t nThreads = 8;
+        constexpr std::size_t nVerticesPerThread = 50;
+
+        WHEN("many threads add vertices and grow a ring through overlapping edges") {
+            std::vector<std::size_t> vertices(nThreads * nVerticesPerThread);
+            for (std::size_t i = 0; i < vertices.size(); ++i) {
+                vertices[i] = builder.addVertex(i).value;
+            }
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < nThreads; ++t) {
+                threads.emplace_back([&, t]() {
+                    std::vector<graphs::DefaultGraph::Edge> edges;
+                    for (std::size_t i = t * nVerticesPerThread; i < (t + 1) * nVerticesPerThread; ++i) {
+                        graphs::PersistentIndex ix1 {vertices[i]};
+                        graphs::PersistentIndex ix2 {vertices[(i + 1) % vertices.size()]};
+                        builder.addEdge(ix1, ix2);
+                        // every edge is inserted a second time, reversed and in bulk
+                        edges.emplace_back(ix2, ix1);
+                    }
+                    builder.addEdges(edges.begin(), edges.end());
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            THEN("finalizing yields the deduplicated ring") {
+                REQUIRE(builder.nRecordedEdges() == 2 * vertices.size());
+                auto graph = builder.finalize();
+                REQUIRE(graph.nVertices() == vertices.size());
+                REQUIRE(graph.nEdges() == vertices.size());
+                REQUIRE(graph.isConnected());
+                for (const auto &v : graph) {
+                    REQUIRE(v.neighbors().size() == 2);
+                }
+                REQUIRE(builder.nRecordedEdges() == 0);
+            }
+        }
+        WHEN("threads add vertices and chain them to a shared root at the same time") {
+            auto root = builder.addVertex(0);
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < nThreads; ++t) {
+                threads.emplace_back([&]() {
+                    auto previous = root;
+                    for (std::size_t i = 0; i < nVerticesPerThread; ++i) {
+                        auto ix = builder.addVertex(i + 1);
+                        builder.addEdge(previous, ix);
+                        previous = ix;
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            THEN("finalizing yields a tree of chains hanging off the root") {
+                auto graph = builder.finalize();
+                REQUIRE(graph.nVertices() == 1 + nThreads * nVerticesPerThread);
+                REQUIRE(graph.nEdges() == nThreads * nVerticesPerThread);
+                REQUIRE(graph.isConnected());
+                REQUIRE(graph.vertices().at(root).neighbors().size() == nThreads);
+            }
+        }
+        WHEN("an edge refers to a vertex which was removed") {
+            auto ix = builder.addVertex();
+            auto ix2 = builder.addVertex();
+            builder.addEdge(ix, ix2);
+            auto removed = builder.addVertex();
+            builder.addEdge(ix, removed);
+            auto graph = builder.finalize();
+            graph.removeVertex(removed);
+            graphs::ConcurrentGraphBuilder<graphs::DefaultGraph> builder2(std::move(graph));
+            builder2.addEdge(ix2, removed);
+            THEN("finalize throws") {
+                REQUIRE_THROWS_AS(builder2.finalize(), std::invalid_argument);
+            }
+        }
+        WHEN("an edge refers to an index beyond the vertices of the graph") {
+            auto ix = builder.addVertex();
+            auto ix2 = builder.addVertex();
+            builder.addEdge(ix, ix2);
+            builder.addEdge(ix, graphs::PersistentIndex{5});
+            THEN("finalize throws and leaves the builder unchanged") {
+                REQUIRE_THROWS_AS(builder.finalize(), std::invalid_argument);
+                REQUIRE(builder.nRecordedEdges() == 2);
+                builder.addVertex();
+                builder.addVertex();
+                builder.addVertex();
+                builder.addVertex();
+                auto graph = builder.finalize();
+                REQUIRE(graph.nEdges() == 2);
+                REQUIRE(graph.containsEdge(ix, graphs::PersistentIndex{5}));
+            }
+        }
+    }
+}
+
+SCENARIO("Finalizing a concurrent graph builder on a thread pool", "[builder]") {
+    GIVEN("Random edges over more vertices than fit into a single range") {
+        THEN("finalizing a default graph on a pool gives the same graph as a batch") {
+            requireSameAsBatch<graphs::DefaultGraph>(3000, 30000);
+        }
+        THEN("finalizing a graph with sorted neighbors on a pool gives the same graph as a batch") {
+            requireSameAsBatch<graphs::SortedGraph>(3000, 30000);
+        }
+        THEN("finalizing a copy-on-write graph on a pool gives the same graph as a batch") {
+            requireSameAsBatch<graphs::CowGraph>(3000, 30000);
+        }
+    }
+    GIVEN("A builder on a pool with an invalid edge among many valid ones") {
+        graphs::ConcurrentGraphBuilder<graphs::DefaultGraph> builder({}, 1000);
+        for (std::size_t i = 0; i < 100; ++i) {
+            builder.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 20000; ++i) {
+            builder.addEdge(graphs::PersistentIndex{i % 100}, graphs::PersistentIndex{(i * 7) % 100});
+        }
+        builder.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{100});
+        graphs::ThreadPool pool(4);
+        THEN("finalize throws and leaves the builder unchanged") {
+            REQUIRE_THROWS_AS(builder.finalize(pool), std::invalid_argument);
+            REQUIRE(builder.nRecordedEdges() == 20001);
+        }
+    }
+    GIVEN("A builder of a graph with bounded degree") {
+        graphs::ConcurrentGraphBuilder<graphs::BoundedGraph<2>> builder({}, 10);
+        auto center = builder.addVertex(0);
+        for (std::size_t i = 1; i <= 3; ++i) {
+            builder.addEdge(center, builder.addVertex(i));
+        }
+        graphs::ThreadPool pool(2);
+        THEN("finalize throws if a vertex would exceed the maximum degree") {
+            REQUIRE_THROWS_AS(builder.finalize(pool), std::length_error);
+            REQUIRE(builder.nRecordedEdges() == 3);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <numeric>
+
+#include <catch2/catch.hpp>
+#include <graphs/CowVector.h>
+
+using SmallCowVector = graphs::detail::ChunkedCowVector<int, 4>;
+
+SCENARIO("Chunked copy-on-write vector", "[cow]") {
+    GIVEN("A vector with 10 elements in chunks of 4") {
+        SmallCowVector v;
+        for (int i = 0; i < 10; ++i) {
+            v.push_back(i);
+        }
+        THEN("it behaves like a vector") {
+            REQUIRE(v.size() == 10);
+            REQUIRE(v.n_chunks() == 3);
+            REQUIRE(v.front() == 0);
+            REQUIRE(v.back() == 9);
+            REQUIRE(std::accumulate(v.cbegin(), v.cend(), 0) == 45);
+            REQUIRE(std::distance(v.begin(), v.end()) == 10);
+            REQUIRE_THROWS_AS(v.at(10), std::out_of_range);
+        }
+        WHEN("erasing and inserting elements") {
+            v.erase(v.cbegin() + 2, v.cbegin() + 5);
+            v.insert(v.cbegin() + 1, 42);
+            std::vector<int> expected {0, 42, 1, 5, 6, 7, 8, 9};
+            THEN("the elements are shifted accordingly") {
+                REQUIRE(std::equal(v.cbegin(), v.cend(), expected.begin(), expected.end()));
+                REQUIRE(v.n_chunks() == 2);
+            }
+        }
+        WHEN("copying the vector") {
+            auto copy = v;
+            THEN("all chunks are shared") {
+                REQUIRE(copy == v);
+                REQUIRE(v.n_shared_chunks() == 3);
+                REQUIRE(copy.n_shared_chunks() == 3);
+            }
+            AND_WHEN("writing to one element of the copy") {
+                copy[5] = 100;
+                THEN("only the touched chunk is duplicated") {
+                    REQUIRE(v[5] == 5);
+                    REQUIRE(copy[5] == 100);
+                    REQUIRE(v.n_shared_chunks() == 2);
+                    REQUIRE(copy.n_shared_chunks() == 2);
+                }
+            }
+            AND_WHEN("reading through const iterators") {
+                const auto &constCopy = copy;
+                auto sum = std::accumulate(constCopy.begin(), constCopy.end(), 0);
+                THEN("no chunk is duplicated") {
+                    REQUIRE(sum == 45);
+                    REQUIRE(copy.n_shared_chunks() == 3);
+                }
+            }
+            AND_WHEN("appending to the original") {
+                v.push_back(10);
+                v.pop_back();
+                v.pop_back();
+                THEN("the copy is unaffected") {
+                    REQUIRE(copy.size() == 10);
+                    REQUIRE(copy.back() == 9);
+                    REQUIRE(v.size() == 9);
+                    REQUIRE(v.n_shared_chunks() == 2);
+                }
+            }
+        }
+    }
+}
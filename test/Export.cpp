@@ -0,0 +1,133 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <sstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+namespace {
+/**
+ * Stream buffer which records the number of bulk writes.
+ */
+class CountingStreamBuffer : public std::stringbuf {
+public:
+    std::size_t nWrites {0};
+
+protected:
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+        ++nWrites;
+        return std::stringbuf::xsputn(s, n);
+    }
+};
+
+struct Opaque {
+    int value;
+};
+
+bool contains(const std::string &document, const std::string &part) {
+    return document.find(part) != std::string::npos;
+}
+}
+
+SCENARIO("Exporting graphs", "[export]") {
+    GIVEN("A graph with a blank") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 4; ++i) {
+            graph.addVertex(10 * i);
+        }
+        graph.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{1});
+        graph.addEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{2});
+        graph.addEdge(graphs::PersistentIndex{2}, graphs::PersistentIndex{3});
+        graph.removeVertex(graphs::PersistentIndex{1});
+
+        WHEN("exporting to GEXF") {
+            std::ostringstream os;
+            graphs::exportGraph(graph, os, graphs::ExportFormat::gexf);
+            THEN("nodes are identified by their persistent index, matching the edges") {
+                REQUIRE(os.str() == graph.gexf());
+                REQUIRE(contains(os.str(), R"(<nodes><node id="0" /><node id="2" /><node id="3" /></nodes>)"));
+                REQUIRE(contains(os.str(), R"(<edges><edge id="0" source="2" target="3" /></edges>)"));
+            }
+            THEN("vertex data is written as attributes") {
+                fmt::memory_buffer buffer;
+                graphs::exportGraph(graph, buffer, graphs::ExportFormat::gexf, {true});
+                auto document = fmt::to_string(buffer);
+                REQUIRE(contains(document, R"(<attribute id="0" title="data0" type="string" />)"));
+                REQUIRE(contains(document, R"(<node id="3"><attvalues><attvalue for="0" value="30" /></attvalues></node>)"));
+            }
+        }
+        WHEN("exporting to GraphML") {
+            fmt::memory_buffer buffer;
+            graphs::exportGraph(graph, buffer, graphs::ExportFormat::graphml, {true});
+            auto document = fmt::to_string(buffer);
+            THEN("nodes, keys and edges are written") {
+                REQUIRE(contains(document, "<graph id=\"G\" edgedefault=\"undirected\">"));
+                REQUIRE(contains(document, "<key id=\"d0\" for=\"node\" attr.name=\"data0\" attr.type=\"string\"/>"));
+                REQUIRE(contains(document, "<node id=\"n2\"><data key=\"d0\">20</data></node>"));
+                REQUIRE(!contains(document, "<node id=\"n1\""));
+                REQUIRE(contains(document, "<edge id=\"e0\" source=\"n2\" target=\"n3\"/>"));
+                REQUIRE(contains(document, "</graphml>"));
+            }
+        }
+        WHEN("exporting to DOT") {
+            fmt::memory_buffer buffer;
+            graphs::exportGraph(graph, buffer, graphs::ExportFormat::dot);
+            THEN("the document lists the vertices and edges") {
+                REQUIRE(fmt::to_string(buffer) == "graph G {\n0;\n2;\n3;\n2 -- 3;\n}\n");
+            }
+        }
+    }
+    GIVEN("A graph with string data") {
+        using Graph = graphs::Graph<graphs::IndexPersistentVector, graphs::Vertex<std::string, int>>;
+        Graph graph;
+        graph.addVertex({R"(a<b & "c")", 1});
+        WHEN("exporting with vertex data") {
+            THEN("special characters are escaped") {
+                fmt::memory_buffer gexf;
+                graphs::exportGraph(graph, gexf, graphs::ExportFormat::gexf, {true});
+                REQUIRE(contains(fmt::to_string(gexf), R"(<attvalue for="0" value="a&lt;b &amp; &quot;c&quot;" />)"));
+                REQUIRE(contains(fmt::to_string(gexf), R"(<attvalue for="1" value="1" />)"));
+
+                fmt::memory_buffer dot;
+                graphs::exportGraph(graph, dot, graphs::ExportFormat::dot, {true});
+                REQUIRE(fmt::to_string(dot) == "graph G {\n0 [label=\"a<b & \\\"c\\\", 1\"];\n}\n");
+            }
+        }
+    }
+    GIVEN("A larger graph") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 2000; ++i) {
+            graph.addVertex(i);
+            if (i > 0) {
+                graph.addEdge(graphs::PersistentIndex{i - 1}, graphs::PersistentIndex{i});
+            }
+        }
+        WHEN("exporting to a stream with a small chunk size") {
+            CountingStreamBuffer streamBuffer;
+            std::ostream os(&streamBuffer);
+            graphs::ExportOptions options;
+            options.chunkSize = 1024;
+            graphs::exportGraph(graph, os, graphs::ExportFormat::graphml, options);
+            THEN("the document is written in chunks and equals the one in memory") {
+                fmt::memory_buffer buffer;
+                graphs::exportGraph(graph, buffer, graphs::ExportFormat::graphml);
+                REQUIRE(streamBuffer.str() == fmt::to_string(buffer));
+                REQUIRE(streamBuffer.nWrites > buffer.size() / 2048);
+            }
+        }
+    }
+    GIVEN("A graph whose data has no formatter") {
+        graphs::Graph<graphs::IndexPersistentVector, graphs::Vertex<Opaque>> graph;
+        graph.addVertex({Opaque{1}});
+        THEN("it can only be exported without vertex data") {
+            fmt::memory_buffer buffer;
+            graphs::exportGraph(graph, buffer, graphs::ExportFormat::dot);
+            REQUIRE(fmt::to_string(buffer) == "graph G {\n0;\n}\n");
+            REQUIRE_THROWS_AS(graphs::exportGraph(graph, buffer, graphs::ExportFormat::dot, {true}),
+                              std::invalid_argument);
+        }
+    }
+}
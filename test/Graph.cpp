@@ -3,7 +3,12 @@
 //
 
 #include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <sstream>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -507,3 +512,976 @@ SCENARIO("Testing graphs basic functionality", "[graphs]") {
         }
     }
 }
+
+template<typename Graph1, typename Graph2>
+void requireSameTopology(const Graph1 &g1, const Graph2 &g2) {
+    REQUIRE(g1.vertices().size_persistent() == g2.vertices().size_persistent());
+    REQUIRE(g1.nVertices() == g2.nVertices());
+    REQUIRE(g1.nEdges() == g2.nEdges());
+    for (std::size_t i = 0; i < g1.vertices().size_persistent(); ++i) {
+        const auto &v1 = *(g1.vertices().begin_persistent() + i);
+        const auto &v2 = *(g2.vertices().begin_persistent() + i);
+        REQUIRE(v1.deactivated() == v2.deactivated());
+        if (!v1.deactivated()) {
+            auto n1 = v1.neighbors();
+            auto n2 = v2.neighbors();
+            std::sort(n1.begin(), n1.end());
+            std::sort(n2.begin(), n2.end());
+            REQUIRE(n1 == n2);
+        }
+    }
+    for (const auto &[i1, i2] : g1.edges()) {
+        REQUIRE(g2.containsEdge(i1, i2));
+    }
+}
+
+SCENARIO("Batched mutations", "[graphs]") {
+    GIVEN("A ring of 10 vertices") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 10; ++i) {
+            graph.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 10; ++i) {
+            graph.addEdge(i, (i + 1) % 10);
+        }
+        auto ix = [](std::size_t i) { return graphs::PersistentIndex{i}; };
+
+        WHEN("removing a vertex, cutting the ring open and adding a chord in one batch") {
+            auto reference = graph;
+            reference.removeVertex(ix(0));
+            reference.removeEdge(ix(5), ix(6));
+            reference.addEdge(ix(2), ix(7));
+            {
+                auto batch = graph.batch();
+                batch.removeVertex(ix(0));
+                batch.removeEdge(ix(5), ix(6));
+                batch.addEdge(ix(2), ix(7));
+                THEN("nothing is applied before commit") {
+                    REQUIRE(batch.nPending() == 3);
+                    REQUIRE(graph.nEdges() == 10);
+                    REQUIRE(graph.nVertices() == 10);
+                }
+            }
+            THEN("the graph equals the graph obtained through sequential mutations") {
+                requireSameTopology(graph, reference);
+                REQUIRE(graph.nEdges() == 8);
+                REQUIRE(graph.containsEdge(ix(7), ix(2)));
+                REQUIRE(graph.isConnected());
+            }
+        }
+
+        WHEN("adding vertices and edges to them in one batch") {
+            auto batch = graph.batch();
+            auto v1 = batch.addVertex(10);
+            auto v2 = batch.addVertex(11);
+            batch.addEdge(v1, v2);
+            batch.addEdge(v2, ix(3));
+            batch.commit();
+            THEN("the new vertices are connected to the ring") {
+                REQUIRE(batch.nPending() == 0);
+                REQUIRE(graph.nVertices() == 12);
+                REQUIRE(graph.nEdges() == 12);
+                REQUIRE(graph.graphDistance(v1, ix(3)) == 2);
+            }
+        }
+
+        WHEN("recording conflicting operations on the same edge") {
+            auto batch = graph.batch();
+            batch.removeEdge(ix(1), ix(2));
+            batch.addEdge(ix(2), ix(1));
+            batch.addEdge(ix(1), ix(5));
+            batch.removeEdge(ix(5), ix(1));
+            batch.addEdge(ix(3), ix(4));
+            batch.commit();
+            THEN("the last operation per edge wins and existing edges are not duplicated") {
+                REQUIRE(graph.nEdges() == 10);
+                REQUIRE(graph.containsEdge(ix(1), ix(2)));
+                REQUIRE_FALSE(graph.containsEdge(ix(1), ix(5)));
+                REQUIRE(graph.vertices().at(ix(3)).neighbors().size() == 2);
+            }
+        }
+
+        WHEN("adding an edge to a vertex which is removed in the same batch") {
+            auto batch = graph.batch();
+            batch.addEdge(ix(0), ix(5));
+            batch.removeVertex(ix(0));
+            batch.commit();
+            THEN("the edge is dropped together with the vertex") {
+                REQUIRE(graph.nVertices() == 9);
+                REQUIRE(graph.nEdges() == 8);
+                REQUIRE(graph.vertices().at(ix(5)).neighbors().size() == 2);
+            }
+        }
+
+        WHEN("adding an edge to a deactivated vertex") {
+            graph.removeVertex(ix(4));
+            auto batch = graph.batch();
+            THEN("the batch throws") {
+                REQUIRE_THROWS_AS(batch.addEdge(ix(4), ix(7)), std::invalid_argument);
+                REQUIRE_THROWS_AS(batch.removeVertex(ix(4)), std::invalid_argument);
+            }
+        }
+
+        WHEN("an operation throws while the batch is open") {
+            graph.removeVertex(ix(4));
+            auto reference = graph;
+            auto recordAndFail = [&graph, &ix] {
+                auto batch = graph.batch();
+                batch.addEdge(ix(1), ix(7));
+                batch.removeEdge(ix(1), ix(2));
+                batch.removeVertex(ix(4));
+            };
+            REQUIRE_THROWS_AS(recordAndFail(), std::invalid_argument);
+            THEN("the operations recorded before are discarded when the batch is unwound") {
+                requireSameTopology(graph, reference);
+            }
+        }
+    }
+
+    GIVEN("A random sequence of mutations") {
+        std::mt19937 rng(42);
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 50; ++i) {
+            graph.addVertex(i);
+        }
+        auto reference = graph;
+        {
+            auto batch = graph.batch();
+            std::uniform_int_distribution<std::size_t> vertexDist(0, 49);
+            std::uniform_int_distribution<int> opDist(0, 9);
+            std::vector<graphs::PersistentIndex> removed;
+            auto isRemoved = [&removed](graphs::PersistentIndex ix) {
+                return std::find(removed.begin(), removed.end(), ix) != removed.end();
+            };
+            for (int i = 0; i < 500; ++i) {
+                graphs::PersistentIndex ix1{vertexDist(rng)};
+                graphs::PersistentIndex ix2{vertexDist(rng)};
+                if (ix1 == ix2 || isRemoved(ix1) || isRemoved(ix2)) {
+                    continue;
+                }
+                auto op = opDist(rng);
+                if (op < 6) {
+                    if (!reference.containsEdge(ix1, ix2)) {
+                        reference.addEdge(ix1, ix2);
+                    }
+                    batch.addEdge(ix1, ix2);
+                } else if (op < 9) {
+                    reference.removeEdge(ix1, ix2);
+                    batch.removeEdge(ix1, ix2);
+                } else {
+                    reference.removeVertex(ix1);
+                    batch.removeVertex(ix1);
+                    removed.push_back(ix1);
+                }
+            }
+        }
+        THEN("applying them as a batch yields the same graph as applying them one by one") {
+            requireSameTopology(graph, reference);
+        }
+    }
+}
+
+SCENARIO("Checkpoint and rollback of speculative mutations", "[graphs]") {
+    GIVEN("A fully connected graph of size 6 with one removed vertex") {
+        auto graph = fullyConnectedGraph(6);
+        graph.removeVertex(graphs::PersistentIndex{2});
+        auto original = graph;
+        auto requireOriginal = [&original](const graphs::DefaultGraph &g) {
+            REQUIRE(g.edges() == original.edges());
+            REQUIRE(g.vertices().size_persistent() == original.vertices().size_persistent());
+            REQUIRE(g.nVertices() == original.nVertices());
+            for (std::size_t i = 0; i < g.vertices().size_persistent(); ++i) {
+                const auto &v1 = *(g.vertices().begin_persistent() + i);
+                const auto &v2 = *(original.vertices().begin_persistent() + i);
+                REQUIRE(v1.deactivated() == v2.deactivated());
+                if (!v1.deactivated()) {
+                    REQUIRE(v1.neighbors() == v2.neighbors());
+                    REQUIRE(v1.data() == v2.data());
+                }
+            }
+        };
+
+        WHEN("opening a checkpoint and mutating the graph") {
+            graph.checkpoint();
+            REQUIRE(graph.journaling());
+            auto v = graph.addVertex(10);
+            graph.addEdge(v, graphs::PersistentIndex{0});
+            graph.removeEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{3});
+            graph.removeVertex(graphs::PersistentIndex{4});
+            auto v2 = graph.addVertex(11);
+            graph.addEdge(v2, v);
+            graph.append(fullyConnectedGraph(3), v2, graphs::PersistentIndex{0});
+            REQUIRE(graph.nVertices() == 9);
+
+            THEN("rolling back restores the original graph exactly") {
+                graph.rollback();
+                REQUIRE_FALSE(graph.journaling());
+                requireOriginal(graph);
+            }
+            THEN("committing keeps the mutations") {
+                graph.commit();
+                REQUIRE_FALSE(graph.journaling());
+                REQUIRE(graph.nVertices() == 9);
+                REQUIRE(graph.containsEdge(v2, v));
+                REQUIRE_FALSE(graph.containsEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{3}));
+            }
+            THEN("a nested checkpoint can be rolled back separately") {
+                auto nEdges = graph.nEdges();
+                graph.checkpoint();
+                graph.removeVertex(graphs::PersistentIndex{0});
+                {
+                    auto batch = graph.batch();
+                    batch.addEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{3});
+                    batch.removeVertex(graphs::PersistentIndex{5});
+                }
+                graph.rollback();
+                REQUIRE(graph.nEdges() == nEdges);
+                REQUIRE(graph.nVertices() == 9);
+                graph.rollback();
+                requireOriginal(graph);
+            }
+        }
+
+        WHEN("performing random moves which are rejected") {
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<std::size_t> dist(0, 20);
+            for (int trial = 0; trial < 20; ++trial) {
+                graph.checkpoint();
+                for (int i = 0; i < 10; ++i) {
+                    auto n = graph.vertices().size_persistent();
+                    graphs::PersistentIndex ix1{dist(rng) % n};
+                    graphs::PersistentIndex ix2{dist(rng) % n};
+                    auto active = [&graph](auto ix) {
+                        return !(graph.vertices().begin_persistent() + ix.value)->deactivated();
+                    };
+                    switch (dist(rng) % 4) {
+                        case 0: graph.addVertex(dist(rng)); break;
+                        case 1: if (active(ix1) && active(ix2)) graph.addEdge(ix1, ix2); break;
+                        case 2: if (active(ix1) && active(ix2)) graph.removeEdge(ix1, ix2); break;
+                        case 3: if (active(ix1)) graph.removeVertex(ix1); break;
+                    }
+                }
+                graph.rollback();
+            }
+            THEN("the graph is unchanged") {
+                requireOriginal(graph);
+            }
+        }
+
+        THEN("rolling back without checkpoint throws") {
+            REQUIRE_THROWS_AS(graph.rollback(), std::logic_error);
+            REQUIRE_THROWS_AS(graph.commit(), std::logic_error);
+        }
+    }
+}
+
+SCENARIO("Copy-on-write graph snapshots", "[graphs]") {
+    GIVEN("A copy-on-write graph and a default graph with the same random topology") {
+        std::mt19937 rng(11);
+        graphs::CowGraph graph;
+        graphs::DefaultGraph reference;
+        std::uniform_int_distribution<std::size_t> dist(0, 999);
+        for (std::size_t i = 0; i < 1000; ++i) {
+            graph.addVertex(i);
+            reference.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 2000; ++i) {
+            graphs::PersistentIndex ix1{dist(rng)};
+            graphs::PersistentIndex ix2{dist(rng)};
+            if (ix1 != ix2 && !reference.containsEdge(ix1, ix2)) {
+                graph.addEdge(ix1, ix2);
+                reference.addEdge(ix1, ix2);
+            }
+        }
+        requireSameTopology(graph, reference);
+
+        WHEN("taking a snapshot and mutating the original") {
+            auto snapshot = graph.snapshot();
+            auto referenceSnapshot = reference;
+            for (std::size_t i = 0; i < 20; ++i) {
+                graphs::PersistentIndex ix{dist(rng)};
+                if (!(reference.vertices().begin_persistent() + ix.value)->deactivated()) {
+                    graph.removeVertex(ix);
+                    reference.removeVertex(ix);
+                }
+            }
+            graph.addEdge(graphs::PersistentIndex{0}, graph.addVertex(1000));
+            reference.addEdge(graphs::PersistentIndex{0}, reference.addVertex(1000));
+
+            THEN("the snapshot is unaffected while the original reflects the mutations") {
+                requireSameTopology(snapshot, referenceSnapshot);
+                requireSameTopology(graph, reference);
+                REQUIRE(snapshot.findNTuples() == referenceSnapshot.findNTuples());
+                REQUIRE(snapshot.connectedComponents().size() == referenceSnapshot.connectedComponents().size());
+            }
+            AND_WHEN("mutating the snapshot") {
+                snapshot.removeEdge(std::get<0>(snapshot.edges().front()), std::get<1>(snapshot.edges().front()));
+                referenceSnapshot.removeEdge(std::get<0>(referenceSnapshot.edges().front()),
+                                             std::get<1>(referenceSnapshot.edges().front()));
+                THEN("the original is unaffected") {
+                    requireSameTopology(snapshot, referenceSnapshot);
+                    requireSameTopology(graph, reference);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Memory accounting", "[graphs]") {
+    GIVEN("A chain of ten vertices of which the last three and one in the middle are removed") {
+        graphs::DefaultGraph graph;
+        graph.vertices().reserve(32);
+        std::vector<graphs::PersistentIndex> vertices;
+        for (std::size_t i = 0; i < 10; ++i) {
+            vertices.push_back(graph.addVertex(i));
+        }
+        for (std::size_t i = 1; i < 10; ++i) {
+            graph.addEdge(vertices[i - 1], vertices[i]);
+        }
+        for (auto i : {4, 7, 8, 9}) {
+            graph.removeVertex(vertices[i]);
+        }
+        using Vertex = graphs::DefaultVertex;
+        WHEN("reporting the memory usage") {
+            auto usage = graph.memoryUsage();
+            THEN("it is broken down by component") {
+                REQUIRE(usage.vertices == 32 * sizeof(Vertex));
+                REQUIRE(usage.edges >= graph.nEdges() * sizeof(graphs::DefaultGraph::Edge));
+                REQUIRE(usage.neighbors >= (2 * graph.nEdges()) * sizeof(graphs::PersistentIndex));
+                REQUIRE(usage.blanks > 0);
+                REQUIRE(usage.blankRatio == Approx(0.4));
+                REQUIRE(usage.deactivatedSlack > 4 * sizeof(Vertex));
+                REQUIRE(usage.wastedCapacity >= 22 * sizeof(Vertex));
+                REQUIRE(usage.total() == usage.vertices + usage.neighbors + usage.edges + usage.blanks);
+            }
+        }
+        WHEN("shrinking") {
+            auto before = graph.memoryUsage();
+            graph.shrinkToFit();
+            auto usage = graph.memoryUsage();
+            THEN("the memory is trimmed while the topology and persistent indices are kept") {
+                REQUIRE(usage.total() < before.total());
+                REQUIRE(usage.vertices == 7 * sizeof(Vertex));
+                REQUIRE(usage.blankRatio == Approx(1. / 7.));
+                REQUIRE(usage.deactivatedSlack == sizeof(Vertex));
+                REQUIRE(usage.wastedCapacity == 0);
+                REQUIRE(graph.nVertices() == 6);
+                REQUIRE(graph.nEdges() == 4);
+                REQUIRE(graph.containsEdge(vertices[5], vertices[6]));
+                REQUIRE(graph.vertices().at(vertices[6]).data() == 6);
+            }
+        }
+        WHEN("shrinking while journaling") {
+            graph.checkpoint();
+            THEN("it is refused") {
+                REQUIRE_THROWS_AS(graph.shrinkToFit(), std::logic_error);
+            }
+        }
+    }
+}
+
+namespace {
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t nAllocations {0};
+    std::size_t nBytes {0};
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++nAllocations;
+        nBytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        nBytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * Stands in for the default resource: refuses to allocate and only counts deallocations, which must not happen.
+ */
+class StrayDeallocations : public std::pmr::memory_resource {
+public:
+    std::size_t nDeallocations {0};
+
+private:
+    void *do_allocate(std::size_t, std::size_t) override {
+        throw std::bad_alloc();
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {
+        ++nDeallocations;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+}
+
+SCENARIO("Graphs allocating from a memory resource", "[graphs]") {
+    GIVEN("A pmr graph on a counting resource while the default resource refuses to allocate") {
+        CountingResource resource;
+        auto *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        {
+            graphs::PmrGraph graph(&resource);
+            std::vector<graphs::PersistentIndex> vertices;
+            for (std::size_t i = 0; i < 20; ++i) {
+                vertices.push_back(graph.addVertex(i));
+            }
+            for (std::size_t i = 1; i < 20; ++i) {
+                graph.addEdge(vertices[i - 1], vertices[i]);
+            }
+            graph.removeVertex(vertices[10]);
+            graph.addEdge(vertices[9], graph.addVertex(10));
+            graph.removeEdge(vertices[0], vertices[1]);
+            std::pmr::set_default_resource(previous);
+
+            THEN("all vertices, neighbors, blanks and edges were allocated from the resource") {
+                REQUIRE(graph.get_allocator().resource() == &resource);
+                REQUIRE(graph.begin()->neighbors().get_allocator().resource() == &resource);
+                REQUIRE(resource.nAllocations > 0);
+                REQUIRE(graph.nEdges() == 17);
+            }
+            WHEN("copying into another resource") {
+                CountingResource other;
+                graphs::PmrGraph copy(graph, &other);
+                THEN("the copy allocates from the other resource only") {
+                    REQUIRE(other.nAllocations > 0);
+                    REQUIRE(copy.get_allocator().resource() == &other);
+                    for (const auto &v : copy) {
+                        REQUIRE(v.neighbors().get_allocator().resource() == &other);
+                    }
+                    requireSameTopology(copy, graph);
+                }
+            }
+            WHEN("reordering it") {
+                graph.reorder();
+                THEN("the reordered vertices allocate from the resource as well") {
+                    REQUIRE(graph.vertices().get_allocator().resource() == &resource);
+                    for (const auto &v : graph) {
+                        REQUIRE(v.neighbors().get_allocator().resource() == &resource);
+                    }
+                }
+            }
+        }
+        THEN("destroying the graph returns everything to the resource") {
+            REQUIRE(resource.nBytes == 0);
+        }
+    }
+    GIVEN("A pmr graph on a pool resource with a removed vertex") {
+        CountingResource upstream;
+        std::pmr::unsynchronized_pool_resource pool(&upstream);
+        graphs::PmrGraph graph(&pool);
+        std::vector<graphs::PersistentIndex> vertices;
+        for (std::size_t i = 0; i < 10; ++i) {
+            vertices.push_back(graph.addVertex(i));
+        }
+        for (std::size_t i = 1; i < 10; ++i) {
+            graph.addEdge(vertices[i - 1], vertices[i]);
+        }
+        graph.removeVertex(vertices[4]);
+        WHEN("shrinking it") {
+            StrayDeallocations stray;
+            auto *previous = std::pmr::set_default_resource(&stray);
+            graph.shrinkToFit();
+            std::pmr::set_default_resource(previous);
+            THEN("the neighbor list of the removed vertex is returned to the pool") {
+                REQUIRE(stray.nDeallocations == 0);
+                REQUIRE((graph.vertices().begin_persistent() + 4)->neighbors().capacity() == 0);
+                REQUIRE((graph.vertices().begin_persistent() + 4)->neighbors().get_allocator().resource() == &pool);
+                REQUIRE(graph.nEdges() == 7);
+            }
+        }
+    }
+}
+
+SCENARIO("Graphs with 32-bit persistent indices", "[graphs]") {
+    using Index = graphs::Graph32::PersistentVertexIndex;
+    static_assert(std::is_same_v<Index, graphs::PersistentIndex32>);
+    static_assert(sizeof(graphs::Graph32::Edge) == 2 * sizeof(std::uint32_t));
+    GIVEN("A ring of 8 vertices with one chord and a blank as 32-bit and as default graph") {
+        graphs::Graph32 graph;
+        graphs::DefaultGraph reference;
+        for (std::size_t i = 0; i < 8; ++i) {
+            REQUIRE(graph.addVertex(i).value == reference.addVertex(i).value);
+        }
+        for (std::size_t i = 0; i < 8; ++i) {
+            graph.addEdge(Index::of(i), Index::of((i + 1) % 8));
+            reference.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{(i + 1) % 8});
+        }
+        graph.addEdge(Index::of(0), Index::of(4));
+        reference.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{4});
+        graph.removeVertex(Index::of(6));
+        reference.removeVertex(graphs::PersistentIndex{6});
+
+        THEN("both graphs have the same topology") {
+            REQUIRE(graph.nVertices() == reference.nVertices());
+            REQUIRE(graph.nEdges() == reference.nEdges());
+            REQUIRE(graph.graphDistance(Index::of(0), Index::of(5)) ==
+                    reference.graphDistance(graphs::PersistentIndex{0}, graphs::PersistentIndex{5}));
+            auto [pairs, triples, quadruples] = graph.findNTuples();
+            auto [referencePairs, referenceTriples, referenceQuadruples] = reference.findNTuples();
+            REQUIRE(pairs.size() == referencePairs.size());
+            REQUIRE(triples.size() == referenceTriples.size());
+            REQUIRE(quadruples.size() == referenceQuadruples.size());
+            REQUIRE(graph.connectedComponents().size() == reference.connectedComponents().size());
+            REQUIRE(fmt::format("{}", Index::of(3)) == "PersistentIndex[3]");
+        }
+        THEN("neighbor lists and edges take half the memory") {
+            graph.shrinkToFit();
+            reference.shrinkToFit();
+            REQUIRE(2 * graph.memoryUsage().neighbors == reference.memoryUsage().neighbors);
+            REQUIRE(2 * graph.memoryUsage().edges == reference.memoryUsage().edges);
+        }
+        WHEN("reusing the blank and rolling back") {
+            graph.checkpoint();
+            auto v = graph.addVertex(6);
+            graph.addEdge(v, Index::of(5));
+            graph.rollback();
+            THEN("the graph is restored") {
+                REQUIRE(v == Index::of(6));
+                REQUIRE(graph.nVertices() == 7);
+                REQUIRE(graph.nEdges() == 7);
+            }
+        }
+        WHEN("writing and reading it") {
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            graph.write(ss);
+            auto copy = graphs::Graph32::read(ss);
+            THEN("the copy has the same edges") {
+                REQUIRE(copy.edges() == graph.edges());
+                REQUIRE(copy.vertices().n_deactivated() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("Appending graphs in bulk", "[graphs]") {
+    auto sortedNeighbors = [](const auto &graph, graphs::PersistentIndex ix) {
+        const auto &neighbors = graph.vertices().at(ix).neighbors();
+        std::vector<graphs::PersistentIndex> sorted(neighbors.begin(), neighbors.end());
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    };
+    GIVEN("A graph with a self-loop and a graph with a trailing blank") {
+        graphs::DefaultGraph g1;
+        for (std::size_t i = 0; i < 6; ++i) {
+            g1.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 5; ++i) {
+            g1.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{i + 1});
+        }
+        g1.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{3});
+        g1.addEdge(graphs::PersistentIndex{2}, graphs::PersistentIndex{2});
+        auto withBlank = g1;
+        withBlank.removeVertex(withBlank.addVertex(100));
+
+        WHEN("appending it to the graph without and to the graph with blanks") {
+            auto bulk = g1;
+            auto bulkMapping = bulk.append(g1);
+            auto mapping = withBlank.append(g1);
+            THEN("both paths yield the same mapping, data and topology") {
+                REQUIRE(bulkMapping.size() == 6);
+                REQUIRE(bulkMapping[4] == graphs::PersistentIndex{10});
+                REQUIRE(bulk.nVertices() == withBlank.nVertices());
+                REQUIRE(bulk.nEdges() == withBlank.nEdges());
+                REQUIRE(bulk.nEdges() == 14);
+                for (std::size_t i = 0; i < 6; ++i) {
+                    REQUIRE(bulk.vertices().at(bulkMapping[i]).data() == withBlank.vertices().at(mapping[i]).data());
+                    auto expected = sortedNeighbors(g1, graphs::PersistentIndex{i});
+                    for (auto &ix : expected) {
+                        ix = bulkMapping[ix.value];
+                    }
+                    REQUIRE(sortedNeighbors(bulk, bulkMapping[i]) == expected);
+                    REQUIRE(sortedNeighbors(withBlank, mapping[i]).size() == expected.size());
+                }
+                REQUIRE(bulk.containsEdge(bulkMapping[2], bulkMapping[2]));
+                REQUIRE(withBlank.containsEdge(mapping[2], mapping[2]));
+                REQUIRE(bulk.connectedComponents().size() == 2);
+            }
+        }
+        WHEN("appending it to itself while tracking changes") {
+            g1.mark();
+            g1.append(g1);
+            THEN("it contains itself twice and the appended vertices are marked as changed") {
+                REQUIRE(g1.nVertices() == 12);
+                REQUIRE(g1.nEdges() == 14);
+                REQUIRE(g1.containsEdge(graphs::PersistentIndex{6}, graphs::PersistentIndex{9}));
+                REQUIRE(g1.changedVertices().size() == 6);
+                REQUIRE(g1.changedVertices().front() == graphs::PersistentIndex{6});
+            }
+        }
+        WHEN("appending after a checkpoint") {
+            auto original = g1;
+            g1.checkpoint();
+            g1.append(original);
+            g1.rollback();
+            THEN("the graph is restored") {
+                REQUIRE(g1.vertices().size_persistent() == 6);
+                REQUIRE(g1.edges() == original.edges());
+            }
+        }
+    }
+}
+
+SCENARIO("Sorted neighbor lists and neighborhood intersections", "[graphs]") {
+    static_assert(graphs::SortedGraph::SortedNeighbors && !graphs::DefaultGraph::SortedNeighbors);
+    auto requireSorted = [](const graphs::SortedGraph &graph) {
+        for (auto it = graph.vertices().begin(); it != graph.vertices().end(); ++it) {
+            REQUIRE(std::is_sorted(it->neighbors().begin(), it->neighbors().end()));
+        }
+    };
+    GIVEN("A random graph with blanks as sorted and as default graph") {
+        graphs::SortedGraph graph;
+        graphs::DefaultGraph reference;
+        std::mt19937 generator(11);
+        std::uniform_int_distribution<std::size_t> vertexDistribution(0, 39);
+        for (std::size_t i = 0; i < 40; ++i) {
+            graph.addVertex(i);
+            reference.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 160; ++i) {
+            graphs::PersistentIndex ix1 {vertexDistribution(generator)};
+            graphs::PersistentIndex ix2 {vertexDistribution(generator)};
+            if (ix1 != ix2 && !reference.containsEdge(ix1, ix2)) {
+                graph.addEdge(ix1, ix2);
+                reference.addEdge(ix1, ix2);
+            }
+        }
+        for (std::size_t i : {4, 17}) {
+            graph.removeVertex(graphs::PersistentIndex{i});
+            reference.removeVertex(graphs::PersistentIndex{i});
+        }
+
+        THEN("the neighbor lists are sorted and both graphs agree on intersections, triangles and 4-cycles") {
+            requireSorted(graph);
+            REQUIRE(graph.edges() == reference.edges());
+            for (std::size_t i = 0; i < 40; i += 3) {
+                for (std::size_t j = 1; j < 40; j += 7) {
+                    graphs::PersistentIndex ix1 {i};
+                    graphs::PersistentIndex ix2 {j};
+                    if (!graph.vertices().at(ix1).deactivated() && !graph.vertices().at(ix2).deactivated()) {
+                        REQUIRE(graph.commonNeighbors(ix1, ix2) == reference.commonNeighbors(ix1, ix2));
+                    }
+                }
+            }
+            REQUIRE(graph.countTriangles() > 0);
+            REQUIRE(graph.countTriangles() == reference.countTriangles());
+            REQUIRE(graph.countFourCycles() == reference.countFourCycles());
+        }
+        WHEN("mutating it in a batch, rolling back and splitting it") {
+            {
+                auto batch = graph.batch();
+                for (std::size_t i = 0; i < 30; ++i) {
+                    batch.addEdge(graphs::PersistentIndex{39}, graphs::PersistentIndex{i == 4 || i == 17 ? 3 : i});
+                }
+                batch.removeVertex(graphs::PersistentIndex{20});
+            }
+            auto before = graph;
+            graph.checkpoint();
+            graph.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{38});
+            graph.removeEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{39});
+            graph.removeVertex(graphs::PersistentIndex{21});
+            graph.rollback();
+            THEN("the neighbor lists stay sorted") {
+                requireSorted(graph);
+                REQUIRE(graph.edges() == before.edges());
+                for (auto it = graph.vertices().begin(); it != graph.vertices().end(); ++it) {
+                    REQUIRE(it->neighbors() == before.vertices().at(it.persistent_index()).neighbors());
+                }
+                for (const auto &component : graph.connectedComponents()) {
+                    requireSorted(component);
+                }
+            }
+        }
+        WHEN("reading a graph written with unsorted neighbor lists") {
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            reference.write(ss);
+            auto copy = graphs::SortedGraph::read(ss);
+            THEN("the neighbor lists are sorted") {
+                requireSorted(copy);
+                REQUIRE(copy.edges() == reference.edges());
+                REQUIRE(copy.countFourCycles() == reference.countFourCycles());
+            }
+        }
+    }
+    GIVEN("Small graphs with known counts") {
+        graphs::SortedGraph complete;
+        for (std::size_t i = 0; i < 4; ++i) {
+            complete.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 4; ++i) {
+            for (std::size_t j = i + 1; j < 4; ++j) {
+                complete.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{j});
+            }
+        }
+        complete.addEdge(graphs::PersistentIndex{2}, graphs::PersistentIndex{2});
+        graphs::DefaultGraph square;
+        for (std::size_t i = 0; i < 4; ++i) {
+            square.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 4; ++i) {
+            square.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{(i + 1) % 4});
+        }
+        THEN("K4 has four triangles and three 4-cycles, a square one 4-cycle, self-loops are ignored") {
+            REQUIRE(complete.countTriangles() == 4);
+            REQUIRE(complete.countFourCycles() == 3);
+            REQUIRE(complete.commonNeighbors(graphs::PersistentIndex{0}, graphs::PersistentIndex{1}) ==
+                    std::vector<graphs::PersistentIndex>{{2}, {3}});
+            REQUIRE(square.countTriangles() == 0);
+            REQUIRE(square.countFourCycles() == 1);
+            REQUIRE(square.commonNeighbors(graphs::PersistentIndex{0}, graphs::PersistentIndex{2}) ==
+                    std::vector<graphs::PersistentIndex>{{1}, {3}});
+        }
+    }
+}
+
+namespace {
+/**
+ * Three chains of eight vertices, the first with a side chain of two, and a ring of five, with isolated vertices in
+ * between. The chains refill blanks, so that their vertices are scattered in reverse across the vertex collection.
+ */
+template<typename Graph>
+auto churnedChains() {
+    using Index = typename Graph::PersistentVertexIndex;
+    Graph graph;
+    for (std::size_t i = 0; i < 48; ++i) {
+        graph.addVertex(1000 + i);
+    }
+    for (std::size_t i = 0; i < 48; i += 2) {
+        graph.removeVertex(Index::of(i));
+    }
+    std::vector<std::vector<Index>> chains(4);
+    for (std::size_t c = 0; c < 3; ++c) {
+        for (std::size_t m = 0; m < 8; ++m) {
+            chains[c].push_back(graph.addVertex(100 * c + m));
+            if (m > 0) {
+                graph.addEdge(chains[c][m - 1], chains[c][m]);
+            }
+        }
+    }
+    auto side1 = graph.addVertex(50);
+    auto side2 = graph.addVertex(51);
+    graph.addEdge(chains[0][3], side1);
+    graph.addEdge(side1, side2);
+    for (std::size_t m = 0; m < 5; ++m) {
+        chains[3].push_back(graph.addVertex(400 + m));
+        if (m > 0) {
+            graph.addEdge(chains[3][m - 1], chains[3][m]);
+        }
+    }
+    graph.addEdge(chains[3][4], chains[3][0]);
+    return std::make_tuple(graph, chains);
+}
+
+template<typename Graph>
+void requireReordered(const Graph &before, const Graph &after,
+                      const std::vector<typename Graph::PersistentVertexIndex> &mapping) {
+    using Index = typename Graph::PersistentVertexIndex;
+    REQUIRE(after.nVertices() == before.nVertices());
+    REQUIRE(after.vertices().size_persistent() == before.nVertices());
+    REQUIRE(after.vertices().n_deactivated() == 0);
+    REQUIRE(mapping.size() == before.vertices().size_persistent());
+    std::vector<char> hit(after.nVertices(), false);
+    for (auto it = before.vertices().begin(); it != before.vertices().end(); ++it) {
+        auto ix = mapping[it.persistent_index().value];
+        REQUIRE(ix.value < after.nVertices());
+        REQUIRE(!hit[ix.value]);
+        hit[ix.value] = true;
+        const auto &vertex = after.vertices().at(ix);
+        REQUIRE(vertex.data() == it->data());
+        std::vector<Index> expected;
+        for (auto neighbor : it->neighbors()) {
+            expected.push_back(mapping[neighbor.value]);
+        }
+        if constexpr (Graph::SortedNeighbors) {
+            std::sort(expected.begin(), expected.end());
+        }
+        REQUIRE(std::equal(vertex.neighbors().begin(), vertex.neighbors().end(), expected.begin(), expected.end()));
+    }
+    REQUIRE(after.nEdges() == before.nEdges());
+    for (std::size_t i = 0; i < before.nEdges(); ++i) {
+        const auto &[ix1, ix2] = before.edges()[i];
+        REQUIRE(after.edges()[i] == std::make_tuple(mapping[ix1.value], mapping[ix2.value]));
+    }
+}
+
+template<typename Graph>
+void requireReorderedAll() {
+    for (auto strategy : {graphs::ReorderStrategy::bfs, graphs::ReorderStrategy::reverseCuthillMcKee,
+                          graphs::ReorderStrategy::chain}) {
+        auto [graph, chains] = churnedChains<Graph>();
+        auto before = graph;
+        auto mapping = graph.reorder(strategy);
+        requireReordered(before, graph, mapping);
+        REQUIRE(graph.isConnected() == before.isConnected());
+        REQUIRE(graph.connectedComponents().size() == before.connectedComponents().size());
+    }
+}
+
+template<typename Graph>
+std::size_t bandwidth(const Graph &graph) {
+    std::size_t result = 0;
+    for (auto it = graph.vertices().begin(); it != graph.vertices().end(); ++it) {
+        for (auto neighbor : it->neighbors()) {
+            auto ix = it.persistent_index().value;
+            result = std::max(result, ix > neighbor.value ? ix - neighbor.value : neighbor.value - ix);
+        }
+    }
+    return result;
+}
+}
+
+SCENARIO("Locality-improving vertex reordering", "[graphs]") {
+    GIVEN("Chains and a ring whose vertices were scattered by churn") {
+        auto [graph, chains] = churnedChains<graphs::DefaultGraph>();
+        auto before = graph;
+        WHEN("reordering it along the chains") {
+            auto mapping = graph.reorder(graphs::ReorderStrategy::chain);
+            THEN("the vertices of every chain are consecutive in memory") {
+                requireReordered(before, graph, mapping);
+                for (const auto &chain : chains) {
+                    for (std::size_t m = 1; m < chain.size(); ++m) {
+                        auto ix1 = mapping[chain[m - 1].value].value;
+                        auto ix2 = mapping[chain[m].value].value;
+                        REQUIRE((ix1 + 1 == ix2 || ix2 + 1 == ix1));
+                    }
+                }
+            }
+        }
+        WHEN("reordering it in reverse Cuthill-McKee order") {
+            auto mapping = graph.reorder(graphs::ReorderStrategy::reverseCuthillMcKee);
+            THEN("the band of the adjacency matrix narrows") {
+                requireReordered(before, graph, mapping);
+                REQUIRE(bandwidth(graph) < bandwidth(before));
+                REQUIRE(bandwidth(graph) <= 2);
+            }
+        }
+        WHEN("reordering it while journaling") {
+            graph.checkpoint();
+            THEN("it is refused") {
+                REQUIRE_THROWS_AS(graph.reorder(), std::logic_error);
+            }
+        }
+        WHEN("reordering it after a change marker") {
+            graph.mark();
+            auto snapshot = graph.snapshot();
+            snapshot.unmark();
+            graph.reorder(graphs::ReorderStrategy::bfs);
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            graph.writeDelta(ss);
+            snapshot.applyDelta(ss);
+            THEN("the delta reproduces the permutation") {
+                REQUIRE(snapshot.nVertices() == graph.nVertices());
+                for (auto it = graph.vertices().begin(); it != graph.vertices().end(); ++it) {
+                    const auto &vertex = snapshot.vertices().at(it.persistent_index());
+                    REQUIRE(!vertex.deactivated());
+                    REQUIRE(vertex.data() == it->data());
+                    std::vector<graphs::PersistentIndex> n1(vertex.neighbors().begin(), vertex.neighbors().end());
+                    std::vector<graphs::PersistentIndex> n2(it->neighbors().begin(), it->neighbors().end());
+                    std::sort(n1.begin(), n1.end());
+                    std::sort(n2.begin(), n2.end());
+                    REQUIRE(n1 == n2);
+                }
+            }
+        }
+    }
+    GIVEN("A 2d lattice with shuffled persistent indices") {
+        constexpr std::size_t width = 10;
+        std::vector<std::size_t> position(width * width);
+        std::iota(position.begin(), position.end(), 0);
+        std::shuffle(position.begin(), position.end(), std::mt19937(13));
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < width * width; ++i) {
+            graph.addVertex(i);
+        }
+        for (std::size_t i = 0; i < width * width; ++i) {
+            for (auto j : {i + 1, i + width}) {
+                if (j < width * width && (j == i + width || j % width != 0)) {
+                    graph.addEdge(graphs::PersistentIndex{position[i]}, graphs::PersistentIndex{position[j]});
+                }
+            }
+        }
+        WHEN("reordering it") {
+            auto rcm = graph;
+            rcm.reorder(graphs::ReorderStrategy::reverseCuthillMcKee);
+            auto bfs = graph;
+            bfs.reorder(graphs::ReorderStrategy::bfs);
+            THEN("reverse Cuthill-McKee yields a band of about the width of the lattice") {
+                REQUIRE(bandwidth(rcm) <= width + 1);
+                REQUIRE(bandwidth(bfs) < bandwidth(graph));
+                REQUIRE(rcm.graphDistance(graphs::PersistentIndex{0}, graphs::PersistentIndex{width * width - 1}) ==
+                        2 * (width - 1));
+            }
+        }
+    }
+    GIVEN("Other vertex layouts") {
+        THEN("the permutation is the same for sorted, columnar, copy-on-write, 32-bit and bounded graphs") {
+            requireReorderedAll<graphs::SortedGraph>();
+            requireReorderedAll<graphs::SoaGraph>();
+            requireReorderedAll<graphs::CowGraph>();
+            requireReorderedAll<graphs::Graph32>();
+            requireReorderedAll<graphs::BoundedGraph<4>>();
+        }
+    }
+}
+
+SCENARIO("Blank reuse policies of the vertex collection", "[graphs]") {
+    GIVEN("A chain of twenty vertices") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 20; ++i) {
+            graph.addVertex(i);
+            if (i > 0) {
+                graph.addEdge(graphs::PersistentIndex{i - 1}, graphs::PersistentIndex{i});
+            }
+        }
+        WHEN("removing vertices with lowestFirst") {
+            graph.vertices().set_blank_reuse(graphs::BlankReuse::lowestFirst);
+            for (std::size_t i : {3, 19, 18, 17}) {
+                graph.removeVertex(graphs::PersistentIndex{i});
+            }
+            THEN("the tail of the vertex collection is released and the lowest blank is refilled") {
+                REQUIRE(graph.vertices().size_persistent() == 17);
+                REQUIRE(graph.nVertices() == 16);
+                REQUIRE(graph.nEdges() == 14);
+                REQUIRE(graph.addVertex(100) == graphs::PersistentIndex{3});
+                REQUIRE(graph.addVertex(101) == graphs::PersistentIndex{17});
+            }
+        }
+        WHEN("adding vertices next to their future neighbors with nearest") {
+            graph.vertices().set_blank_reuse(graphs::BlankReuse::nearest);
+            for (std::size_t i : {2, 9, 15}) {
+                graph.removeVertex(graphs::PersistentIndex{i});
+            }
+            graph.checkpoint();
+            auto ix1 = graph.addVertex(100, graphs::PersistentIndex{10});
+            auto ix2 = graph.addVertex(101, graphs::PersistentIndex{1});
+            graph.addEdge(ix1, graphs::PersistentIndex{10});
+            THEN("the closest blanks are refilled and a rollback restores them") {
+                REQUIRE(ix1 == graphs::PersistentIndex{9});
+                REQUIRE(ix2 == graphs::PersistentIndex{2});
+                graph.rollback();
+                REQUIRE(graph.nVertices() == 17);
+                REQUIRE(graph.vertices().n_deactivated() == 3);
+                REQUIRE(graph.vertices().at(graphs::PersistentIndex{10}).neighbors().size() == 1);
+            }
+        }
+        WHEN("reordering a graph with lowestFirst") {
+            graph.vertices().set_blank_reuse(graphs::BlankReuse::lowestFirst);
+            graph.reorder();
+            graph.removeVertex(graphs::PersistentIndex{5});
+            graph.removeVertex(graphs::PersistentIndex{12});
+            THEN("the policy is kept and the lowest blank is refilled") {
+                REQUIRE(graph.vertices().blank_reuse() == graphs::BlankReuse::lowestFirst);
+                REQUIRE(graph.addVertex(100) == graphs::PersistentIndex{5});
+            }
+        }
+    }
+}
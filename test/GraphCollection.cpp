@@ -0,0 +1,115 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <map>
+#include <set>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+#include <graphs/GraphCollection.h>
+
+namespace {
+graphs::DefaultGraph chain(std::size_t n, std::size_t firstData = 0) {
+    graphs::DefaultGraph graph;
+    for (std::size_t i = 0; i < n; ++i) {
+        graph.addVertex(firstData + i);
+        if (i > 0) {
+            graph.addEdge(graphs::PersistentIndex{i - 1}, graphs::PersistentIndex{i});
+        }
+    }
+    return graph;
+}
+}
+
+SCENARIO("Collections of many small graphs", "[collection]") {
+    GIVEN("A collection with a chain, a triangle and a graph with two components") {
+        graphs::GraphCollection<graphs::DefaultGraph> collection;
+        auto chainId = collection.add(chain(4));
+
+        graphs::DefaultGraph triangle;
+        auto a = triangle.addVertex(10);
+        auto b = triangle.addVertex(11);
+        auto c = triangle.addVertex(12);
+        triangle.addEdge(a, b);
+        triangle.addEdge(b, c);
+        triangle.addEdge(c, a);
+        auto triangleId = collection.add(triangle);
+
+        auto twoComponents = chain(5, 20);
+        twoComponents.removeVertex(graphs::PersistentIndex{2});
+        auto twoComponentsId = collection.add(twoComponents);
+
+        THEN("graphs are addressed by id and local vertex index") {
+            REQUIRE(collection.nGraphs() == 3);
+            REQUIRE(collection.nVertices(chainId) == 4);
+            REQUIRE(collection.nEdges(triangleId) == 3);
+            REQUIRE(collection.nVertices(twoComponentsId) == 4);
+            REQUIRE(collection.data(triangleId, {2}) == 12);
+            // the removed vertex is skipped, local indices are renumbered
+            REQUIRE(collection.data(twoComponentsId, {2}) == 23);
+            REQUIRE(collection.neighbors(chainId, {1}).size() == 2);
+            REQUIRE(collection.neighbors(twoComponentsId, {1}).size() == 1);
+        }
+        THEN("graphs can be reconstructed") {
+            auto reconstructed = collection.graph(triangleId);
+            REQUIRE(reconstructed.nVertices() == 3);
+            REQUIRE(reconstructed.nEdges() == 3);
+            REQUIRE(reconstructed.isConnected());
+            auto components = collection.graph(twoComponentsId).connectedComponents();
+            REQUIRE(components.size() == 2);
+        }
+        THEN("n-tuples are found for all graphs at once, consistent with the single graphs") {
+            std::map<std::size_t, std::array<std::size_t, 3>> counts;
+            collection.findNTuples([&](auto id, const auto &) { ++counts[id.value][0]; },
+                                   [&](auto id, const auto &) { ++counts[id.value][1]; },
+                                   [&](auto id, const auto &) { ++counts[id.value][2]; });
+            for (auto id : collection.graphIds()) {
+                auto [pairs, triples, quadruples] = collection.graph(id).findNTuples();
+                REQUIRE(counts[id.value][0] == pairs.size());
+                REQUIRE(counts[id.value][1] == triples.size());
+                REQUIRE(counts[id.value][2] == quadruples.size());
+            }
+        }
+        THEN("component labels are unique across the collection") {
+            auto labels = collection.componentLabels();
+            auto label = [&](auto id, std::size_t v) { return labels[collection.vertexOffset(id) + v]; };
+            REQUIRE(label(chainId, 0) == label(chainId, 3));
+            REQUIRE(label(triangleId, 0) == label(triangleId, 2));
+            REQUIRE(label(chainId, 0) != label(triangleId, 0));
+            REQUIRE(label(twoComponentsId, 0) == label(twoComponentsId, 1));
+            REQUIRE(label(twoComponentsId, 2) == label(twoComponentsId, 3));
+            REQUIRE(label(twoComponentsId, 1) != label(twoComponentsId, 2));
+            std::set<std::size_t> distinct(labels.begin(), labels.end());
+            REQUIRE(distinct.size() == 4);
+        }
+        WHEN("removing graphs") {
+            collection.remove(chainId);
+            THEN("the other graphs keep their ids and contents") {
+                REQUIRE(collection.nGraphs() == 2);
+                REQUIRE(collection.vertexPoolSize() == 11);
+                REQUIRE(collection.data(triangleId, {0}) == 10);
+                REQUIRE_THROWS_AS(collection.nVertices(chainId), std::invalid_argument);
+            }
+            AND_WHEN("removing enough graphs to trigger compaction") {
+                collection.remove(twoComponentsId);
+                THEN("the pools shrink to the remaining graphs") {
+                    REQUIRE(collection.vertexPoolSize() == 3);
+                    REQUIRE(collection.nEdges(triangleId) == 3);
+                    REQUIRE(collection.data(triangleId, {1}) == 11);
+                    REQUIRE(collection.graph(triangleId).isConnected());
+                    auto labels = collection.componentLabels();
+                    REQUIRE(labels == std::vector<std::size_t>{0, 0, 0});
+                }
+                AND_WHEN("adding a graph again") {
+                    auto id = collection.add(chain(2, 30));
+                    THEN("it reuses a free id") {
+                        REQUIRE(collection.nGraphs() == 2);
+                        REQUIRE((id == chainId || id == twoComponentsId));
+                        REQUIRE(collection.data(id, {1}) == 31);
+                    }
+                }
+            }
+        }
+    }
+}
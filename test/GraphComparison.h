@@ -0,0 +1,73 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+namespace test {
+
+/**
+ * Requires two graphs, possibly of different vertex layouts, to have the same slots, vertex data, neighbors and edges.
+ */
+template<typename Graph1, typename Graph2>
+void requireSameGraph(const Graph1 &g1, const Graph2 &g2) {
+    REQUIRE(g1.vertices().size_persistent() == g2.vertices().size_persistent());
+    REQUIRE(g1.nVertices() == g2.nVertices());
+    REQUIRE(g1.edges().size() == g2.edges().size());
+    REQUIRE(std::equal(g1.edges().begin(), g1.edges().end(), g2.edges().begin()));
+    for (std::size_t i = 0; i < g1.vertices().size_persistent(); ++i) {
+        auto v1 = g1.vertices().begin_persistent() + i;
+        auto v2 = g2.vertices().begin_persistent() + i;
+        REQUIRE(v1->deactivated() == v2->deactivated());
+        if (!v1->deactivated()) {
+            REQUIRE(v1->data() == v2->data());
+            REQUIRE(std::equal(v1->neighbors().begin(), v1->neighbors().end(),
+                               v2->neighbors().begin(), v2->neighbors().end()));
+        }
+    }
+}
+
+/**
+ * Requires a graph and its reference in another layout to give the same results in the graph algorithms.
+ */
+template<typename Graph1, typename Graph2>
+void requireSameResults(const Graph1 &graph, const Graph2 &reference, graphs::PersistentIndex from,
+                        graphs::PersistentIndex to) {
+    REQUIRE(graph.isConnected() == reference.isConnected());
+    REQUIRE(graph.connectedComponents().size() == reference.connectedComponents().size());
+    REQUIRE(graph.findNTuples() == reference.findNTuples());
+    REQUIRE(graph.graphDistance(from, to) == reference.graphDistance(from, to));
+}
+
+/**
+ * Requires a rollback over added and removed vertices and edges to restore the graph to its reference.
+ */
+template<typename Graph1, typename Graph2>
+void requireRollbackRestores(Graph1 &graph, const Graph2 &reference) {
+    graph.checkpoint();
+    auto v = graph.addVertex(100);
+    graph.addEdge(v, graphs::PersistentIndex{0});
+    graph.removeVertex(graphs::PersistentIndex{1});
+    graph.rollback();
+    requireSameGraph(graph, reference);
+}
+
+/**
+ * Requires a graph written in the binary format to be read back as `Read` equal to its reference.
+ */
+template<typename Read, typename Graph1, typename Graph2>
+void requireSameAfterReading(const Graph1 &graph, const Graph2 &reference) {
+    std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    graph.write(ss);
+    auto copy = Read::read(ss);
+    requireSameGraph(copy, reference);
+}
+
+}
@@ -0,0 +1,174 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <utility>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+#include <graphs/Import.h>
+
+namespace {
+std::string temporaryPath(const std::string &name) {
+    return std::string(P_tmpdir) + "/graphs_test_" + name + "_" + std::to_string(std::rand());
+}
+
+template<typename Graph>
+std::set<std::pair<std::size_t, std::size_t>> edgeSet(const Graph &graph) {
+    std::set<std::pair<std::size_t, std::size_t>> edges;
+    for (const auto &[ix1, ix2] : graph.edges()) {
+        edges.emplace(std::min(ix1.value, ix2.value), std::max(ix1.value, ix2.value));
+    }
+    return edges;
+}
+}
+
+SCENARIO("Importing edge lists", "[import]") {
+    GIVEN("An edge list with comments, extra columns, duplicates and a self-loop") {
+        std::string text = "# a comment\n"
+                           "% another comment\n"
+                           "0 1\n"
+                           "\n"
+                           "1\t2 0.5\n"
+                           "2,0\r\n"
+                           "1 0\n"
+                           "3 3\n"
+                           "5 2";
+        WHEN("parsing it") {
+            auto graph = graphs::io::parseEdgeList<graphs::DefaultGraph>(text);
+            THEN("there is one vertex per id up to the largest one and the edges are undirected and unique") {
+                REQUIRE(graph.vertices().size() == 6);
+                REQUIRE(edgeSet(graph) == std::set<std::pair<std::size_t, std::size_t>>{{0, 1}, {1, 2}, {0, 2},
+                                                                                         {2, 5}});
+                REQUIRE(graph.nEdges() == 4);
+                REQUIRE(graph.vertices().at(graphs::PersistentIndex{2}).neighbors().size() == 3);
+                REQUIRE(graph.vertices().at(graphs::PersistentIndex{4}).neighbors().empty());
+            }
+        }
+        WHEN("parsing it in parallel") {
+            graphs::ThreadPool pool(3);
+            auto graph = graphs::io::parseEdgeList<graphs::DefaultGraph>(pool, text);
+            THEN("the result is the same") {
+                REQUIRE(edgeSet(graph) == edgeSet(graphs::io::parseEdgeList<graphs::DefaultGraph>(text)));
+            }
+        }
+        WHEN("parsing it into a graph with 32-bit indices") {
+            auto graph = graphs::io::parseEdgeList<graphs::Graph32>(text);
+            THEN("the result is the same") {
+                REQUIRE(edgeSet(graph) == edgeSet(graphs::io::parseEdgeList<graphs::DefaultGraph>(text)));
+            }
+        }
+    }
+    GIVEN("A large edge list in a file") {
+        graphs::DefaultGraph expected;
+        auto path = temporaryPath("edgelist");
+        {
+            std::ofstream os(path);
+            os << "# ring with chords\n";
+            std::size_t n = 20000;
+            for (std::size_t i = 0; i < n; ++i) {
+                expected.addVertex(0);
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                os << i << " " << (i + 1) % n << "\n";
+                os << (i * 7919) % n << " " << i << "\n";
+                expected.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{(i + 1) % n});
+                if ((i * 7919) % n != i) {
+                    expected.addEdge(graphs::PersistentIndex{(i * 7919) % n}, graphs::PersistentIndex{i});
+                }
+            }
+        }
+        WHEN("reading it in parallel and sequentially") {
+            graphs::ThreadPool pool(4);
+            auto parallel = graphs::io::readEdgeList<graphs::DefaultGraph>(pool, path);
+            auto sequential = graphs::io::readEdgeList<graphs::PmrGraph>(path);
+            THEN("both match the graph built edge by edge") {
+                REQUIRE(parallel.vertices().size() == expected.vertices().size());
+                REQUIRE(edgeSet(parallel) == edgeSet(expected));
+                REQUIRE(edgeSet(sequential) == edgeSet(expected));
+                for (std::size_t i = 0; i < expected.vertices().size(); ++i) {
+                    graphs::PersistentIndex ix {i};
+                    REQUIRE(parallel.vertices().at(ix).neighbors().size() ==
+                            expected.vertices().at(ix).neighbors().size());
+                }
+            }
+        }
+        std::remove(path.c_str());
+    }
+    GIVEN("Malformed edge lists") {
+        THEN("parsing reports the offset") {
+            REQUIRE_THROWS_WITH(graphs::io::parseEdgeList<graphs::DefaultGraph>("0 1\n2 x\n"),
+                                "Invalid edge list at byte 6.");
+            REQUIRE_THROWS_AS(graphs::io::parseEdgeList<graphs::DefaultGraph>("0 1\n-2 3\n"), std::runtime_error);
+            REQUIRE_THROWS_AS(graphs::io::parseEdgeList<graphs::DefaultGraph>("0 1a\n"), std::runtime_error);
+            REQUIRE_THROWS_AS(graphs::io::parseEdgeList<graphs::DefaultGraph>("7\n"), std::runtime_error);
+        }
+        THEN("ids whose number of slots does not fit the index type are rejected") {
+            REQUIRE_THROWS_WITH(graphs::io::parseEdgeList<graphs::DefaultGraph>("0 18446744073709551615\n"),
+                                "Invalid edge list at byte 2.");
+            REQUIRE_THROWS_AS(graphs::io::parseEdgeList<graphs::Graph32>("0 4294967295\n"), std::runtime_error);
+        }
+        THEN("missing files are reported") {
+            REQUIRE_THROWS_AS(graphs::io::readEdgeList<graphs::DefaultGraph>(temporaryPath("missing")),
+                              std::system_error);
+        }
+    }
+    GIVEN("An empty edge list") {
+        THEN("the graph is empty") {
+            REQUIRE(graphs::io::parseEdgeList<graphs::DefaultGraph>("").vertices().empty());
+            graphs::ThreadPool pool(2);
+            REQUIRE(graphs::io::parseEdgeList<graphs::DefaultGraph>(pool, "# nothing\n").vertices().empty());
+        }
+    }
+}
+
+SCENARIO("Importing GEXF", "[import]") {
+    GIVEN("An exported graph with blanks") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 6; ++i) {
+            graph.addVertex(i);
+        }
+        graph.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{1});
+        graph.addEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{2});
+        graph.addEdge(graphs::PersistentIndex{2}, graphs::PersistentIndex{5});
+        graph.addEdge(graphs::PersistentIndex{3}, graphs::PersistentIndex{5});
+        graph.removeVertex(graphs::PersistentIndex{1});
+        graph.removeVertex(graphs::PersistentIndex{4});
+        auto path = temporaryPath("gexf");
+        {
+            std::ofstream os(path);
+            graphs::exportGraph(graph, os, graphs::ExportFormat::gexf, {true});
+        }
+        WHEN("reading it back") {
+            auto imported = graphs::io::readGexf<graphs::DefaultGraph>(path);
+            THEN("the topology and the persistent indices are restored") {
+                REQUIRE(imported.vertices().size() == graph.vertices().size());
+                REQUIRE(imported.vertices().size_persistent() == graph.vertices().size_persistent());
+                REQUIRE(imported.vertices().n_deactivated() == 2);
+                REQUIRE_THROWS(imported.vertices().at(graphs::PersistentIndex{1}));
+                REQUIRE_THROWS(imported.vertices().at(graphs::PersistentIndex{4}));
+                REQUIRE(edgeSet(imported) == edgeSet(graph));
+            }
+        }
+        std::remove(path.c_str());
+    }
+    GIVEN("Malformed documents") {
+        THEN("they are rejected") {
+            REQUIRE_THROWS_AS(graphs::io::parseGexf<graphs::DefaultGraph>(
+                    R"(<graph><nodes><node id="0" /></nodes><edges><edge source="0" target="2" /></edges></graph>)"),
+                              std::runtime_error);
+            REQUIRE_THROWS_AS(graphs::io::parseGexf<graphs::DefaultGraph>(
+                    R"(<graph><nodes><node id="a" /></nodes></graph>)"), std::runtime_error);
+            REQUIRE_THROWS_AS(graphs::io::parseGexf<graphs::DefaultGraph>(R"(<graph><nodes><node id="0")"),
+                              std::runtime_error);
+        }
+        THEN("node ids whose number of slots does not fit the index type are rejected") {
+            REQUIRE_THROWS_AS(graphs::io::parseGexf<graphs::DefaultGraph>(
+                    R"(<graph><nodes><node id="18446744073709551615" /></nodes></graph>)"), std::runtime_error);
+        }
+    }
+}
@@ -4,6 +4,7 @@
 
 #include <catch2/catch.hpp>
 #include <graphs/IndexPersistentVector.h>
+#include <random>
 #include <set>
 
 class A {
@@ -276,3 +277,311 @@ SCENARIO("Test ipv active iterator", "[ipv]") {
         }
     }
 }
+
+SCENARIO("Test ipv journal", "[ipv]") {
+    GIVEN("A IPV with five elements of which one is erased") {
+        graphs::IndexPersistentVector<A> v;
+        for (auto x : {5, 1, 7, 8, 3}) {
+            v.push_back(A(x));
+        }
+        v.erase(v.begin() + 1);
+        auto original = v;
+        auto requireOriginal = [&original, &v]() {
+            REQUIRE(v.size_persistent() == original.size_persistent());
+            REQUIRE(v.size() == original.size());
+            REQUIRE(std::equal(v.begin(), v.end(), original.begin()));
+            for (std::size_t i = 0; i < v.size_persistent(); ++i) {
+                REQUIRE((v.begin_persistent() + i)->deactivated() == (original.begin_persistent() + i)->deactivated());
+            }
+        };
+        WHEN("inserting and erasing after a checkpoint") {
+            v.checkpoint();
+            v.push_back(A(10));
+            v.push_back(A(11));
+            v.emplace_back(12);
+            v.erase(v.begin());
+            v.erase(v.begin_persistent() + 3);
+            REQUIRE(v.size() == 5);
+            THEN("rolling back restores the original state") {
+                v.rollback();
+                REQUIRE_FALSE(v.journaling());
+                requireOriginal();
+            }
+            THEN("committing keeps the changes and clears the journal") {
+                v.commit();
+                REQUIRE(v.journal_size() == 0);
+                REQUIRE(v.size() == 5);
+            }
+            THEN("clearing is refused") {
+                REQUIRE_THROWS_AS(v.clear(), std::logic_error);
+            }
+        }
+        WHEN("emplacing at given persistent indices after a checkpoint") {
+            v.checkpoint();
+            std::set<std::size_t> journaled;
+            v.emplace_persistent({1}, 20);
+            v.emplace_persistent({8}, 21);
+            v.for_each_journaled([&journaled](auto ix) { journaled.insert(ix.value); });
+            THEN("a blank is reused and the slots up to a later index become blanks") {
+                REQUIRE(v.at(graphs::PersistentIndex{1}).val() == 20);
+                REQUIRE(v.at(graphs::PersistentIndex{8}).val() == 21);
+                REQUIRE(v.size_persistent() == 9);
+                REQUIRE(v.size() == 6);
+                REQUIRE(v.n_deactivated() == 3);
+                REQUIRE(journaled == std::set<std::size_t>{1, 5, 6, 7, 8});
+                REQUIRE_THROWS_AS(v.emplace_persistent({0}, 22), std::invalid_argument);
+            }
+            THEN("rolling back restores the original state") {
+                v.rollback();
+                requireOriginal();
+            }
+        }
+    }
+}
+
+SCENARIO("Test ipv append", "[ipv]") {
+    GIVEN("Two IPVs with blanks") {
+        graphs::IndexPersistentVector<A> v;
+        graphs::IndexPersistentVector<A> w;
+        for (auto x : {5, 1, 7}) {
+            v.push_back(A(x));
+            w.push_back(A(10 * x));
+        }
+        v.erase(v.begin_persistent() + 1);
+        w.erase(w.begin_persistent());
+        auto original = v;
+        WHEN("appending one to the other") {
+            auto offset = v.append(w);
+            THEN("the slots of the other follow the slots of this one and its blanks stay blanks") {
+                REQUIRE(offset == 3);
+                REQUIRE(v.size_persistent() == 6);
+                REQUIRE(v.size() == 4);
+                REQUIRE(v.n_deactivated() == 2);
+                REQUIRE(v.at(graphs::PersistentIndex{4}).val() == 10);
+                REQUIRE(v.at(graphs::PersistentIndex{5}).val() == 70);
+                REQUIRE((v.begin_persistent() + 3)->deactivated());
+                v.emplace_back(2);
+                v.emplace_back(3);
+                REQUIRE(v.at(graphs::PersistentIndex{3}).val() == 2);
+                REQUIRE(v.at(graphs::PersistentIndex{1}).val() == 3);
+            }
+        }
+        WHEN("appending it to itself") {
+            v.append(v);
+            THEN("it contains its slots twice") {
+                REQUIRE(v.size_persistent() == 6);
+                REQUIRE(v.n_deactivated() == 2);
+                REQUIRE(v.at(graphs::PersistentIndex{5}).val() == 7);
+            }
+        }
+        WHEN("appending after a checkpoint") {
+            v.checkpoint();
+            v.append(w);
+            v.rollback();
+            THEN("rolling back restores the original state") {
+                REQUIRE(v.size_persistent() == original.size_persistent());
+                REQUIRE(v.n_deactivated() == original.n_deactivated());
+                REQUIRE(std::equal(v.begin(), v.end(), original.begin()));
+            }
+        }
+    }
+    GIVEN("IPVs of trivially copyable elements") {
+        struct B {
+            int x;
+            bool inactive;
+            void deactivate() { inactive = true; }
+            [[nodiscard]] bool deactivated() const { return inactive; }
+        };
+        static_assert(std::is_trivially_copyable_v<B>);
+        graphs::IndexPersistentVector<B> v;
+        for (int x = 0; x < 10; ++x) {
+            v.push_back(B{x, false});
+        }
+        v.erase(v.begin_persistent() + 2);
+        THEN("appending copies all slots at once") {
+            v.append(v);
+            REQUIRE(v.size_persistent() == 20);
+            REQUIRE(v.n_deactivated() == 2);
+            REQUIRE(v.at(graphs::PersistentIndex{19}).x == 9);
+            REQUIRE((v.begin_persistent() + 12)->deactivated());
+        }
+    }
+}
+
+SCENARIO("Test ipv shrink to fit", "[ipv]") {
+    GIVEN("A IPV with six elements of which the last two and one in the middle are erased") {
+        graphs::IndexPersistentVector<A> v;
+        v.reserve(64);
+        for (auto x : {5, 1, 7, 8, 3, 4}) {
+            v.push_back(A(x));
+        }
+        v.erase(v.begin_persistent() + 1);
+        v.erase(v.begin_persistent() + 4);
+        v.erase(v.begin_persistent() + 5);
+        WHEN("shrinking") {
+            v.shrink_to_fit();
+            THEN("the trailing blanks are dropped and the capacity is trimmed") {
+                REQUIRE(v.size_persistent() == 4);
+                REQUIRE(v.n_deactivated() == 1);
+                REQUIRE(v.capacity_persistent() == 4);
+                REQUIRE(v.unused_memory_deactivated() == 0);
+                REQUIRE((v.begin_persistent() + 3)->val() == 8);
+                REQUIRE(v.size() == 3);
+            }
+            AND_WHEN("inserting again") {
+                v.emplace_back(9);
+                v.emplace_back(10);
+                THEN("the remaining blank is reused first") {
+                    REQUIRE((v.begin_persistent() + 1)->val() == 9);
+                    REQUIRE((v.begin_persistent() + 4)->val() == 10);
+                }
+            }
+        }
+        WHEN("journaling") {
+            v.checkpoint();
+            THEN("shrinking is refused") {
+                REQUIRE_THROWS_AS(v.shrink_to_fit(), std::logic_error);
+            }
+        }
+    }
+}
+
+SCENARIO("Test ipv blank reuse policies", "[ipv]") {
+    GIVEN("A IPV with ten elements of which the ones at 7, 2 and 5 are erased in this order") {
+        auto make = [](graphs::BlankReuse policy) {
+            graphs::IndexPersistentVector<A> v;
+            v.set_blank_reuse(policy);
+            for (int x = 0; x < 10; ++x) {
+                v.push_back(A(x));
+            }
+            for (std::size_t i : {7, 2, 5}) {
+                v.erase(v.begin_persistent() + i);
+            }
+            return v;
+        };
+        auto refilled = [](graphs::IndexPersistentVector<A> &v) {
+            std::vector<std::size_t> indices;
+            while (v.n_deactivated() > 0) {
+                indices.push_back(v.emplace_back(100).value);
+            }
+            return indices;
+        };
+        THEN("the largest blank is refilled first by default") {
+            auto v = make(graphs::BlankReuse::largestFirst);
+            REQUIRE(v.blank_reuse() == graphs::BlankReuse::largestFirst);
+            REQUIRE(refilled(v) == std::vector<std::size_t>{7, 5, 2});
+        }
+        THEN("the lowest blank is refilled first with lowestFirst") {
+            auto v = make(graphs::BlankReuse::lowestFirst);
+            REQUIRE(refilled(v) == std::vector<std::size_t>{2, 5, 7});
+        }
+        THEN("blanks are refilled in the order of erasure with fifo") {
+            auto v = make(graphs::BlankReuse::fifo);
+            REQUIRE(refilled(v) == std::vector<std::size_t>{7, 2, 5});
+        }
+        THEN("a blank which is refilled and erased again is queued behind the others with fifo") {
+            auto v = make(graphs::BlankReuse::fifo);
+            v.emplace_persistent(graphs::PersistentIndex{2}, 100);
+            v.erase(v.begin_persistent() + 2);
+            REQUIRE(refilled(v) == std::vector<std::size_t>{7, 5, 2});
+        }
+        THEN("the blank closest to the hint or to the previous insertion is refilled with nearest") {
+            auto v = make(graphs::BlankReuse::nearest);
+            REQUIRE(v.emplace_near(graphs::PersistentIndex{4}, 100).value == 5);
+            REQUIRE(v.emplace_near(graphs::PersistentIndex{0}, 101).value == 2);
+            v.erase(v.begin_persistent() + 3);
+            // the previous insertion was at 2
+            REQUIRE(v.emplace_back(102).value == 3);
+            REQUIRE(v.emplace_near(graphs::PersistentIndex{20}, 103).value == 7);
+            REQUIRE(v.emplace_back(104).value == 10);
+        }
+        WHEN("erasing the last elements with lowestFirst") {
+            auto v = make(graphs::BlankReuse::lowestFirst);
+            v.erase(v.begin_persistent() + 9);
+            REQUIRE(v.size_persistent() == 9);
+            v.erase(v.begin_persistent() + 8);
+            THEN("the blanks at the end are dropped") {
+                REQUIRE(v.size_persistent() == 7);
+                REQUIRE(v.n_deactivated() == 2);
+                REQUIRE(v.size() == 5);
+                REQUIRE(std::distance(v.begin(), v.end()) == 5);
+                REQUIRE(v.emplace_back(100).value == 2);
+            }
+        }
+        WHEN("erasing the last element with lowestFirst after a checkpoint") {
+            auto v = make(graphs::BlankReuse::lowestFirst);
+            v.checkpoint();
+            v.erase(v.begin_persistent() + 9);
+            v.emplace_back(100);
+            THEN("the blanks are kept until the checkpoint is closed") {
+                REQUIRE(v.size_persistent() == 10);
+                v.rollback();
+                REQUIRE(v.size_persistent() == 10);
+                REQUIRE(v.n_deactivated() == 3);
+                REQUIRE(v.at(graphs::PersistentIndex{9}).val() == 9);
+            }
+            THEN("committing drops them") {
+                v.commit();
+                REQUIRE(v.size_persistent() == 9);
+            }
+        }
+        WHEN("switching an existing IPV to fifo and to lowestFirst") {
+            auto v = make(graphs::BlankReuse::largestFirst);
+            v.erase(v.begin_persistent() + 9);
+            v.set_blank_reuse(graphs::BlankReuse::fifo);
+            v.erase(v.begin_persistent() + 0);
+            auto copy = v;
+            THEN("existing blanks are queued by index, copies keep the queue") {
+                REQUIRE(refilled(v) == std::vector<std::size_t>{2, 5, 7, 9, 0});
+                REQUIRE(refilled(copy) == std::vector<std::size_t>{2, 5, 7, 9, 0});
+            }
+            THEN("switching to lowestFirst drops the trailing blank") {
+                v.set_blank_reuse(graphs::BlankReuse::lowestFirst);
+                REQUIRE(v.size_persistent() == 9);
+                REQUIRE(refilled(v) == std::vector<std::size_t>{0, 2, 5, 7});
+            }
+        }
+    }
+    GIVEN("Random insertions and erasures") {
+        for (auto policy : {graphs::BlankReuse::largestFirst, graphs::BlankReuse::lowestFirst,
+                            graphs::BlankReuse::nearest, graphs::BlankReuse::fifo}) {
+            graphs::IndexPersistentVector<A> v;
+            v.set_blank_reuse(policy);
+            std::mt19937 rng(7);
+            std::multiset<int> elements;
+            for (int i = 0; i < 2000; ++i) {
+                if (elements.empty() || rng() % 5 < 2) {
+                    std::set<std::size_t> blanks;
+                    for (std::size_t j = 0; j < v.size_persistent(); ++j) {
+                        if ((v.begin_persistent() + j)->deactivated()) {
+                            blanks.insert(j);
+                        }
+                    }
+                    auto ix = v.emplace_near(graphs::PersistentIndex{rng() % 64}, i);
+                    REQUIRE((blanks.empty() ? ix.value == v.size_persistent() - 1 : blanks.count(ix.value) == 1));
+                    elements.insert(i);
+                } else {
+                    auto it = v.begin() + rng() % v.size();
+                    elements.erase(elements.find(it->val()));
+                    v.erase(it);
+                }
+                if (i % 100 == 0) {
+                    v.checkpoint();
+                    v.erase(v.begin());
+                    v.emplace_back(-1);
+                    v.rollback();
+                }
+                REQUIRE(v.size() == elements.size());
+                REQUIRE(v.size() + v.n_deactivated() == v.size_persistent());
+                std::multiset<int> active;
+                for (const auto &a : v) {
+                    active.insert(a.val());
+                }
+                REQUIRE(active == elements);
+            }
+            if (policy == graphs::BlankReuse::lowestFirst) {
+                REQUIRE(!(v.begin_persistent() + v.size_persistent() - 1)->deactivated());
+            }
+        }
+    }
+}
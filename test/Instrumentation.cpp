@@ -0,0 +1,89 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+using CountingGraph = graphs::Graph<graphs::IndexPersistentVector, graphs::DefaultVertex,
+                                    graphs::CountingInstrumentation<>>;
+using TimingGraph = graphs::Graph<graphs::IndexPersistentVector, graphs::DefaultVertex, graphs::TimingInstrumentation>;
+
+static_assert(std::is_empty_v<graphs::NoInstrumentation>);
+
+SCENARIO("Graph instrumentation", "[instrumentation]") {
+    GIVEN("An uninstrumented graph") {
+        graphs::DefaultGraph graph;
+        graph.addEdge(graph.addVertex(), graph.addVertex());
+        REQUIRE(graph.isConnected());
+        THEN("all counters are zero") {
+            auto stats = graph.stats();
+            REQUIRE(stats.nCalls(graphs::Operation::addVertex) == 0);
+            REQUIRE(stats.count(graphs::Counter::bfsPasses) == 0);
+        }
+    }
+    GIVEN("A counting chain graph of five vertices") {
+        CountingGraph graph;
+        std::vector<graphs::PersistentIndex> vertices;
+        for (std::size_t i = 0; i < 5; ++i) {
+            vertices.push_back(graph.addVertex(i));
+        }
+        for (std::size_t i = 1; i < 5; ++i) {
+            graph.addEdge(vertices[i - 1], vertices[i]);
+        }
+        THEN("calls are counted once per public operation") {
+            auto stats = graph.stats();
+            REQUIRE(stats.nCalls(graphs::Operation::addVertex) == 5);
+            REQUIRE(stats.nCalls(graphs::Operation::addEdge) == 4);
+            REQUIRE(stats.time(graphs::Operation::addEdge).count() == 0);
+        }
+        WHEN("running traversals and edge lookups") {
+            graph.resetStats();
+            REQUIRE(graph.isConnected());
+            REQUIRE(graph.graphDistance(vertices[0], vertices[4]) == 4);
+            REQUIRE(graph.containsEdge(vertices[3], vertices[4]));
+            REQUIRE(!graph.containsEdge(vertices[0], vertices[4]));
+            THEN("passes, visited vertices and scanned edges are counted") {
+                auto stats = graph.stats();
+                REQUIRE(stats.count(graphs::Counter::bfsPasses) == 2);
+                REQUIRE(stats.count(graphs::Counter::visitedVertices) == 5 + 5);
+                // hit in the last edge, miss scans all edges once for both orientations
+                REQUIRE(stats.count(graphs::Counter::edgeListScans) == 2);
+                REQUIRE(stats.count(graphs::Counter::scannedEdges) == 4 + 4);
+                REQUIRE(stats.nCalls(graphs::Operation::containsEdge) == 2);
+            }
+        }
+        WHEN("removing vertices and iterating over the blanks") {
+            graph.removeVertex(vertices[1]);
+            graph.removeVertex(vertices[3]);
+            graph.resetStats();
+            auto components = graph.connectedComponents();
+            THEN("components and skipped blanks are counted") {
+                REQUIRE(components.size() == 3);
+                auto stats = graph.stats();
+                REQUIRE(stats.count(graphs::Counter::bfsPasses) == 3);
+                REQUIRE(stats.count(graphs::Counter::skippedBlanks) == 2);
+            }
+            AND_WHEN("copying the graph") {
+                auto copy = graph;
+                copy.resetStats();
+                THEN("the counters are copied, but independent") {
+                    REQUIRE(graph.stats().nCalls(graphs::Operation::connectedComponents) == 1);
+                    REQUIRE(copy.stats().nCalls(graphs::Operation::connectedComponents) == 0);
+                }
+            }
+        }
+    }
+    GIVEN("A timing graph") {
+        TimingGraph graph;
+        for (std::size_t i = 0; i < 100; ++i) {
+            graph.addVertex(i);
+        }
+        graph.gexf();
+        THEN("time is accumulated per operation") {
+            auto stats = graph.stats();
+            REQUIRE(stats.nCalls(graphs::Operation::gexf) == 1);
+            REQUIRE(stats.time(graphs::Operation::gexf).count() > 0);
+        }
+    }
+}
@@ -0,0 +1,167 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+#include <graphs/MappedGraph.h>
+
+namespace {
+std::string temporaryPath(const std::string &name) {
+    return std::string(P_tmpdir) + "/graphs_test_" + name + "_" + std::to_string(std::rand());
+}
+}
+
+SCENARIO("Memory mapped graphs", "[mapped]") {
+    GIVEN("A graph with blanks and two connected components, stored in a file") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 12; ++i) {
+            graph.addVertex(100 + i);
+        }
+        // ring 0 - 1 - ... - 7 - 0 and chain 8 - 9 - 10 - 11
+        for (std::size_t i = 0; i < 8; ++i) {
+            graph.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{(i + 1) % 8});
+        }
+        for (std::size_t i = 8; i < 11; ++i) {
+            graph.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{i + 1});
+        }
+        graph.removeVertex(graphs::PersistentIndex{4});
+
+        auto path = temporaryPath("mapped");
+        {
+            std::ofstream os(path, std::ios_base::out | std::ios_base::binary);
+            graphs::MappedGraph<graphs::DefaultGraph>::write(graph, os);
+        }
+
+        WHEN("mapping it") {
+            graphs::MappedGraph<graphs::DefaultGraph> mapped(path);
+            THEN("sizes, activity and the persistent index map match the graph") {
+                REQUIRE(mapped.size_persistent() == 12);
+                REQUIRE(mapped.nVertices() == 11);
+                REQUIRE(mapped.nEdges() == graph.nEdges());
+                REQUIRE(!mapped.active(graphs::PersistentIndex{4}));
+                REQUIRE(!mapped.active(graphs::PersistentIndex{12}));
+                std::size_t activeIndex = 0;
+                for (auto it = graph.begin(); it != graph.end(); ++it, ++activeIndex) {
+                    REQUIRE(mapped.persistentIndex(activeIndex) == it.persistent_index());
+                }
+                REQUIRE_THROWS_AS(mapped.persistentIndex(11), std::out_of_range);
+            }
+            THEN("neighbors and data are read in place") {
+                for (std::size_t i = 0; i < 12; ++i) {
+                    graphs::PersistentIndex ix {i};
+                    if (mapped.active(ix)) {
+                        const auto &vertex = graph.vertices().at(ix);
+                        REQUIRE(mapped.data(ix) == vertex.data());
+                        auto neighbors = mapped.neighbors(ix);
+                        REQUIRE(std::equal(neighbors.begin(), neighbors.end(), vertex.neighbors().begin(),
+                                           vertex.neighbors().end()));
+                    } else {
+                        REQUIRE(mapped.neighbors(ix).empty());
+                    }
+                }
+            }
+            THEN("graph distances match the graph") {
+                for (std::size_t i = 0; i < 12; ++i) {
+                    for (std::size_t j = 0; j < 12; ++j) {
+                        graphs::PersistentIndex ix1 {i};
+                        graphs::PersistentIndex ix2 {j};
+                        if (mapped.active(ix1) && mapped.active(ix2)) {
+                            REQUIRE(mapped.graphDistance(ix1, ix2) == graph.graphDistance(ix1, ix2));
+                        }
+                    }
+                }
+                REQUIRE(mapped.graphDistance(graphs::PersistentIndex{3}, graphs::PersistentIndex{5}) == 6);
+                REQUIRE(mapped.graphDistance(graphs::PersistentIndex{0}, graphs::PersistentIndex{9}) == -1);
+                REQUIRE_THROWS_AS(mapped.graphDistance(graphs::PersistentIndex{4}, graphs::PersistentIndex{5}),
+                                  std::out_of_range);
+            }
+            THEN("components are labeled") {
+                auto labels = mapped.componentLabels();
+                REQUIRE(labels.size() == 12);
+                REQUIRE(labels[4] == mapped.npos);
+                std::set<std::size_t> distinct;
+                for (std::size_t i = 0; i < 12; ++i) {
+                    if (i != 4) {
+                        distinct.insert(labels[i]);
+                        REQUIRE(labels[i] == (i < 8 ? labels[0] : labels[8]));
+                    }
+                }
+                REQUIRE(distinct.size() == graph.connectedComponents().size());
+            }
+            THEN("the view can be moved") {
+                auto other = std::move(mapped);
+                REQUIRE(other.nVertices() == 11);
+                REQUIRE(other.neighbors(graphs::PersistentIndex{0}).size() == 2);
+            }
+        }
+        std::remove(path.c_str());
+    }
+    GIVEN("A graph with multiple data fields in memory") {
+        using Graph = graphs::Graph<graphs::IndexPersistentVector, graphs::Vertex<std::uint8_t, double>>;
+        Graph graph;
+        auto a = graph.addVertex({1, 1.5});
+        auto b = graph.addVertex({2, 2.5});
+        graph.addEdge(a, b);
+        std::ostringstream os(std::ios_base::out | std::ios_base::binary);
+        graphs::MappedGraph<Graph>::write(graph, os);
+        auto bytes = os.str();
+        std::vector<std::uint64_t> memory((bytes.size() + 7) / 8);
+        std::memcpy(memory.data(), bytes.data(), bytes.size());
+
+        THEN("the view on the memory yields the data as tuples") {
+            graphs::MappedGraph<Graph> mapped(memory.data(), bytes.size());
+            REQUIRE(mapped.data(a) == std::make_tuple(std::uint8_t{1}, 1.5));
+            REQUIRE(mapped.data(b) == std::make_tuple(std::uint8_t{2}, 2.5));
+            REQUIRE(mapped.graphDistance(a, b) == 1);
+        }
+        THEN("invalid memory is rejected") {
+            REQUIRE_THROWS_AS(graphs::MappedGraph<Graph>(memory.data(), 16), std::runtime_error);
+            REQUIRE_THROWS_AS(graphs::MappedGraph<Graph>(memory.data(), bytes.size() - 8), std::runtime_error);
+            REQUIRE_THROWS_AS(graphs::MappedGraph<graphs::DefaultGraph>(memory.data(), bytes.size()),
+                              std::runtime_error);
+            auto corrupt = memory;
+            reinterpret_cast<char *>(corrupt.data())[0] = 'X';
+            REQUIRE_THROWS_AS(graphs::MappedGraph<Graph>(corrupt.data(), bytes.size()), std::runtime_error);
+        }
+        THEN("corrupt counts, offsets and indices are rejected instead of read out of bounds") {
+            using Header = graphs::detail::MappedGraphHeader;
+            auto section = [&memory](std::size_t word) { return memory[word] / sizeof(std::uint64_t); };
+            auto corrupt = memory;
+            corrupt[Header::nSlots] = std::numeric_limits<std::uint64_t>::max() / 4;
+            REQUIRE_THROWS_AS(graphs::MappedGraph<Graph>(corrupt.data(), bytes.size()), std::runtime_error);
+            corrupt = memory;
+            corrupt[section(Header::offsets) + 1] = 3;
+            {
+                graphs::MappedGraph<Graph> mapped(corrupt.data(), bytes.size());
+                REQUIRE_THROWS_AS(mapped.neighbors(a), std::runtime_error);
+                REQUIRE_THROWS_AS(mapped.componentLabels(), std::runtime_error);
+                REQUIRE_THROWS_AS(mapped.neighbors(graphs::PersistentIndex{2}), std::out_of_range);
+            }
+            corrupt = memory;
+            corrupt[section(Header::neighbors)] = 1000;
+            {
+                graphs::MappedGraph<Graph> mapped(corrupt.data(), bytes.size());
+                REQUIRE_THROWS_AS(mapped.componentLabels(), std::runtime_error);
+                REQUIRE_THROWS_AS(mapped.graphDistance(a, b), std::runtime_error);
+            }
+            corrupt = memory;
+            corrupt[section(Header::activeIndices) + 1] = 1000;
+            {
+                graphs::MappedGraph<Graph> mapped(corrupt.data(), bytes.size());
+                REQUIRE_THROWS_AS(mapped.persistentIndex(1), std::runtime_error);
+                REQUIRE_THROWS_AS(mapped.componentLabels(), std::runtime_error);
+            }
+        }
+        THEN("missing files are reported") {
+            REQUIRE_THROWS_AS(graphs::MappedGraph<Graph>(temporaryPath("missing")), std::system_error);
+        }
+    }
+}
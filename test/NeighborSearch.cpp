@@ -0,0 +1,140 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+namespace {
+std::vector<graphs::SimdLevel> supportedLevels() {
+    std::vector<graphs::SimdLevel> levels;
+    for (auto level : {graphs::SimdLevel::scalar, graphs::SimdLevel::sse2, graphs::SimdLevel::avx2}) {
+        if (graphs::simdSupported(level)) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+template<typename Index>
+void requireSameAsFind() {
+    std::mt19937 generator(3);
+    for (auto level : supportedLevels()) {
+        for (std::size_t n = 0; n <= 70; ++n) {
+            std::vector<Index> indices(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                indices[i] = Index::of(2 * i + 1);
+            }
+            std::shuffle(indices.begin(), indices.end(), generator);
+            const auto *first = indices.data();
+            const auto *last = first + n;
+            // every element, then a value which is missing and one which differs only in the upper half
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(graphs::findIndex(first, last, indices[i], level) == first + i);
+            }
+            REQUIRE(graphs::findIndex(first, last, Index::of(0), level) == last);
+            REQUIRE(graphs::findIndex(first, last, Index::of(std::numeric_limits<typename Index::value_type>::max()),
+                                      level) == last);
+            if (n > 3) {
+                indices[n - 1] = indices[2];
+                REQUIRE(graphs::findIndex(first, last, indices[2], level) == first + 2);
+            }
+        }
+    }
+}
+
+template<typename Index>
+void requireSameEdges() {
+    using Edge = std::tuple<Index, Index>;
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<std::size_t> distribution(0, 9);
+    for (auto level : supportedLevels()) {
+        for (std::size_t n = 0; n <= 40; ++n) {
+            std::vector<Edge> edges;
+            for (std::size_t i = 0; i < n; ++i) {
+                edges.emplace_back(Index::of(distribution(generator)), Index::of(distribution(generator)));
+            }
+            const auto *first = edges.data();
+            const auto *last = first + n;
+            for (std::size_t v1 = 0; v1 < 10; ++v1) {
+                auto ix1 = Index::of(v1);
+                auto incident = std::find_if(first, last, [ix1](const Edge &edge) {
+                    return std::get<0>(edge) == ix1 || std::get<1>(edge) == ix1;
+                });
+                REQUIRE(graphs::findIncidentEdge(first, last, ix1, level) == incident);
+                for (std::size_t v2 = 0; v2 < 10; ++v2) {
+                    auto ix2 = Index::of(v2);
+                    auto expected = std::find_if(first, last, [ix1, ix2](const Edge &edge) {
+                        return edge == std::make_tuple(ix1, ix2) || edge == std::make_tuple(ix2, ix1);
+                    });
+                    REQUIRE(graphs::findEdge(first, last, ix1, ix2, level) == expected);
+                }
+            }
+        }
+    }
+}
+}
+
+SCENARIO("Vectorized neighbor and edge search", "[simd]") {
+    REQUIRE(graphs::simdSupported(graphs::SimdLevel::scalar));
+    REQUIRE(graphs::simdSupported(graphs::simdLevel()));
+    GIVEN("Arrays of 64-bit and 32-bit indices of all lengths up to several vectors") {
+        THEN("every supported instruction set finds the same position as std::find") {
+            requireSameAsFind<graphs::PersistentIndex>();
+            requireSameAsFind<graphs::PersistentIndex32>();
+        }
+    }
+    GIVEN("Edge lists with duplicates and self-loops") {
+        THEN("edges are found in either orientation at the first position, as are incident edges") {
+            requireSameEdges<graphs::PersistentIndex>();
+            requireSameEdges<graphs::PersistentIndex32>();
+        }
+    }
+    GIVEN("A hub vertex with many neighbors in a graph and in its copy-on-write counterpart") {
+        graphs::Graph32 graph;
+        graphs::CowGraph reference;
+        for (std::size_t i = 0; i < 300; ++i) {
+            graph.addVertex(i);
+            reference.addVertex(i);
+        }
+        for (std::size_t i = 1; i < 300; i += 2) {
+            graph.addEdge(graphs::PersistentIndex32::of(0), graphs::PersistentIndex32::of(i));
+            reference.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{i});
+        }
+        WHEN("querying, adding and removing edges of the hub") {
+            for (std::size_t i = 1; i < 300; i += 3) {
+                graph.addEdge(graphs::PersistentIndex32::of(i), graphs::PersistentIndex32::of(0));
+                reference.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{0});
+            }
+            graph.checkpoint();
+            graph.removeVertex(graphs::PersistentIndex32::of(7));
+            graph.rollback();
+            for (std::size_t i = 1; i < 300; i += 5) {
+                graph.removeEdge(graphs::PersistentIndex32::of(0), graphs::PersistentIndex32::of(i));
+                reference.removeEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{i});
+            }
+            graph.removeVertex(graphs::PersistentIndex32::of(9));
+            reference.removeVertex(graphs::PersistentIndex{9});
+            THEN("both agree on the neighbors and edges") {
+                const auto &neighbors = graph.vertices().at(graphs::PersistentIndex32::of(0)).neighbors();
+                const auto &referenceNeighbors = reference.vertices().at(graphs::PersistentIndex{0}).neighbors();
+                REQUIRE(neighbors.size() == referenceNeighbors.size());
+                for (std::size_t i = 0; i < neighbors.size(); ++i) {
+                    REQUIRE(neighbors[i].value == referenceNeighbors[i].value);
+                }
+                REQUIRE(graph.nEdges() == reference.nEdges());
+                for (std::size_t i = 1; i < 300; ++i) {
+                    if (i != 9) {
+                        REQUIRE(graph.containsEdge(graphs::PersistentIndex32::of(i), graphs::PersistentIndex32::of(0)) ==
+                                reference.containsEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{0}));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,179 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <random>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+#include "GraphComparison.h"
+
+namespace {
+using Packed = graphs::PackedVertex<std::size_t>;
+using PackedGraph32 = graphs::Graph<graphs::PackedIndexPersistentVector, graphs::PackedVertex32<std::size_t>>;
+}
+
+SCENARIO("Packed vertices", "[packed]") {
+    static_assert(sizeof(Packed) < sizeof(graphs::DefaultVertex));
+    static_assert(!std::is_polymorphic_v<Packed>);
+    static_assert(std::is_same_v<graphs::RelocatingVector<Packed>, graphs::detail::TriviallyRelocatingVector<Packed>>);
+    static_assert(std::is_same_v<graphs::RelocatingVector<int>, std::vector<int>>);
+    static_assert(std::is_same_v<graphs::RelocatingVector<graphs::DefaultVertex>, std::vector<graphs::DefaultVertex>>);
+    GIVEN("A packed vertex with neighbors") {
+        Packed v {5};
+        for (std::size_t i = 0; i < 10; ++i) {
+            v.addNeighbor(graphs::PersistentIndex{i});
+        }
+        v.addNeighbor(graphs::PersistentIndex{3});
+        v.removeNeighbor(graphs::PersistentIndex{4});
+        THEN("it behaves like a vertex") {
+            REQUIRE(v.data() == 5);
+            REQUIRE(*v.operator->() == 5);
+            REQUIRE(v.neighbors().size() == 9);
+            REQUIRE(v.neighbors()[4] == graphs::PersistentIndex{5});
+            REQUIRE(!v.deactivated());
+        }
+        WHEN("deactivating it") {
+            v.deactivate();
+            v.addNeighbor(graphs::PersistentIndex{42});
+            v.neighbors().shrink_to_fit();
+            THEN("the flag is independent of the neighbor list's capacity") {
+                REQUIRE(v.deactivated());
+                REQUIRE(v.neighbors().size() == 10);
+                REQUIRE(v.neighbors().capacity() == 10);
+            }
+            THEN("copies and moves carry the flag") {
+                auto copy = v;
+                REQUIRE(copy.deactivated());
+                auto moved = std::move(copy);
+                REQUIRE(moved.deactivated());
+                REQUIRE(moved.neighbors() == v.neighbors());
+                Packed other {1};
+                other = moved;
+                REQUIRE(other.deactivated());
+            }
+            THEN("copy-assigning it over a vertex with fewer neighbors reallocates the neighbor list") {
+                Packed other {1};
+                other.addNeighbor(graphs::PersistentIndex{0});
+                other.addNeighbor(graphs::PersistentIndex{1});
+                other = v;
+                REQUIRE(other.deactivated());
+                REQUIRE(other.neighbors() == v.neighbors());
+                other.neighbors() = Packed {2}.neighbors();
+                REQUIRE(other.neighbors().empty());
+                REQUIRE(other.deactivated());
+            }
+            THEN("swapping neighbor lists leaves the flags in place") {
+                Packed other {1};
+                other.addNeighbor(graphs::PersistentIndex{0});
+                v.neighbors().swap(other.neighbors());
+                REQUIRE(v.deactivated());
+                REQUIRE(!other.deactivated());
+                REQUIRE(v.neighbors().size() == 1);
+                REQUIRE(other.neighbors().size() == 10);
+            }
+        }
+    }
+    GIVEN("A relocating vector of packed vertices") {
+        graphs::RelocatingVector<Packed> vertices;
+        for (std::size_t i = 0; i < 100; ++i) {
+            auto &v = vertices.emplace_back(std::size_t{i});
+            v.addNeighbor(graphs::PersistentIndex{i});
+            if (i % 7 == 0) {
+                v.deactivate();
+            }
+        }
+        // the argument refers to an element which is relocated by the growth
+        vertices.push_back(vertices.front());
+        THEN("the vertices survive growth with their neighbors and flags") {
+            REQUIRE(vertices.size() == 101);
+            for (std::size_t i = 0; i < 100; ++i) {
+                REQUIRE(vertices[i].data() == i);
+                REQUIRE(vertices[i].neighbors().front() == graphs::PersistentIndex{i});
+                REQUIRE(vertices[i].deactivated() == (i % 7 == 0));
+            }
+            REQUIRE(vertices.back().deactivated());
+            REQUIRE(vertices.back().neighbors().front() == graphs::PersistentIndex{0});
+        }
+        WHEN("shrinking and copying it") {
+            vertices.pop_back();
+            vertices.shrink_to_fit();
+            auto copy = vertices;
+            THEN("the copy owns its neighbor lists") {
+                REQUIRE(copy.capacity() == 100);
+                copy[1].addNeighbor(graphs::PersistentIndex{7});
+                REQUIRE(vertices[1].neighbors().size() == 1);
+                REQUIRE(copy[1].neighbors().size() == 2);
+                REQUIRE(copy[7].deactivated());
+            }
+        }
+    }
+}
+
+SCENARIO("Graphs with packed vertices", "[packed]") {
+    GIVEN("A packed graph with blanks and its default counterpart") {
+        graphs::DefaultGraph reference;
+        graphs::PackedGraph graph;
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<std::size_t> vertexDistribution(0, 59);
+        for (std::size_t i = 0; i < 60; ++i) {
+            reference.addVertex(i);
+            graph.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 150; ++i) {
+            graphs::PersistentIndex ix1 {vertexDistribution(generator)};
+            graphs::PersistentIndex ix2 {vertexDistribution(generator)};
+            if (ix1 != ix2 && !reference.containsEdge(ix1, ix2)) {
+                reference.addEdge(ix1, ix2);
+                graph.addEdge(ix1, ix2);
+            }
+        }
+        for (std::size_t i : {2, 11, 40}) {
+            reference.removeVertex(graphs::PersistentIndex{i});
+            graph.removeVertex(graphs::PersistentIndex{i});
+        }
+
+        THEN("both have the same vertices, edges, algorithm results, rollbacks and binary format") {
+            test::requireSameGraph(graph, reference);
+            test::requireSameResults(graph, reference, graphs::PersistentIndex{0}, graphs::PersistentIndex{59});
+            test::requireRollbackRestores(graph, reference);
+            test::requireSameAfterReading<graphs::DefaultGraph>(graph, reference);
+        }
+        WHEN("copy-assigning it to a graph with fewer neighbors per vertex") {
+            graphs::PackedGraph other;
+            for (std::size_t i = 0; i < 60; ++i) {
+                auto v = other.addVertex(i);
+                if (i > 0) {
+                    other.addEdge(v, graphs::PersistentIndex{i - 1});
+                }
+            }
+            other = graph;
+            THEN("the copy is the same graph") {
+                test::requireSameGraph(other, reference);
+            }
+        }
+        WHEN("shrinking and appending it") {
+            graph.shrinkToFit();
+            reference.shrinkToFit();
+            auto copy = graph;
+            copy.append(graph);
+            THEN("the vertices are intact") {
+                test::requireSameGraph(graph, reference);
+                REQUIRE(copy.nVertices() == 2 * graph.nVertices());
+                REQUIRE(copy.nEdges() == 2 * graph.nEdges());
+            }
+        }
+    }
+    GIVEN("A packed graph with 32-bit indices") {
+        PackedGraph32 graph;
+        auto v1 = graph.addVertex(1);
+        auto v2 = graph.addVertex(2);
+        graph.addEdge(v1, v2);
+        THEN("neighbors are stored as 32-bit indices") {
+            static_assert(sizeof(graphs::PackedVertex32<std::size_t>::NeighborList::value_type) == 4);
+            REQUIRE(graph.vertices().at(v1).neighbors().front() == v2);
+            REQUIRE(graph.isConnected());
+        }
+    }
+}
@@ -0,0 +1,84 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <atomic>
+#include <numeric>
+#include <random>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+#include <graphs/ParallelAlgorithms.h>
+
+SCENARIO("Work-stealing thread pool", "[parallel]") {
+    GIVEN("A pool with four threads") {
+        graphs::ThreadPool pool(4);
+        REQUIRE(pool.nThreads() == 4);
+        WHEN("running a batch of tasks repeatedly") {
+            std::vector<std::atomic<int>> calls(1000);
+            std::vector<std::size_t> order(calls.size());
+            std::iota(order.begin(), order.end(), 0);
+            for (int round = 0; round < 10; ++round) {
+                pool.run(order, [&](std::size_t i) { ++calls[i]; });
+            }
+            THEN("every task ran once per batch") {
+                for (const auto &c : calls) {
+                    REQUIRE(c.load() == 10);
+                }
+            }
+        }
+        WHEN("a task throws") {
+            THEN("the exception is rethrown after the batch and the pool stays usable") {
+                std::atomic<int> nCalls {0};
+                REQUIRE_THROWS_AS(pool.run({0, 1, 2, 3, 4, 5}, [&](std::size_t i) {
+                    ++nCalls;
+                    if (i == 3) throw std::runtime_error("task failed");
+                }), std::runtime_error);
+                REQUIRE(nCalls.load() == 6);
+                pool.run({0}, [&](std::size_t) { ++nCalls; });
+                REQUIRE(nCalls.load() == 7);
+            }
+        }
+    }
+}
+
+SCENARIO("Parallel batch algorithms over many graphs", "[parallel]") {
+    GIVEN("Graphs of varying size, some of them disconnected") {
+        std::mt19937 generator(7);
+        std::vector<graphs::DefaultGraph> graphList;
+        for (std::size_t g = 0; g < 200; ++g) {
+            graphs::DefaultGraph graph;
+            auto n = std::uniform_int_distribution<std::size_t>(1, 60)(generator);
+            for (std::size_t i = 0; i < n; ++i) {
+                graph.addVertex(i);
+                if (i > 0 && (g % 3 != 0 || i != n / 2)) {
+                    graph.addEdge(graphs::PersistentIndex{i - 1}, graphs::PersistentIndex{i});
+                }
+            }
+            graphList.push_back(std::move(graph));
+        }
+        graphs::ThreadPool pool(4);
+
+        THEN("the results match the sequential algorithms in input order") {
+            auto connected = graphs::parallel::isConnected(pool, graphList.begin(), graphList.end());
+            auto components = graphs::parallel::connectedComponents(pool, graphList.begin(), graphList.end());
+            auto tuples = graphs::parallel::findNTuples(pool, graphList.cbegin(), graphList.cend());
+            REQUIRE(connected.size() == graphList.size());
+            REQUIRE(components.size() == graphList.size());
+            REQUIRE(tuples.size() == graphList.size());
+            for (std::size_t i = 0; i < graphList.size(); ++i) {
+                REQUIRE(connected[i] == graphList[i].isConnected());
+                REQUIRE(components[i].size() == graphList[i].connectedComponents().size());
+                REQUIRE(tuples[i] == graphList[i].findNTuples());
+            }
+        }
+        THEN("arbitrary functions can be applied") {
+            auto nEdges = graphs::parallel::transform(pool, graphList.begin(), graphList.end(), [](const auto &graph) {
+                return graph.nEdges();
+            });
+            for (std::size_t i = 0; i < graphList.size(); ++i) {
+                REQUIRE(nEdges[i] == graphList[i].nEdges());
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <thread>
+#include <atomic>
+#include <limits>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+#include <graphs/PublishedGraph.h>
+
+SCENARIO("Published graph versions", "[published]") {
+    GIVEN("A published copy-on-write graph with a single vertex") {
+        graphs::CowGraph initial;
+        initial.addVertex(0);
+        graphs::PublishedGraph<graphs::CowGraph> published(initial, 4);
+
+        WHEN("reading while the writer mutates its working copy") {
+            auto handle = published.read();
+            auto &writer = published.writer();
+            writer.addEdge(graphs::PersistentIndex{0}, writer.addVertex(1));
+            THEN("the reader sees the published version only") {
+                REQUIRE(handle.version() == 0);
+                REQUIRE(handle->nVertices() == 1);
+                REQUIRE(handle->nEdges() == 0);
+            }
+            AND_WHEN("publishing") {
+                auto version = published.publish();
+                THEN("new readers see the new version while the old version stays pinned") {
+                    REQUIRE(version == 1);
+                    auto handle2 = published.read();
+                    REQUIRE(handle2.version() == 1);
+                    REQUIRE(handle2->nVertices() == 2);
+                    REQUIRE(handle->nVertices() == 1);
+                    REQUIRE(published.nRetired() == 1);
+                }
+                AND_WHEN("releasing the old handle") {
+                    { auto released = std::move(handle); }
+                    THEN("the old version can be reclaimed") {
+                        REQUIRE(published.reclaim() == 0);
+                    }
+                }
+            }
+        }
+
+        WHEN("many readers run concurrently with a writer that grows a chain") {
+            // unknown until the writer is done, every reader stops once it has checked this version
+            std::atomic<std::uint64_t> finalVersion {std::numeric_limits<std::uint64_t>::max()};
+            std::atomic<std::size_t> nReads {0};
+            std::atomic<std::size_t> nInconsistent {0};
+            std::vector<std::thread> readers;
+            for (int i = 0; i < 8; ++i) {
+                readers.emplace_back([&]() {
+                    std::uint64_t lastVersion = 0;
+                    while (lastVersion != finalVersion.load()) {
+                        // leave the writer and the other readers a chance on machines with few cores, without a pin
+                        std::this_thread::yield();
+                        auto handle = published.read();
+                        const auto &graph = *handle;
+                        if (handle.version() < lastVersion || graph.nEdges() + 1 != graph.nVertices() ||
+                            !graph.isConnected() ||
+                            graph.graphDistance(graph.begin(), --graph.end()) + 1 != static_cast<int>(graph.nVertices())) {
+                            ++nInconsistent;
+                        }
+                        lastVersion = handle.version();
+                        ++nReads;
+                    }
+                });
+            }
+            auto &writer = published.writer();
+            auto last = graphs::PersistentIndex{0};
+            std::uint64_t version = 0;
+            for (std::size_t i = 1; i < 300; ++i) {
+                auto next = writer.addVertex(i);
+                writer.addEdge(last, next);
+                last = next;
+                version = published.publish();
+            }
+            // joining waits until every reader has checked the final version
+            finalVersion.store(version);
+            for (auto &reader : readers) {
+                reader.join();
+            }
+            THEN("every reader always saw a consistent chain and all old versions can be reclaimed") {
+                REQUIRE(nReads.load() >= readers.size());
+                REQUIRE(nInconsistent.load() == 0);
+                REQUIRE(published.reclaim() == 0);
+                REQUIRE(published.read()->nVertices() == 300);
+            }
+        }
+    }
+}
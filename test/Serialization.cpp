@@ -0,0 +1,341 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <algorithm>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+namespace {
+template<typename Graph>
+void requireEqual(const Graph &graph, const Graph &other) {
+    REQUIRE(other.vertices().size_persistent() == graph.vertices().size_persistent());
+    REQUIRE(other.vertices().n_deactivated() == graph.vertices().n_deactivated());
+    for (std::size_t i = 0; i < graph.vertices().size_persistent(); ++i) {
+        const auto &v = *(graph.begin_persistent() + i);
+        const auto &w = *(other.begin_persistent() + i);
+        REQUIRE(w.deactivated() == v.deactivated());
+        if (!v.deactivated()) {
+            REQUIRE(w.data() == v.data());
+            REQUIRE(std::equal(v.neighbors().begin(), v.neighbors().end(), w.neighbors().begin(),
+                               w.neighbors().end()));
+        }
+    }
+    REQUIRE(std::equal(graph.edges().begin(), graph.edges().end(), other.edges().begin(), other.edges().end()));
+}
+
+/**
+ * Same vertex slots, data and edges, neighbors and edges in any order.
+ */
+template<typename Graph>
+void requireEquivalent(const Graph &graph, const Graph &other) {
+    REQUIRE(other.nVertices() == graph.nVertices());
+    REQUIRE(other.nEdges() == graph.nEdges());
+    auto slots = std::max(graph.vertices().size_persistent(), other.vertices().size_persistent());
+    for (std::size_t i = 0; i < slots; ++i) {
+        auto active = [i](const Graph &g) {
+            return i < g.vertices().size_persistent() && !(g.begin_persistent() + i)->deactivated();
+        };
+        REQUIRE(active(graph) == active(other));
+        if (active(graph)) {
+            const auto &v = *(graph.begin_persistent() + i);
+            const auto &w = *(other.begin_persistent() + i);
+            REQUIRE(w.data() == v.data());
+            REQUIRE(std::is_permutation(v.neighbors().begin(), v.neighbors().end(), w.neighbors().begin(),
+                                        w.neighbors().end()));
+        }
+    }
+    for (const auto &edge : graph.edges()) {
+        REQUIRE(other.containsEdge(edge));
+    }
+}
+
+template<typename Graph>
+Graph roundTrip(const Graph &graph) {
+    std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    graph.write(ss);
+    return Graph::read(ss);
+}
+}
+
+SCENARIO("Binary serialization of graphs", "[serialization]") {
+    GIVEN("A graph with blanks") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 10; ++i) {
+            graph.addVertex(100 + i);
+        }
+        for (std::size_t i = 0; i < 9; ++i) {
+            graph.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{i + 1});
+        }
+        graph.addEdge(graphs::PersistentIndex{9}, graphs::PersistentIndex{0});
+        graph.removeVertex(graphs::PersistentIndex{3});
+        graph.removeVertex(graphs::PersistentIndex{7});
+
+        WHEN("writing and reading it") {
+            auto copy = roundTrip(graph);
+            THEN("vertices, blanks, neighbors and edges are restored at their persistent indices") {
+                requireEqual(graph, copy);
+                REQUIRE(copy.nVertices() == 8);
+                REQUIRE(copy.nEdges() == 6);
+                REQUIRE(copy.containsEdge(graphs::PersistentIndex{8}, graphs::PersistentIndex{9}));
+                REQUIRE(!copy.containsEdge(graphs::PersistentIndex{2}, graphs::PersistentIndex{3}));
+            }
+            THEN("the blanks are reused in the same order") {
+                REQUIRE(copy.addVertex(1) == graph.addVertex(1));
+                REQUIRE(copy.addVertex(2) == graph.addVertex(2));
+                requireEqual(graph, copy);
+            }
+        }
+        WHEN("writing it while a checkpoint is open") {
+            graph.checkpoint();
+            graph.removeEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{1});
+            auto copy = roundTrip(graph);
+            THEN("the current state is stored without the journal") {
+                requireEqual(graph, copy);
+                REQUIRE(!copy.journaling());
+            }
+        }
+        WHEN("writing two graphs into the same stream") {
+            graphs::DefaultGraph empty;
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            graph.write(ss);
+            empty.write(ss);
+            ss << "tail";
+            THEN("they are read one after the other") {
+                auto first = graphs::DefaultGraph::read(ss);
+                auto second = graphs::DefaultGraph::read(ss);
+                requireEqual(graph, first);
+                REQUIRE(second.vertices().empty_persistent());
+                std::string tail;
+                ss >> tail;
+                REQUIRE(tail == "tail");
+            }
+        }
+    }
+    GIVEN("A graph which is larger than a block of vertex data and the stream buffers") {
+        graphs::DefaultGraph graph;
+        constexpr std::size_t n = 100000;
+        for (std::size_t i = 0; i < n; ++i) {
+            graph.addVertex(i * i);
+        }
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            graph.addEdge(graphs::PersistentIndex{i}, graphs::PersistentIndex{(i * 7919 + 1) % n});
+        }
+        for (std::size_t i = 0; i < n; i += 97) {
+            graph.removeVertex(graphs::PersistentIndex{i});
+        }
+        THEN("it survives a round trip") {
+            requireEqual(graph, roundTrip(graph));
+        }
+    }
+    GIVEN("A graph with non-trivially copyable vertex data") {
+        using Graph = graphs::Graph<graphs::IndexPersistentVector, graphs::Vertex<std::string, int, std::vector<double>>>;
+        Graph graph;
+        auto a = graph.addVertex({"a", 1, {1., 2.}});
+        auto b = graph.addVertex({std::string(5000, 'b'), 2, {}});
+        auto c = graph.addVertex({"", 3, {3.}});
+        graph.addEdge(a, b);
+        graph.addEdge(b, c);
+        graph.removeVertex(a);
+        THEN("the data goes through the serializers") {
+            auto copy = roundTrip(graph);
+            requireEqual(graph, copy);
+            REQUIRE(std::get<0>(copy.vertices().at(b).data()).size() == 5000);
+        }
+    }
+    GIVEN("A copy-on-write graph and a graph allocating from a memory resource") {
+        graphs::CowGraph cowGraph;
+        std::pmr::monotonic_buffer_resource arena;
+        graphs::PmrGraph pmrGraph(&arena);
+        for (std::size_t i = 0; i < 5; ++i) {
+            cowGraph.addVertex(i);
+            pmrGraph.addVertex(i);
+        }
+        cowGraph.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{4});
+        pmrGraph.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{4});
+        cowGraph.removeVertex(graphs::PersistentIndex{2});
+        pmrGraph.removeVertex(graphs::PersistentIndex{2});
+        THEN("both survive a round trip") {
+            requireEqual(cowGraph, roundTrip(cowGraph));
+
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            pmrGraph.write(ss);
+            std::pmr::monotonic_buffer_resource otherArena;
+            auto copy = graphs::PmrGraph::read(ss, &otherArena);
+            requireEqual(pmrGraph, copy);
+            REQUIRE(copy.get_allocator().resource() == &otherArena);
+        }
+    }
+    GIVEN("Invalid input") {
+        graphs::DefaultGraph graph;
+        graph.addVertex(1);
+        graph.addVertex(2);
+        graph.addEdge(graphs::PersistentIndex{0}, graphs::PersistentIndex{1});
+        std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        graph.write(ss);
+        auto bytes = ss.str();
+
+        auto readBytes = [](const std::string &data) {
+            std::stringstream in(data, std::ios_base::in | std::ios_base::binary);
+            return graphs::DefaultGraph::read(in);
+        };
+        THEN("reading fails with an exception") {
+            auto badMagic = bytes;
+            badMagic[0] = 'X';
+            REQUIRE_THROWS_AS(readBytes(badMagic), std::runtime_error);
+
+            auto badVersion = bytes;
+            badVersion[4] = 42;
+            REQUIRE_THROWS_AS(readBytes(badVersion), std::runtime_error);
+
+            REQUIRE_THROWS_AS(readBytes(bytes.substr(0, bytes.size() - 1)), std::runtime_error);
+
+            auto badEdge = bytes;
+            badEdge[badEdge.size() - 8] = 7;
+            REQUIRE_THROWS_AS(readBytes(badEdge), std::runtime_error);
+
+            std::stringstream in(bytes, std::ios_base::in | std::ios_base::binary);
+            using OtherGraph = graphs::Graph<graphs::IndexPersistentVector, graphs::Vertex<std::uint32_t>>;
+            REQUIRE_THROWS_AS(OtherGraph::read(in), std::runtime_error);
+        }
+    }
+}
+
+SCENARIO("Incremental deltas of graphs", "[serialization][delta]") {
+    GIVEN("A graph with blanks and a snapshot taken at the change marker") {
+        graphs::DefaultGraph graph;
+        for (std::size_t i = 0; i < 100; ++i) {
+            graph.addVertex(i);
+            if (i > 0) {
+                graph.addEdge(graphs::PersistentIndex{i - 1}, graphs::PersistentIndex{i});
+            }
+        }
+        graph.removeVertex(graphs::PersistentIndex{50});
+        graph.mark();
+        auto snapshot = graph.snapshot();
+        snapshot.unmark();
+
+        auto applied = [&snapshot](const graphs::DefaultGraph &g) {
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            g.writeDelta(ss);
+            auto copy = snapshot;
+            copy.applyDelta(ss);
+            return std::make_pair(copy, ss.str().size());
+        };
+
+        WHEN("nothing changes") {
+            THEN("the delta is empty and applies cleanly") {
+                REQUIRE(graph.changedVertices().empty());
+                auto [copy, bytes] = applied(graph);
+                requireEquivalent(graph, copy);
+                REQUIRE(bytes < 64);
+            }
+        }
+        WHEN("edges, vertices and data change") {
+            graph.addEdge(graphs::PersistentIndex{10}, graphs::PersistentIndex{20});
+            graph.removeEdge(graphs::PersistentIndex{30}, graphs::PersistentIndex{31});
+            graph.removeVertex(graphs::PersistentIndex{70});
+            // both reuse blanks
+            auto added = graph.addVertex(1000);
+            graph.addEdge(added, graphs::PersistentIndex{0});
+            auto appended = graph.addVertex(2000);
+            graph.addEdge(appended, graph.addVertex(3000));
+            graph.addEdge(appended, added);
+            graph.setData(graphs::PersistentIndex{5}, {500});
+            graph.vertices().at(graphs::PersistentIndex{6}).setData({600});
+            graph.touch(graphs::PersistentIndex{6});
+
+            THEN("applying the delta to the snapshot reproduces the graph") {
+                auto [copy, bytes] = applied(graph);
+                requireEquivalent(graph, copy);
+                REQUIRE(copy.vertices().at(graphs::PersistentIndex{5}).data() == 500);
+                REQUIRE(copy.vertices().at(graphs::PersistentIndex{6}).data() == 600);
+                REQUIRE(copy.vertices().at(added).data() == 1000);
+            }
+            THEN("only changed vertices are written") {
+                auto changed = graph.changedVertices();
+                std::vector<graphs::PersistentIndex> expected {{0}, {5}, {6}, {10}, {20}, {30}, {31}, {69}, {70}, {71},
+                                                               {100}, added, appended};
+                std::sort(expected.begin(), expected.end());
+                expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+                REQUIRE(changed == expected);
+                std::stringstream full(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+                graph.write(full);
+                REQUIRE(applied(graph).second < full.str().size() / 4);
+            }
+        }
+        WHEN("a batch commits and a checkpoint rolls back") {
+            {
+                auto batch = graph.batch();
+                batch.addEdge(graphs::PersistentIndex{1}, graphs::PersistentIndex{3});
+                batch.removeVertex(graphs::PersistentIndex{90});
+            }
+            graph.checkpoint();
+            graph.removeVertex(graphs::PersistentIndex{40});
+            auto added = graph.addVertex(7);
+            graph.addEdge(added, graphs::PersistentIndex{41});
+            graph.rollback();
+            graph.addVertex(8);
+            THEN("the delta reproduces the graph") {
+                auto [copy, bytes] = applied(graph);
+                requireEquivalent(graph, copy);
+            }
+        }
+        WHEN("the graph is copied with an allocator after changing") {
+            graph.addEdge(graphs::PersistentIndex{10}, graphs::PersistentIndex{20});
+            graph.removeVertex(graphs::PersistentIndex{70});
+            graphs::DefaultGraph copy(graph, graph.get_allocator());
+            THEN("the copy keeps the marker and the changes") {
+                REQUIRE(copy.tracking());
+                REQUIRE(copy.changedVertices() == graph.changedVertices());
+                auto [appliedCopy, bytes] = applied(copy);
+                requireEquivalent(graph, appliedCopy);
+            }
+        }
+        WHEN("the delta is applied to a graph in another state") {
+            graph.addEdge(graphs::PersistentIndex{10}, graphs::PersistentIndex{20});
+            std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            graph.writeDelta(ss);
+            auto other = snapshot;
+            other.addVertex(1);
+            THEN("it is rejected") {
+                REQUIRE_THROWS_AS(other.applyDelta(ss), std::runtime_error);
+                REQUIRE(other.nVertices() == snapshot.nVertices() + 1);
+            }
+        }
+        WHEN("changes are chained over several markers") {
+            std::vector<std::string> deltas;
+            for (std::size_t round = 0; round < 5; ++round) {
+                graph.addEdge(graphs::PersistentIndex{round}, graphs::PersistentIndex{99 - round});
+                graph.removeVertex(graphs::PersistentIndex{60 + round});
+                graph.addVertex(round);
+                std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+                graph.writeDelta(ss);
+                deltas.push_back(ss.str());
+                graph.mark();
+            }
+            THEN("applying the deltas in order reproduces the graph") {
+                auto copy = snapshot;
+                for (const auto &delta : deltas) {
+                    std::stringstream ss(delta, std::ios_base::in | std::ios_base::binary);
+                    copy.applyDelta(ss);
+                }
+                requireEquivalent(graph, copy);
+            }
+        }
+    }
+    GIVEN("A graph without change marker") {
+        graphs::DefaultGraph graph;
+        graph.addVertex(1);
+        THEN("no delta can be written") {
+            std::ostringstream os;
+            REQUIRE(!graph.tracking());
+            REQUIRE_THROWS_AS(graph.writeDelta(os), std::logic_error);
+        }
+    }
+}
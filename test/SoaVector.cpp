@@ -0,0 +1,144 @@
+//
+// Created by mho on 10/19/26.
+//
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <catch2/catch.hpp>
+#include <graphs/graphs.h>
+
+#include "GraphComparison.h"
+
+namespace {
+using Columns = graphs::SoaVector<graphs::Vertex<int, double>>;
+using SoaPairGraph = graphs::Graph<graphs::SoaIndexPersistentVector, graphs::Vertex<int, double>>;
+}
+
+SCENARIO("Columnar vertex storage", "[soa]") {
+    static_assert(std::is_same_v<graphs::SoaVector<graphs::PersistentIndex>, std::vector<graphs::PersistentIndex>>);
+    GIVEN("Columns with 100 vertices") {
+        Columns columns;
+        for (int i = 0; i < 100; ++i) {
+            columns.emplace_back(int{i}, 0.5 * i);
+        }
+        THEN("every field is a contiguous column") {
+            REQUIRE(columns.size() == 100);
+            auto ints = columns.column<0>();
+            auto doubles = columns.column<1>();
+            REQUIRE(ints.size() == 100);
+            REQUIRE(std::accumulate(ints.begin(), ints.end(), 0) == 4950);
+            REQUIRE(doubles[10] == 5.);
+            REQUIRE(columns.adjacency().size() == 100);
+            REQUIRE(columns.activeBitmap().size() == 2);
+            REQUIRE(columns.activeBitmap()[1] == (std::uint64_t{1} << 36) - 1);
+        }
+        THEN("proxies provide the vertex interface") {
+            auto v = columns[3];
+            REQUIRE(std::get<0>(v.data()) == 3);
+            REQUIRE(std::get<1>(v.data()) == 1.5);
+            REQUIRE(*v.operator->() == 3);
+            v.addNeighbor(graphs::PersistentIndex{7});
+            v.addNeighbor(graphs::PersistentIndex{7});
+            REQUIRE(columns.adjacency()[3].size() == 1);
+            v.setData({-1, -2.});
+            REQUIRE(columns.column<0>()[3] == -1);
+            v.deactivate();
+            REQUIRE(v.deactivated());
+            REQUIRE(!columns[2].deactivated());
+            REQUIRE_THROWS_AS(columns.at(100), std::out_of_range);
+        }
+        WHEN("materializing a vertex and assigning it to another slot") {
+            columns[4].addNeighbor(graphs::PersistentIndex{1});
+            graphs::Vertex<int, double> vertex = columns[4];
+            columns[50] = std::move(vertex);
+            THEN("all columns of the slot are overwritten") {
+                REQUIRE(columns.column<0>()[50] == 4);
+                REQUIRE(columns.column<1>()[50] == 2.);
+                REQUIRE(columns.adjacency()[50] == columns.adjacency()[4]);
+            }
+        }
+        WHEN("writing to a column") {
+            auto ints = columns.column<0>();
+            std::fill(ints.begin(), ints.end(), 7);
+            THEN("the proxies see the change") {
+                REQUIRE(std::get<0>(columns[99].data()) == 7);
+            }
+        }
+        WHEN("popping the last elements") {
+            columns.pop_back();
+            columns.pop_back();
+            columns.push_back(graphs::Vertex<int, double>(1, 1.));
+            THEN("the bitmap shrinks along") {
+                REQUIRE(columns.size() == 99);
+                REQUIRE(columns.activeBitmap()[1] == (std::uint64_t{1} << 35) - 1);
+            }
+        }
+    }
+}
+
+SCENARIO("Graphs with columnar vertex storage", "[soa]") {
+    GIVEN("A graph with blanks and its array-of-structs counterpart") {
+        graphs::DefaultGraph reference;
+        graphs::SoaGraph graph;
+        std::mt19937 generator(13);
+        std::uniform_int_distribution<std::size_t> vertexDistribution(0, 49);
+        for (std::size_t i = 0; i < 50; ++i) {
+            reference.addVertex(i);
+            graph.addVertex(i);
+        }
+        for (std::size_t i = 0; i < 120; ++i) {
+            graphs::PersistentIndex ix1 {vertexDistribution(generator)};
+            graphs::PersistentIndex ix2 {vertexDistribution(generator)};
+            if (ix1 != ix2 && !reference.containsEdge(ix1, ix2)) {
+                reference.addEdge(ix1, ix2);
+                graph.addEdge(ix1, ix2);
+            }
+        }
+        for (std::size_t i : {3, 17, 31}) {
+            reference.removeVertex(graphs::PersistentIndex{i});
+            graph.removeVertex(graphs::PersistentIndex{i});
+        }
+        reference.removeEdge(reference.edges().front());
+        graph.removeEdge(graph.edges().front());
+
+        THEN("both have the same vertices, edges, algorithm results, rollbacks and binary format") {
+            test::requireSameGraph(graph, reference);
+            test::requireSameResults(graph, reference, graphs::PersistentIndex{0}, graphs::PersistentIndex{49});
+            test::requireRollbackRestores(graph, reference);
+            test::requireSameAfterReading<graphs::DefaultGraph>(graph, reference);
+        }
+        THEN("the data column can be scanned without touching the topology") {
+            auto column = graph.vertices().column<0>();
+            REQUIRE(column.size() == 50);
+            std::size_t sum = 0;
+            for (auto it = graph.begin(); it != graph.end(); ++it) {
+                sum += column[it.persistent_index().value];
+            }
+            REQUIRE(sum == 49 * 50 / 2 - 3 - 17 - 31);
+        }
+        WHEN("copying and appending") {
+            auto copy = graph;
+            auto mapping = copy.append(graph);
+            THEN("the copy contains the graph twice") {
+                REQUIRE(copy.nVertices() == 2 * graph.nVertices());
+                REQUIRE(copy.nEdges() == 2 * graph.nEdges());
+                REQUIRE(copy.vertices().at(mapping[0]).data() == 0);
+            }
+        }
+    }
+    GIVEN("A graph with two data fields") {
+        SoaPairGraph graph;
+        auto v1 = graph.addVertex({1, 1.5});
+        auto v2 = graph.addVertex({2, 2.5});
+        graph.addEdge(v1, v2);
+        graph.setData(v2, {3, 3.5});
+        THEN("the fields live in separate columns") {
+            REQUIRE(graph.vertices().column<0>()[v2.value] == 3);
+            REQUIRE(graph.vertices().column<1>()[v2.value] == 3.5);
+            REQUIRE(graph.vertices().at(v1).data() == std::make_tuple(1, 1.5));
+            REQUIRE(graph.vertices().adjacency()[v1.value].size() == 1);
+        }
+    }
+}
@@ -3,6 +3,8 @@
 //
 
 #include <catch2/catch.hpp>
+#include <memory_resource>
+
 #include <graphs/Vertex.h>
 
 TEST_CASE("Test Vertex class", "[vertex]") {
@@ -70,4 +72,34 @@ TEST_CASE("Test Vertex class", "[vertex]") {
         }
     }
 
+    SECTION("Vertices with sorted neighbors") {
+        graphs::SortedVertex<std::size_t> vertex (5);
+        static_assert(graphs::SortedVertex<std::size_t>::sorted_neighbors);
+        static_assert(!graphs::Vertex<std::size_t>::sorted_neighbors);
+        for (std::size_t i : {7, 3, 9, 1, 3, 5}) {
+            vertex.addNeighbor(graphs::PersistentIndex{i});
+        }
+        vertex.removeNeighbor(graphs::PersistentIndex{9});
+        vertex.removeNeighbor(graphs::PersistentIndex{4});
+        THEN("they are kept in ascending order without duplicates") {
+            std::vector<graphs::PersistentIndex> expected {{1}, {3}, {5}, {7}};
+            REQUIRE(vertex.neighbors() == expected);
+        }
+    }
+
+    SECTION("Vertices with allocator") {
+        std::pmr::monotonic_buffer_resource arena;
+        graphs::PmrVertex<std::size_t> vertex (std::allocator_arg, &arena, std::make_tuple(std::size_t{5}));
+        vertex.addNeighbor(graphs::PersistentIndex{1});
+        REQUIRE(vertex.get_allocator().resource() == &arena);
+        REQUIRE(vertex.data() == 5);
+
+        std::pmr::monotonic_buffer_resource otherArena;
+        std::pmr::vector<graphs::PmrVertex<std::size_t>> vertices (&otherArena);
+        vertices.push_back(vertex);
+        THEN("containers construct their vertices with their own allocator") {
+            REQUIRE(vertices.front().get_allocator().resource() == &otherArena);
+            REQUIRE(vertices.front().neighbors() == vertex.neighbors());
+        }
+    }
 }